@@ -0,0 +1,56 @@
+#ifndef _CORAL_BENCH_H_
+#define _CORAL_BENCH_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+/**
+ * @brief Retrieve a monotonic timestamp in nanoseconds.
+ * @return timestamp in nanoseconds.
+ */
+static inline uint64_t coral$bench$now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/**
+ * @brief Retrieve a positive integer argument or use a default.
+ * @param [in] argc argument count as given to main.
+ * @param [in] argv argument values as given to main.
+ * @param [in] index of the argument to parse.
+ * @param [in] value default used if the argument is missing or invalid.
+ * @return parsed argument or the default value.
+ */
+static inline size_t coral$bench$argument(int argc, char *argv[], int index,
+                                          size_t value) {
+    if (index < argc) {
+        char *end = NULL;
+        const unsigned long long parsed = strtoull(argv[index], &end, 10);
+        if (end && !*end && parsed) {
+            return (size_t) parsed;
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief Report a benchmark result.
+ * @param [in] name of the measurement.
+ * @param [in] operations that were performed.
+ * @param [in] elapsed time in nanoseconds that the operations took.
+ */
+static inline void coral$bench$report(const char *name, size_t operations,
+                                      uint64_t elapsed) {
+    const double seconds = (double) elapsed / 1e9;
+    printf("%-48s %12zu ops %10.3f ms %10.2f ns/op %12.0f ops/s\n",
+           name, operations, (double) elapsed / 1e6,
+           operations ? (double) elapsed / (double) operations : 0.0,
+           seconds > 0 ? (double) operations / seconds : 0.0);
+}
+
+#endif /* _CORAL_BENCH_H_ */
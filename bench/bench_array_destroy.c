@@ -0,0 +1,57 @@
+#include <coral.h>
+
+#include "bench.h"
+
+/* Releasing the members of a large array. The members are first released
+ * one by one with coral_object_release and then all at once with
+ * coral_object_release_many, each time after they were retained once more
+ * with coral_object_retain_many, so that only the reference counting is
+ * measured. Last the array itself is destroyed which releases its members
+ * in one batch and, as these hold their last reference, destroys them. */
+
+int main(int argc, char *argv[]) {
+    const size_t count = coral$bench$argument(argc, argv, 1, 10000000);
+    printf("members: %zu\n", count);
+    struct coral_class *class;
+    struct coral_array *array;
+    if (!coral_object_class(&class)
+        || !coral_array_alloc(&array)
+        || !coral_array_init(array, NULL, 0)
+        || !coral_array_retain(array)
+        || !coral_array_set_capacity(array, count)) {
+        return EXIT_FAILURE;
+    }
+    void **members = malloc(count * sizeof(void *));
+    if (!members) {
+        return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!coral_object_alloc(0, &members[i])
+            || !coral_object_init(members[i], class)
+            || !coral_array_add(array, members[i])) {
+            return EXIT_FAILURE;
+        }
+    }
+    coral_autorelease_pool_drain();
+
+    coral_object_retain_many(members, count);
+    uint64_t start = coral$bench$now();
+    for (size_t i = 0; i < count; i++) {
+        coral_object_release(members[i]);
+    }
+    coral$bench$report("coral_object_release, one by one", count,
+                       coral$bench$now() - start);
+
+    coral_object_retain_many(members, count);
+    start = coral$bench$now();
+    coral_object_release_many(members, count);
+    coral$bench$report("coral_object_release_many", count,
+                       coral$bench$now() - start);
+
+    start = coral$bench$now();
+    coral_array_release(array);
+    coral$bench$report("array release, members destroyed", count,
+                       coral$bench$now() - start);
+    free(members);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+#include <coral.h>
+
+#include "private/autorelease_pool.h"
+#include "bench.h"
+
+/* Allocation heavy use of the autorelease pool. The first measurements add
+ * one long lived object batch times to a pool per round, which isolates the
+ * cost of tracking and releasing pool entries, with releases issued one by
+ * one and coalesced. The next ones create batch objects per round that are
+ * autoreleased by coral_object_init and collected by
+ * coral_autorelease_pool_drain, where coalescing has nothing to gain. The
+ * last two invoke a function, each invocation starting and ending its own
+ * pool, once doing nothing and once creating an object that is collected
+ * when the invocation returns. */
+
+static bool $nothing(void *this, void *data, void *args) {
+    return true;
+}
+
+static bool $create(void *this, void *data, void *args) {
+    struct coral_class *class = args;
+    void *object;
+    return coral_object_alloc(0, &object)
+           && coral_object_init(object, class);
+}
+
+static void $report(const char *name, const size_t operations,
+                    const uint64_t elapsed, const bool coalescing) {
+    char label[64];
+    snprintf(label, sizeof(label), "%s%s", name,
+             coalescing ? ", coalesced" : "");
+    coral$bench$report(label, operations, elapsed);
+    if (coalescing) {
+        struct coral_autorelease_pool_statistics statistics;
+        coral_autorelease_pool_get_statistics(&statistics);
+        printf("    coalesced releases (total): %zu\n",
+               statistics.coalesced);
+    }
+}
+
+static void $pool(void *object, const size_t batch, const size_t rounds,
+                  const bool coalescing) {
+    coral_autorelease_pool_set_coalescing(coalescing);
+    const uint64_t start = coral$bench$now();
+    for (size_t r = 0; r < rounds; r++) {
+        const size_t watermark = coral$autorelease_pool$start();
+        for (size_t i = 0; i < batch; i++) {
+            coral_object_retain(object);
+            coral$autorelease_pool$add(object);
+        }
+        coral$autorelease_pool$end(watermark);
+    }
+    $report("pool add/end", batch * rounds, coral$bench$now() - start,
+            coalescing);
+}
+
+static void $objects(struct coral_class *class, const size_t batch,
+                     const size_t rounds, const bool coalescing) {
+    coral_autorelease_pool_set_coalescing(coalescing);
+    const uint64_t start = coral$bench$now();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < batch; i++) {
+            void *object;
+            if (!coral_object_alloc(0, &object)
+                || !coral_object_init(object, class)) {
+                abort();
+            }
+        }
+        coral_autorelease_pool_drain();
+    }
+    $report("object alloc/init/drain", batch * rounds,
+            coral$bench$now() - start, coalescing);
+    coral_autorelease_pool_set_coalescing(false);
+}
+
+static void $invoke(void *object, const char *name, coral_invokable_t function,
+                    void *args, const size_t iterations) {
+    const uint64_t start = coral$bench$now();
+    for (size_t i = 0; i < iterations; i++) {
+        if (!coral_object_invoke(object, true, function, args)) {
+            abort();
+        }
+    }
+    coral$bench$report(name, iterations, coral$bench$now() - start);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t batch = coral$bench$argument(argc, argv, 1, 1000);
+    const size_t rounds = coral$bench$argument(argc, argv, 2, 5000);
+    printf("batch: %zu, rounds: %zu\n", batch, rounds);
+    struct coral_class *class;
+    void *object;
+    if (!coral_object_class(&class)
+        || !coral_object_alloc(0, &object)
+        || !coral_object_init(object, class)
+        || !coral_object_retain(object)) {
+        return EXIT_FAILURE;
+    }
+    coral_autorelease_pool_drain();
+    $pool(object, batch, rounds, false);
+    $pool(object, batch, rounds, true);
+    $objects(class, batch, rounds, false);
+    $objects(class, batch, rounds, true);
+    $invoke(object, "invoke, empty pool", $nothing, NULL, batch * rounds);
+    $invoke(object, "invoke, one object per pool", $create, class,
+            batch * rounds);
+    coral_object_release(object);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+#include <malloc.h>
+#include <coral.h>
+
+#include "private/compact_red_black_tree.h"
+#include "private/tree_set.h"
+#include "bench.h"
+
+/* Memory and lookups of a map with 8 byte keys and 8 byte values, first held
+ * in a tree set whose nodes link by pointers and then in a compact red black
+ * tree whose nodes link by 32-bit indices. Entries are inserted in a pseudo
+ * random order and looked up in another. Memory is what the allocator hands
+ * out for the tree, divided by the number of entries, for the compact tree
+ * both as its arena has grown and once it has been trimmed to fit. */
+
+struct $entry {
+    size_t key;
+    size_t value;
+};
+
+static int $compare(const void *a, const void *b) {
+    const struct $entry *A = a;
+    const struct $entry *B = b;
+    return A->key < B->key ? -1 : A->key > B->key;
+}
+
+static size_t $key(const size_t i) {
+    /* odd multiplier, so that no two keys are the same */
+    return i * 0x9e3779b97f4a7c15ULL;
+}
+
+static size_t $allocated() {
+    const struct mallinfo2 info = mallinfo2();
+    /* large blocks, such as the arena, are mapped on their own */
+    return info.uordblks + info.hblkhd;
+}
+
+static void $report_memory(const char *name, const size_t count,
+                           const size_t bytes) {
+    printf("%-48s %12zu entries %10.2f bytes/entry\n", name, count,
+           (double) bytes / (double) count);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t count = coral$bench$argument(argc, argv, 1, 1000000);
+    const size_t lookups = coral$bench$argument(argc, argv, 2, 1000000);
+    printf("entries: %zu, lookups: %zu\n", count, lookups);
+    size_t found = 0;
+
+    struct coral$tree_set set = {};
+    size_t before = $allocated();
+    if (!coral$tree_set$init(&set, NULL, sizeof(struct $entry), $compare)) {
+        return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const struct $entry entry = {.key = $key(i), .value = i};
+        if (!coral$tree_set$insert(&set, &entry)) {
+            return EXIT_FAILURE;
+        }
+    }
+    $report_memory("coral$tree_set", count, $allocated() - before);
+    uint64_t start = coral$bench$now();
+    for (size_t i = 0; i < lookups; i++) {
+        const struct $entry entry = {.key = $key((i * 7919) % count)};
+        bool out;
+        coral_required_true(coral$tree_set$contains(&set, &entry, &out));
+        found += out;
+    }
+    coral$bench$report("coral$tree_set$contains", lookups,
+                       coral$bench$now() - start);
+    coral_required_true(coral$tree_set$invalidate(&set, NULL));
+
+    struct coral$compact_red_black_tree tree;
+    before = $allocated();
+    if (!coral$compact_red_black_tree$init(&tree, sizeof(struct $entry),
+                                           $compare)) {
+        return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const struct $entry entry = {.key = $key(i), .value = i};
+        if (!coral$compact_red_black_tree$insert(&tree, &entry, NULL)) {
+            return EXIT_FAILURE;
+        }
+    }
+    $report_memory("coral$compact_red_black_tree, grown", count,
+                   $allocated() - before);
+    if (!coral$compact_red_black_tree$set_capacity(&tree, count)) {
+        return EXIT_FAILURE;
+    }
+    $report_memory("coral$compact_red_black_tree, trimmed", count,
+                   $allocated() - before);
+    start = coral$bench$now();
+    for (size_t i = 0; i < lookups; i++) {
+        const struct $entry entry = {.key = $key((i * 7919) % count)};
+        uint32_t node;
+        found += coral$compact_red_black_tree$search(&tree, &entry, &node);
+    }
+    coral$bench$report("coral$compact_red_black_tree$search", lookups,
+                       coral$bench$now() - start);
+    coral_required_true(coral$compact_red_black_tree$invalidate(&tree, NULL));
+    return found == 2 * lookups ? EXIT_SUCCESS : EXIT_FAILURE;
+}
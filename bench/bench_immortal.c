@@ -0,0 +1,103 @@
+#include <pthread.h>
+#include <coral.h>
+
+#include "private/object.h"
+#include "bench.h"
+
+/* Class heavy multithreaded workloads. Every thread creates arrays with the
+ * default limit, each of which holds a reference to the one range shared by
+ * all arrays, and collects them batch by batch. The range and the classes
+ * are immortal so none of this writes to memory shared between threads. For
+ * comparison every thread then retains and releases one shared object, first
+ * while it is mortal and then once it has been made immortal. */
+
+struct $arguments {
+    void *object;
+    size_t batch;
+    size_t rounds;
+    pthread_barrier_t *barrier;
+};
+
+static void *$arrays(void *argument) {
+    struct $arguments *args = argument;
+    pthread_barrier_wait(args->barrier);
+    for (size_t r = 0; r < args->rounds; r++) {
+        for (size_t i = 0; i < args->batch; i++) {
+            struct coral_array *array;
+            if (!coral_array_alloc(&array)
+                || !coral_array_init(array, NULL, 0)) {
+                abort();
+            }
+        }
+        coral_autorelease_pool_drain();
+    }
+    pthread_barrier_wait(args->barrier);
+    return NULL;
+}
+
+static void *$retain_release(void *argument) {
+    struct $arguments *args = argument;
+    pthread_barrier_wait(args->barrier);
+    for (size_t i = 0; i < args->batch * args->rounds; i++) {
+        coral_object_retain(args->object);
+        coral_object_release(args->object);
+    }
+    pthread_barrier_wait(args->barrier);
+    return NULL;
+}
+
+static void $measure(const char *name, void *(*run)(void *),
+                     const size_t threads, const size_t batch,
+                     const size_t rounds, void *object) {
+    pthread_t ids[threads];
+    struct $arguments args[threads];
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, threads + 1);
+    for (size_t i = 0; i < threads; i++) {
+        args[i] = (struct $arguments) {
+                .object = object,
+                .batch = batch,
+                .rounds = rounds,
+                .barrier = &barrier
+        };
+        pthread_create(&ids[i], NULL, run, &args[i]);
+    }
+    pthread_barrier_wait(&barrier);
+    const uint64_t start = coral$bench$now();
+    pthread_barrier_wait(&barrier);
+    const uint64_t elapsed = coral$bench$now() - start;
+    for (size_t i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    pthread_barrier_destroy(&barrier);
+    coral$bench$report(name, threads * batch * rounds, elapsed);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t threads = coral$bench$argument(argc, argv, 1, 4);
+    const size_t batch = coral$bench$argument(argc, argv, 2, 1000);
+    const size_t rounds = coral$bench$argument(argc, argv, 3, 500);
+    printf("threads: %zu, batch: %zu, rounds: %zu\n", threads, batch, rounds);
+    struct coral_class *class;
+    void *object;
+    if (!coral_object_class(&class)
+        || !coral_object_alloc(0, &object)
+        || !coral_object_init(object, class)
+        || !coral_object_retain(object)) {
+        return EXIT_FAILURE;
+    }
+    coral_autorelease_pool_drain();
+    $measure("coral_array_alloc/init, 1 thread", $arrays, 1, batch, rounds,
+             NULL);
+    $measure("coral_array_alloc/init, all threads", $arrays, threads, batch,
+             rounds, NULL);
+    $measure("shared object retain/release, mortal", $retain_release,
+             threads, batch, rounds, object);
+    if (!coral$object$set_immortal(object)) {
+        return EXIT_FAILURE;
+    }
+    $measure("shared object retain/release, immortal", $retain_release,
+             threads, batch, rounds, object);
+    coral_object_destroy(object);
+    return EXIT_SUCCESS;
+}
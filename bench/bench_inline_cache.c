@@ -0,0 +1,94 @@
+#include <string.h>
+#include <coral.h>
+
+#include "bench.h"
+
+/* Dynamic dispatch of one method on receivers of four frozen classes, by
+ * name, by selector and through inline caches. The monomorphic call site
+ * only ever sees one class, the polymorphic one cycles through all of them,
+ * once with a cache large enough to hold them and once with a monomorphic
+ * cache that misses on every call. */
+
+#define $CLASSES 4
+
+static bool $read(void *this, void *data, size_t *args) {
+    *args += 1;
+    return true;
+}
+
+static void $report(const char *name, size_t iterations, uint64_t elapsed,
+                    const struct coral_inline_cache *cache) {
+    coral$bench$report(name, iterations, elapsed);
+    if (cache) {
+        printf("    hits: %zu, misses: %zu\n", cache->hits, cache->misses);
+    }
+}
+
+static void $measure(const char *name, void **objects, size_t mask,
+                     size_t iterations, size_t capacity) {
+    char label[64];
+    size_t count = 0;
+    const struct coral_selector *selector;
+    if (!coral_selector_of("read", &selector)) {
+        abort();
+    }
+    uint64_t start = coral$bench$now();
+    for (size_t i = 0; i < iterations; i++) {
+        coral_object_dispatch(objects[i & mask], true, "read", &count);
+    }
+    snprintf(label, sizeof(label), "%s, dispatch", name);
+    $report(label, iterations, coral$bench$now() - start, NULL);
+
+    start = coral$bench$now();
+    for (size_t i = 0; i < iterations; i++) {
+        coral_object_dispatch_selector(objects[i & mask], true, selector,
+                                       &count);
+    }
+    snprintf(label, sizeof(label), "%s, dispatch_selector", name);
+    $report(label, iterations, coral$bench$now() - start, NULL);
+
+    struct coral_inline_cache cache;
+    if (!coral_inline_cache_init(&cache, selector, capacity)) {
+        abort();
+    }
+    start = coral$bench$now();
+    for (size_t i = 0; i < iterations; i++) {
+        coral_object_dispatch_cached(objects[i & mask], true, &cache, &count);
+    }
+    snprintf(label, sizeof(label), "%s, dispatch_cached (%zu)", name,
+             capacity);
+    $report(label, iterations, coral$bench$now() - start, &cache);
+    if (count != 3 * iterations) {
+        abort();
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t iterations = coral$bench$argument(argc, argv, 1, 10000000);
+    printf("dispatches per measurement: %zu\n", iterations);
+    struct coral_class_method_name name = {
+            .data = "read",
+            .size = strlen("read")
+    };
+    void *objects[$CLASSES];
+    for (size_t i = 0; i < $CLASSES; i++) {
+        struct coral_class *class;
+        if (!coral_class_alloc(&class)
+            || !coral_class_init(class)
+            || !coral_class_retain(class)
+            || !coral_class_method_add(class, &name,
+                                       (coral_invokable_t) $read)
+            || !coral_class_freeze(class)
+            || !coral_object_alloc(0, &objects[i])
+            || !coral_object_init(objects[i], class)
+            || !coral_object_retain(objects[i])) {
+            return EXIT_FAILURE;
+        }
+    }
+    coral_autorelease_pool_drain();
+    $measure("monomorphic", objects, 0, iterations, 1);
+    $measure("polymorphic", objects, $CLASSES - 1, iterations,
+             CORAL_INLINE_CACHE_MAXIMUM_ENTRIES);
+    $measure("megamorphic", objects, $CLASSES - 1, iterations, 1);
+    return EXIT_SUCCESS;
+}
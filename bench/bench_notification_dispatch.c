@@ -0,0 +1,131 @@
+#include <stdatomic.h>
+#include <coral.h>
+
+#include "bench.h"
+#include "private/object.h"
+
+/* Mutation throughput of an observed array and tree map. Without the
+ * notification dispatcher every observer runs on the mutating thread while
+ * it holds the write lock of the container, with the dispatcher the mutator
+ * only queues the notification. The dispatcher is measured twice, once for
+ * the mutations alone and once including the time it takes to drain the
+ * queue, as repeated notifications are coalesced the observer runs far less
+ * often than there are mutations. */
+
+static atomic_size_t $observed;
+
+static void $on_event(void *observer, void *object, const char *event) {
+    /* stand in for an observer that does some actual work */
+    volatile size_t sum = 0;
+    for (size_t i = 0; i < (size_t) observer; i++) {
+        sum += i;
+    }
+    atomic_fetch_add_explicit(&$observed, 1, memory_order_relaxed);
+}
+
+static void $array(void **keys, size_t count) {
+    struct coral_array *array;
+    if (!coral_array_alloc(&array)
+        || !coral_array_init(array, NULL, 0)
+        || !coral$object_add_observer(array, (void *) 512, NULL, $on_event)) {
+        abort();
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!coral_array_add(array, keys[i])) {
+            abort();
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!coral_array_remove(array)) {
+            abort();
+        }
+    }
+}
+
+static void $tree_map(void **keys, size_t count) {
+    struct coral_tree_map *tree_map;
+    if (!coral_tree_map_alloc(&tree_map)
+        || !coral_tree_map_init(tree_map, NULL, coral_compare_void_ptr)
+        || !coral$object_add_observer(tree_map, (void *) 512, NULL,
+                                      $on_event)) {
+        abort();
+    }
+    for (size_t i = 0; i < count; i++) {
+        struct coral_tree_map_entry entry = {.key = keys[i]};
+        if (!coral_tree_map_insert(tree_map, &entry)) {
+            abort();
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!coral_tree_map_delete(tree_map, keys[i])) {
+            abort();
+        }
+    }
+}
+
+static void $measure(const char *name, void (*mutate)(void **, size_t),
+                     void **keys, size_t count, size_t workers) {
+    char label[64];
+    atomic_store(&$observed, 0);
+    if (workers && !coral_notification_dispatcher_start(workers)) {
+        abort();
+    }
+    uint64_t start = coral$bench$now();
+    mutate(keys, count);
+    uint64_t elapsed = coral$bench$now() - start;
+    if (!workers) {
+        snprintf(label, sizeof(label), "%s, synchronous", name);
+        coral$bench$report(label, 2 * count, elapsed);
+        return;
+    }
+    snprintf(label, sizeof(label), "%s, %zu worker(s)", name, workers);
+    coral$bench$report(label, 2 * count, elapsed);
+    if (!coral_notification_dispatcher_stop()) {
+        abort();
+    }
+    elapsed = coral$bench$now() - start;
+    snprintf(label, sizeof(label), "%s, %zu worker(s) drained", name,
+             workers);
+    coral$bench$report(label, 2 * count, elapsed);
+    printf("    observer called %zu times\n", atomic_load(&$observed));
+}
+
+int main(int argc, char *argv[]) {
+    const size_t count = coral$bench$argument(argc, argv, 1, 200000);
+    printf("mutations per measurement: %zu\n", 2 * count);
+    struct coral_class *class;
+    void **keys = calloc(count, sizeof(void *));
+    if (!keys || !coral_object_class(&class)) {
+        return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!coral_object_alloc(0, &keys[i])
+            || !coral_object_init(keys[i], class)
+            || !coral_object_retain(keys[i])) {
+            return EXIT_FAILURE;
+        }
+    }
+    coral_autorelease_pool_drain();
+    const size_t workers[] = {0, 1, 2};
+    for (size_t i = 0; i < sizeof(workers) / sizeof(workers[0]); i++) {
+        $measure("array add/remove", $array, keys, count, workers[i]);
+        coral_autorelease_pool_drain();
+    }
+    for (size_t i = 0; i < sizeof(workers) / sizeof(workers[0]); i++) {
+        $measure("tree_map insert/delete", $tree_map, keys, count,
+                 workers[i]);
+        coral_autorelease_pool_drain();
+    }
+    struct coral_notification_dispatcher_statistics statistics;
+    coral_required_true(
+            coral_notification_dispatcher_get_statistics(&statistics));
+    printf("posted: %zu, delivered: %zu, coalesced: %zu, batches: %zu\n",
+           statistics.posted, statistics.delivered, statistics.coalesced,
+           statistics.batches);
+    for (size_t i = 0; i < count; i++) {
+        coral_object_release(keys[i]);
+    }
+    coral_autorelease_pool_drain();
+    free(keys);
+    return EXIT_SUCCESS;
+}
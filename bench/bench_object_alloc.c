@@ -0,0 +1,146 @@
+#include <pthread.h>
+#include <coral.h>
+
+#include "private/slab.h"
+#include "bench.h"
+
+/* Allocation churn of object sized blocks: the per-thread slab allocator
+ * that now serves coral_object_alloc/coral_object_destroy against the
+ * calloc(3)/free(3) path it replaced, followed by the complete
+ * coral_object_alloc/coral_object_destroy round trip for reference. Blocks are
+ * allocated in batches and freed in the same order, either by the allocating
+ * thread or by another thread. */
+
+#define $HEADER_SIZE 32 /* sizeof(struct coral_object) */
+
+enum $path {
+    $CALLOC,
+    $SLAB,
+    $OBJECT
+};
+
+struct $arguments {
+    size_t size;
+    size_t batch;
+    size_t rounds;
+    enum $path path;
+    void **objects;
+    pthread_barrier_t *barrier;
+};
+
+static void $alloc(struct $arguments *args) {
+    for (size_t i = 0; i < args->batch; i++) {
+        switch (args->path) {
+            case $CALLOC:
+                if (!(args->objects[i] = calloc(1, $HEADER_SIZE + args->size))) {
+                    abort();
+                }
+                break;
+            case $SLAB:
+                if (!coral$slab$alloc($HEADER_SIZE + args->size,
+                                      &args->objects[i])) {
+                    abort();
+                }
+                break;
+            case $OBJECT:
+                if (!coral_object_alloc(args->size, &args->objects[i])) {
+                    abort();
+                }
+                break;
+        }
+    }
+}
+
+static void $free(struct $arguments *args) {
+    for (size_t i = 0; i < args->batch; i++) {
+        switch (args->path) {
+            case $CALLOC:
+                free(args->objects[i]);
+                break;
+            case $SLAB:
+                coral$slab$free(args->objects[i]);
+                break;
+            case $OBJECT:
+                coral_object_destroy(args->objects[i]);
+                break;
+        }
+    }
+}
+
+static void $single_thread(const char *name, struct $arguments *args) {
+    const uint64_t start = coral$bench$now();
+    for (size_t r = 0; r < args->rounds; r++) {
+        $alloc(args);
+        $free(args);
+    }
+    coral$bench$report(name, 2 * args->rounds * args->batch,
+                       coral$bench$now() - start);
+}
+
+static void *$consumer(void *argument) {
+    struct $arguments *args = argument;
+    for (size_t r = 0; r < args->rounds; r++) {
+        pthread_barrier_wait(args->barrier); /* batch allocated */
+        $free(args);
+        pthread_barrier_wait(args->barrier); /* batch freed */
+    }
+    return NULL;
+}
+
+static void $cross_thread(const char *name, struct $arguments *args) {
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, 2);
+    args->barrier = &barrier;
+    pthread_t thread;
+    pthread_create(&thread, NULL, $consumer, args);
+    const uint64_t start = coral$bench$now();
+    for (size_t r = 0; r < args->rounds; r++) {
+        $alloc(args);
+        pthread_barrier_wait(&barrier);
+        pthread_barrier_wait(&barrier);
+    }
+    const uint64_t elapsed = coral$bench$now() - start;
+    pthread_join(thread, NULL);
+    pthread_barrier_destroy(&barrier);
+    coral$bench$report(name, 2 * args->rounds * args->batch, elapsed);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t batch = coral$bench$argument(argc, argv, 1, 1000);
+    const size_t rounds = coral$bench$argument(argc, argv, 2, 2000);
+    const size_t sizes[] = {16, 64, 256};
+    void **objects = calloc(batch, sizeof(void *));
+    if (!objects) {
+        return EXIT_FAILURE;
+    }
+    printf("batch: %zu, rounds: %zu\n", batch, rounds);
+    const char *paths[] = {"calloc", "slab", "coral_object_alloc"};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        for (enum $path path = $CALLOC; path <= $OBJECT; path++) {
+            char name[64];
+            struct $arguments args = {
+                    .size = sizes[i],
+                    .batch = batch,
+                    .rounds = rounds,
+                    .path = path,
+                    .objects = objects
+            };
+            snprintf(name, sizeof(name), "%zu bytes, %s", sizes[i],
+                     paths[path]);
+            $single_thread(name, &args);
+            snprintf(name, sizeof(name), "%zu bytes, %s, cross-thread free",
+                     sizes[i], paths[path]);
+            $cross_thread(name, &args);
+        }
+    }
+    struct coral$slab$statistics statistics;
+    coral$slab$get_statistics(&statistics);
+    printf("slab statistics (main thread): allocations %zu, deallocations "
+           "%zu, remote deallocations %zu, slabs mapped %zu, slabs unmapped "
+           "%zu, bytes mapped (process) %zu\n",
+           statistics.allocations, statistics.deallocations,
+           statistics.remote_deallocations, statistics.slabs_mapped,
+           statistics.slabs_unmapped, statistics.bytes_mapped);
+    free(objects);
+    return EXIT_SUCCESS;
+}
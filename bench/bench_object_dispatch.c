@@ -0,0 +1,88 @@
+#include <pthread.h>
+#include <coral.h>
+
+#include "bench.h"
+
+/* Single threaded dispatch cost. An object that has only ever been invoked by
+ * the thread that created it is invoked without taking its lock, this is
+ * compared against the very same object once another thread has touched it
+ * and every invoke has to take the read-write lock, which is how every object
+ * used to be invoked. Dispatching by name is compared with dispatching by an
+ * interned selector. */
+
+static bool $read(void *this, void *data, void *args) {
+    return true;
+}
+
+static bool $write(void *this, void *data, void *args) {
+    return true;
+}
+
+static void *$touch(void *object) {
+    size_t hash;
+    if (!coral_object_hash_code(object, &hash)) {
+        abort();
+    }
+    return NULL;
+}
+
+static void $measure(const char *name, void *object, size_t iterations) {
+    char label[64];
+    size_t hash;
+    uint64_t start = coral$bench$now();
+    for (size_t i = 0; i < iterations; i++) {
+        coral_object_invoke(object, true, $read, NULL);
+    }
+    snprintf(label, sizeof(label), "%s, invoke readonly", name);
+    coral$bench$report(label, iterations, coral$bench$now() - start);
+
+    start = coral$bench$now();
+    for (size_t i = 0; i < iterations; i++) {
+        coral_object_invoke(object, false, $write, NULL);
+    }
+    snprintf(label, sizeof(label), "%s, invoke", name);
+    coral$bench$report(label, iterations, coral$bench$now() - start);
+
+    start = coral$bench$now();
+    for (size_t i = 0; i < iterations; i++) {
+        coral_object_dispatch(object, true, hash_code,
+                              &(struct hash_code_args) {.out = &hash});
+    }
+    snprintf(label, sizeof(label), "%s, dispatch hash_code", name);
+    coral$bench$report(label, iterations, coral$bench$now() - start);
+
+    const struct coral_selector *selector;
+    if (!coral_selector_of(hash_code, &selector)) {
+        abort();
+    }
+    start = coral$bench$now();
+    for (size_t i = 0; i < iterations; i++) {
+        coral_object_dispatch_selector(object, true, selector,
+                                       &(struct hash_code_args) {.out = &hash});
+    }
+    snprintf(label, sizeof(label), "%s, dispatch_selector hash_code", name);
+    coral$bench$report(label, iterations, coral$bench$now() - start);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t iterations = coral$bench$argument(argc, argv, 1, 10000000);
+    printf("invokes per measurement: %zu\n", iterations);
+    struct coral_class *class;
+    void *object;
+    if (!coral_object_class(&class)
+        || !coral_object_alloc(0, &object)
+        || !coral_object_init(object, class)
+        || !coral_object_retain(object)) {
+        return EXIT_FAILURE;
+    }
+    $measure("owned", object, iterations);
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, $touch, object)
+        || pthread_join(thread, NULL)) {
+        return EXIT_FAILURE;
+    }
+    $measure("shared", object, iterations);
+    coral_object_release(object);
+    coral_autorelease_pool_drain();
+    return EXIT_SUCCESS;
+}
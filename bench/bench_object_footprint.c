@@ -0,0 +1,91 @@
+#include <unistd.h>
+#include <coral.h>
+
+#include "private/object.h"
+#include "private/slab.h"
+#include "bench.h"
+
+/* Memory footprint of many small objects. The resident set size is sampled
+ * after creating the objects, again after every object has been read once,
+ * which needs no lock, and again after every object has been written to once,
+ * which is when an object's lock is allocated. */
+
+#define $PAYLOAD 16 /* e.g. a coral_integer */
+#define $BATCH 100000
+
+static size_t $resident() {
+    FILE *file = fopen("/proc/self/statm", "r");
+    size_t size = 0, resident = 0;
+    if (file) {
+        if (2 != fscanf(file, "%zu %zu", &size, &resident)) {
+            resident = 0;
+        }
+        fclose(file);
+    }
+    return resident * (size_t) sysconf(_SC_PAGESIZE);
+}
+
+static bool $noop(void *this, void *data, void *args) {
+    return true;
+}
+
+static void $report(const char *name, size_t count, size_t before,
+                    size_t after) {
+    const size_t bytes = after > before ? after - before : 0;
+    printf("%-36s %12zu objects %10.1f MiB %8.1f bytes/object\n",
+           name, count, (double) bytes / (1024.0 * 1024.0),
+           count ? (double) bytes / (double) count : 0.0);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t count = coral$bench$argument(argc, argv, 1, 10000000);
+    struct coral_class *class;
+    void **objects = calloc(count, sizeof(void *));
+    if (!objects || !coral_object_class(&class)) {
+        return EXIT_FAILURE;
+    }
+    const size_t baseline = $resident();
+    uint64_t start = coral$bench$now();
+    for (size_t i = 0; i < count; i++) {
+        if (!coral_object_alloc($PAYLOAD, &objects[i])
+            || !coral_object_init(objects[i], class)
+            || !coral_object_retain(objects[i])) {
+            return EXIT_FAILURE;
+        }
+        if (!((1 + i) % $BATCH)) {
+            coral_autorelease_pool_drain();
+        }
+    }
+    coral_autorelease_pool_drain();
+    const uint64_t created = coral$bench$now() - start;
+    const size_t header = (size_t) ((char *) objects[0]
+            - (char *) coral$object_from(objects[0]));
+    printf("object header: %zu bytes, payload: %d bytes\n", header, $PAYLOAD);
+    /* the pointer array itself is touched while creating the objects */
+    const size_t pointers = count * sizeof(void *);
+    $report("created", count, baseline + pointers, $resident());
+    coral$bench$report("create", count, created);
+    const size_t before = $resident();
+    start = coral$bench$now();
+    for (size_t i = 0; i < count; i++) {
+        coral_object_invoke(objects[i], true, $noop, NULL);
+    }
+    coral$bench$report("first read", count, coral$bench$now() - start);
+    $report("after first read", count, before, $resident());
+    start = coral$bench$now();
+    for (size_t i = 0; i < count; i++) {
+        coral_object_invoke(objects[i], false, $noop, NULL);
+    }
+    coral$bench$report("first write", count, coral$bench$now() - start);
+    $report("after first write (lock allocated)", count, before, $resident());
+    start = coral$bench$now();
+    for (size_t i = 0; i < count; i++) {
+        coral_object_release(objects[i]);
+    }
+    coral$bench$report("release", count, coral$bench$now() - start);
+    struct coral$slab$statistics statistics;
+    coral$slab$get_statistics(&statistics);
+    printf("slab bytes mapped after release: %zu\n", statistics.bytes_mapped);
+    free(objects);
+    return EXIT_SUCCESS;
+}
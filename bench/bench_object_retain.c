@@ -0,0 +1,107 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <coral.h>
+
+#include "bench.h"
+
+/* Multithreaded retain/release throughput. Every thread hammers the same
+ * shared object (contended reference count) and then an object of its own
+ * (uncontended). The fast path is compared against routing the very same
+ * reference counting through coral_object_invoke(...), which is how retain
+ * and release used to be implemented. */
+
+struct $arguments {
+    struct coral_class *class;
+    void *object;
+    size_t iterations;
+    bool via_invoke;
+    pthread_barrier_t *barrier;
+};
+
+static bool $retain(void *this, void *data, void *args) {
+    return coral_object_retain(this);
+}
+
+static bool $release(void *this, void *data, void *args) {
+    return coral_object_release(this);
+}
+
+static void *$run(void *argument) {
+    struct $arguments *args = argument;
+    void *object = args->object;
+    bool own = false;
+    if (!object) {
+        own = true;
+        if (!coral_object_alloc(0, &object)
+            || !coral_object_init(object, args->class)) {
+            abort();
+        }
+    }
+    pthread_barrier_wait(args->barrier);
+    for (size_t i = 0; i < args->iterations; i++) {
+        if (args->via_invoke) {
+            coral_object_invoke(object, true, $retain, NULL);
+            coral_object_invoke(object, true, $release, NULL);
+        } else {
+            coral_object_retain(object);
+            coral_object_release(object);
+        }
+    }
+    pthread_barrier_wait(args->barrier);
+    if (own) {
+        coral_autorelease_pool_drain();
+    }
+    return NULL;
+}
+
+static void $measure(const char *name, size_t threads, size_t iterations,
+                     struct coral_class *class, void *shared,
+                     bool via_invoke) {
+    pthread_t ids[threads];
+    struct $arguments args[threads];
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, threads + 1);
+    for (size_t i = 0; i < threads; i++) {
+        args[i] = (struct $arguments) {
+                .class = class,
+                .object = shared,
+                .iterations = iterations,
+                .via_invoke = via_invoke,
+                .barrier = &barrier
+        };
+        pthread_create(&ids[i], NULL, $run, &args[i]);
+    }
+    pthread_barrier_wait(&barrier);
+    const uint64_t start = coral$bench$now();
+    pthread_barrier_wait(&barrier);
+    const uint64_t elapsed = coral$bench$now() - start;
+    for (size_t i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    pthread_barrier_destroy(&barrier);
+    coral$bench$report(name, 2 * threads * iterations, elapsed);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t threads = coral$bench$argument(argc, argv, 1, 4);
+    const size_t iterations = coral$bench$argument(argc, argv, 2, 1000000);
+    printf("threads: %zu, retain/release pairs per thread: %zu\n",
+           threads, iterations);
+    struct coral_class *class;
+    void *shared;
+    if (!coral_object_class(&class)
+        || !coral_object_alloc(0, &shared)
+        || !coral_object_init(shared, class)) {
+        return EXIT_FAILURE;
+    }
+    $measure("shared object, coral_object_invoke", threads, iterations,
+             class, shared, true);
+    $measure("shared object, fast path", threads, iterations,
+             class, shared, false);
+    $measure("per-thread objects, coral_object_invoke", threads,
+             iterations, class, NULL, true);
+    $measure("per-thread objects, fast path", threads, iterations,
+             class, NULL, false);
+    coral_autorelease_pool_drain();
+    return EXIT_SUCCESS;
+}
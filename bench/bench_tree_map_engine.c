@@ -0,0 +1,86 @@
+#include <coral.h>
+
+#include "private/tree_map.h"
+#include "bench.h"
+
+/* Lookups and range scans of a map with 8 byte keys and 8 byte values, kept
+ * by the red black tree, the b tree and then the compact red black tree
+ * engine. Entries are inserted in a pseudo random order and looked up in
+ * another, a range scan starts at a looked up key and steps through the
+ * entries that follow it, as a caller of coral$tree_map$get_next would. */
+
+struct $entry {
+    size_t key;
+    size_t value;
+};
+
+static size_t $key(const size_t i) {
+    /* odd multiplier, so that no two keys are the same */
+    return i * 0x9e3779b97f4a7c15ULL;
+}
+
+static int $measure(const char *name, const int engine, const size_t count,
+                    const size_t lookups, const size_t scans,
+                    const size_t length) {
+    char label[64];
+    struct coral$tree_map map = {};
+    if (!coral$tree_map$init_with_engine(&map, NULL, sizeof(size_t),
+                                         sizeof(size_t), engine,
+                                         coral_compare_size_t)) {
+        return EXIT_FAILURE;
+    }
+    uint64_t start = coral$bench$now();
+    for (size_t i = 0; i < count; i++) {
+        const struct $entry entry = {.key = $key(i), .value = i};
+        if (!coral$tree_map$insert(&map, &entry)) {
+            return EXIT_FAILURE;
+        }
+    }
+    snprintf(label, sizeof(label), "%s, insert", name);
+    coral$bench$report(label, count, coral$bench$now() - start);
+
+    size_t sum = 0;
+    start = coral$bench$now();
+    for (size_t i = 0; i < lookups; i++) {
+        const size_t key = $key((i * 7919) % count);
+        struct $entry entry;
+        coral_required_true(coral$tree_map$get(&map, &key,
+                                               (void **) &entry));
+        sum += entry.value;
+    }
+    snprintf(label, sizeof(label), "%s, get", name);
+    coral$bench$report(label, lookups, coral$bench$now() - start);
+
+    start = coral$bench$now();
+    for (size_t i = 0; i < scans; i++) {
+        struct $entry entry = {.key = $key((i * 7919) % count)};
+        for (size_t j = 0; j < length
+                           && coral$tree_map$get_next(&map, &entry,
+                                                      (void **) &entry); j++) {
+            sum += entry.value;
+        }
+    }
+    snprintf(label, sizeof(label), "%s, range scan", name);
+    coral$bench$report(label, scans * length, coral$bench$now() - start);
+    coral_required_true(coral$tree_map$invalidate(&map, NULL));
+    return sum ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t count = coral$bench$argument(argc, argv, 1, 1000000);
+    const size_t lookups = coral$bench$argument(argc, argv, 2, 1000000);
+    const size_t scans = coral$bench$argument(argc, argv, 3, 10000);
+    const size_t length = coral$bench$argument(argc, argv, 4, 100);
+    printf("entries: %zu, lookups: %zu, scans: %zu of %zu entries\n",
+           count, lookups, scans, length);
+    if ($measure("red black tree", CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+                 count, lookups, scans, length)
+        || $measure("b tree", CORAL_TREE_SET_ENGINE_B_TREE,
+                    count, lookups, scans, length)
+        || $measure("compact red black tree",
+                    CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE,
+                    count, lookups, scans, length)) {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <coral.h>
+
+#include "bench.h"
+
+/* Read-mostly lookups in one tree map shared by many threads. Every thread
+ * looks up keys of the map in a pseudo random order, first on its own, then
+ * all threads at once and last all threads at once while one more thread
+ * keeps inserting and deleting entries of keys that the readers never look
+ * up. */
+
+struct $arguments {
+    struct coral_tree_map *map;
+    void **keys;
+    size_t count;
+    size_t lookups;
+    size_t seed;
+    atomic_bool *is_done;
+    pthread_barrier_t *barrier;
+};
+
+static void *$lookup(void *argument) {
+    struct $arguments *args = argument;
+    pthread_barrier_wait(args->barrier);
+    size_t at = args->seed;
+    for (size_t i = 0; i < args->lookups; i++) {
+        at = (at * 6364136223846793005ULL + 1442695040888963407ULL);
+        void *key = args->keys[(at >> 33) % args->count];
+        void *value;
+        if (!coral_tree_map_get(args->map, key, &value)) {
+            abort();
+        }
+        if (!(i & 1023)) {
+            coral_autorelease_pool_drain();
+        }
+    }
+    coral_autorelease_pool_drain();
+    pthread_barrier_wait(args->barrier);
+    return NULL;
+}
+
+static void *$churn(void *argument) {
+    struct $arguments *args = argument;
+    for (size_t i = 0; !atomic_load(args->is_done); i++) {
+        struct coral_tree_map_entry entry = {
+                .key = args->keys[i % args->count]
+        };
+        if (!coral_tree_map_insert(args->map, &entry)
+            || !coral_tree_map_delete(args->map, entry.key)) {
+            abort();
+        }
+    }
+    coral_autorelease_pool_drain();
+    return NULL;
+}
+
+static void $measure(const char *name, struct $arguments *template,
+                     const size_t threads, const bool is_writing) {
+    pthread_t ids[threads], writer;
+    struct $arguments args[threads];
+    pthread_barrier_t barrier;
+    atomic_bool is_done = false;
+    pthread_barrier_init(&barrier, NULL, threads + 1);
+    for (size_t i = 0; i < threads; i++) {
+        args[i] = *template;
+        args[i].seed = 1 + i;
+        args[i].barrier = &barrier;
+        pthread_create(&ids[i], NULL, $lookup, &args[i]);
+    }
+    struct $arguments writer_args = *template;
+    writer_args.keys += template->count;
+    writer_args.is_done = &is_done;
+    if (is_writing) {
+        pthread_create(&writer, NULL, $churn, &writer_args);
+    }
+    pthread_barrier_wait(&barrier);
+    const uint64_t start = coral$bench$now();
+    pthread_barrier_wait(&barrier);
+    const uint64_t elapsed = coral$bench$now() - start;
+    atomic_store(&is_done, true);
+    for (size_t i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    if (is_writing) {
+        pthread_join(writer, NULL);
+    }
+    pthread_barrier_destroy(&barrier);
+    coral$bench$report(name, threads * template->lookups, elapsed);
+}
+
+int main(int argc, char *argv[]) {
+    const size_t threads = coral$bench$argument(argc, argv, 1, 32);
+    const size_t count = coral$bench$argument(argc, argv, 2, 100000);
+    const size_t lookups = coral$bench$argument(argc, argv, 3, 200000);
+    printf("threads: %zu, entries: %zu, lookups per thread: %zu\n",
+           threads, count, lookups);
+    struct coral_class *class;
+    struct coral_tree_map *map;
+    if (!coral_object_class(&class)
+        || !coral_tree_map_alloc(&map)
+        || !coral_tree_map_init(map, NULL, coral_compare_void_ptr)
+        || !coral_tree_map_retain(map)) {
+        return EXIT_FAILURE;
+    }
+    /* the second half of the keys is only used by the writer */
+    void **keys = malloc(2 * count * sizeof(void *));
+    if (!keys) {
+        return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < 2 * count; i++) {
+        if (!coral_object_alloc(0, &keys[i])
+            || !coral_object_init(keys[i], class)
+            || !coral_object_retain(keys[i])) {
+            return EXIT_FAILURE;
+        }
+        if (i >= count) {
+            continue;
+        }
+        struct coral_tree_map_entry entry = {
+                .key = keys[i],
+                .value = keys[i]
+        };
+        if (!coral_tree_map_insert(map, &entry)) {
+            return EXIT_FAILURE;
+        }
+    }
+    coral_autorelease_pool_drain();
+    struct $arguments template = {
+            .map = map,
+            .keys = keys,
+            .count = count,
+            .lookups = lookups
+    };
+    $measure("coral_tree_map_get, 1 thread", &template, 1, false);
+    $measure("coral_tree_map_get, all threads", &template, threads, false);
+    $measure("coral_tree_map_get, all threads, 1 writer", &template,
+             threads, true);
+    coral_tree_map_release(map);
+    coral_object_release_many(keys, 2 * count);
+    coral_autorelease_pool_drain();
+    free(keys);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,77 @@
+#include <coral.h>
+
+#include "private/array.h"
+#include "private/tree_set.h"
+#include "bench.h"
+
+/* Loading a tree set with 8 byte members from an array, first by inserting
+ * the members one at a time in ascending order, then by building the tree
+ * out of the sorted array and last by building it out of the same members
+ * shuffled, which sorts them first. Each is done with the red black tree,
+ * the b tree and the compact red black tree engine. */
+
+static const struct {
+    const char *name;
+    int engine;
+} $engines[] = {
+        {"red black tree", CORAL_TREE_SET_ENGINE_RED_BLACK_TREE},
+        {"b tree",         CORAL_TREE_SET_ENGINE_B_TREE},
+        {"compact red black tree",
+                           CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE}
+};
+
+static int $measure(const char *name, struct coral$array *items,
+                    bool (*load)(struct coral$tree_set *,
+                                 struct coral$array *)) {
+    for (size_t e = 0; e < sizeof($engines) / sizeof($engines[0]); e++) {
+        char label[64];
+        struct coral$tree_set set = {};
+        if (!coral$tree_set$init_with_engine(&set, NULL, sizeof(size_t),
+                                             $engines[e].engine,
+                                             coral_compare_size_t)) {
+            return EXIT_FAILURE;
+        }
+        const uint64_t start = coral$bench$now();
+        if (!load(&set, items)) {
+            return EXIT_FAILURE;
+        }
+        snprintf(label, sizeof(label), "%s, %s", $engines[e].name, name);
+        coral$bench$report(label, items->count, coral$bench$now() - start);
+        coral_required_true(coral$tree_set$invalidate(&set, NULL));
+    }
+    return EXIT_SUCCESS;
+}
+
+static bool $insert(struct coral$tree_set *set, struct coral$array *items) {
+    for (size_t i = 0; i < items->count; i++) {
+        if (!coral$tree_set$insert(set, items->data + i * items->size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t count = coral$bench$argument(argc, argv, 1, 1000000);
+    printf("members: %zu\n", count);
+    struct coral$array items;
+    if (!coral$array$init(&items, NULL, count, sizeof(size_t))) {
+        return EXIT_FAILURE;
+    }
+    size_t *data = (size_t *) items.data;
+    for (size_t i = 0; i < count; i++) {
+        data[i] = i;
+    }
+    int result = $measure("insert, ascending", &items,
+                          $insert)
+                 || $measure("build", &items,
+                             coral$tree_set$build);
+    for (size_t i = 0; i < count; i++) {
+        data[i] = (i * 7919) % count;
+    }
+    result = result
+             || $measure("build_unsorted", &items,
+                         coral$tree_set$build_unsorted);
+    coral_required_true(coral$array$invalidate(&items, NULL));
+    return result;
+}
@@ -0,0 +1,54 @@
+#include <coral.h>
+
+#include "private/tree_set.h"
+#include "bench.h"
+
+/* Insert and delete heavy use of a tree set, which spends most of its time on
+ * allocating and freeing nodes. The set is first filled with keys in a
+ * pseudo random order, then it churns, every step deletes the oldest key and
+ * inserts a new one, and last the whole set is torn down at once. */
+
+static size_t $key(const size_t i) {
+    /* odd multiplier, so that no two keys are the same */
+    return i * 0x9e3779b97f4a7c15ULL;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t count = coral$bench$argument(argc, argv, 1, 1000000);
+    const size_t steps = coral$bench$argument(argc, argv, 2, 2000000);
+    printf("items: %zu, churn steps: %zu\n", count, steps);
+    struct coral$tree_set set = {};
+    if (!coral$tree_set$init(&set, NULL, sizeof(size_t),
+                             coral_compare_size_t)) {
+        return EXIT_FAILURE;
+    }
+    uint64_t start = coral$bench$now();
+    for (size_t i = 0; i < count; i++) {
+        const size_t key = $key(i);
+        if (!coral$tree_set$insert(&set, &key)) {
+            return EXIT_FAILURE;
+        }
+    }
+    coral$bench$report("coral$tree_set$insert", count,
+                       coral$bench$now() - start);
+
+    start = coral$bench$now();
+    for (size_t i = 0; i < steps; i++) {
+        const size_t oldest = $key(i);
+        const size_t key = $key(count + i);
+        if (!coral$tree_set$delete(&set, &oldest)
+            || !coral$tree_set$insert(&set, &key)) {
+            return EXIT_FAILURE;
+        }
+    }
+    coral$bench$report("coral$tree_set$delete and insert", steps,
+                       coral$bench$now() - start);
+
+    start = coral$bench$now();
+    if (!coral$tree_set$invalidate(&set, NULL)) {
+        return EXIT_FAILURE;
+    }
+    coral$bench$report("coral$tree_set$invalidate", count,
+                       coral$bench$now() - start);
+    return EXIT_SUCCESS;
+}
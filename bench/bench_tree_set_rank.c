@@ -0,0 +1,99 @@
+#include <coral.h>
+
+#include "private/tree_set.h"
+#include "bench.h"
+
+/* Percentiles of a tree set with 8 byte members, first by stepping through
+ * the members of a red black tree with coral$tree_set$get_next and then with
+ * coral$tree_set$get_at on an order statistic tree, along with what keeping
+ * the counts up to date costs insert and delete. */
+
+static size_t $member(const size_t i) {
+    /* odd multiplier, so that no two members are the same */
+    return i * 0x9e3779b97f4a7c15ULL;
+}
+
+static int $fill(const char *name, struct coral$tree_set *set,
+                 const int engine, const size_t count) {
+    char label[64];
+    if (!coral$tree_set$init_with_engine(set, NULL, sizeof(size_t), engine,
+                                         coral_compare_size_t)) {
+        return EXIT_FAILURE;
+    }
+    const uint64_t start = coral$bench$now();
+    for (size_t i = 0; i < count; i++) {
+        const size_t member = $member(i);
+        if (!coral$tree_set$insert(set, &member)) {
+            return EXIT_FAILURE;
+        }
+    }
+    snprintf(label, sizeof(label), "%s, insert", name);
+    coral$bench$report(label, count, coral$bench$now() - start);
+    return EXIT_SUCCESS;
+}
+
+static int $empty(const char *name, struct coral$tree_set *set,
+                  const size_t count) {
+    char label[64];
+    const uint64_t start = coral$bench$now();
+    for (size_t i = 0; i < count; i++) {
+        const size_t member = $member(i);
+        if (!coral$tree_set$delete(set, &member)) {
+            return EXIT_FAILURE;
+        }
+    }
+    snprintf(label, sizeof(label), "%s, delete", name);
+    coral$bench$report(label, count, coral$bench$now() - start);
+    coral_required_true(coral$tree_set$invalidate(set, NULL));
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+    const size_t count = coral$bench$argument(argc, argv, 1, 1000000);
+    const size_t queries = coral$bench$argument(argc, argv, 2, 100);
+    printf("members: %zu, percentile queries: %zu\n", count, queries);
+    size_t sum = 0;
+
+    struct coral$tree_set set = {};
+    if ($fill("red black tree", &set, CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+              count)) {
+        return EXIT_FAILURE;
+    }
+    uint64_t start = coral$bench$now();
+    for (size_t i = 0; i < queries; i++) {
+        const size_t at = (i % 100) * count / 100;
+        size_t member;
+        coral_required_true(coral$tree_set$get_first(&set,
+                                                     (void **) &member));
+        for (size_t j = 0; j < at; j++) {
+            coral_required_true(coral$tree_set$get_next(
+                    &set, &member, (void **) &member));
+        }
+        sum += member;
+    }
+    coral$bench$report("red black tree, percentile by get_next", queries,
+                       coral$bench$now() - start);
+    if ($empty("red black tree", &set, count)) {
+        return EXIT_FAILURE;
+    }
+
+    if ($fill("order statistic tree", &set,
+              CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE, count)) {
+        return EXIT_FAILURE;
+    }
+    start = coral$bench$now();
+    for (size_t i = 0; i < queries; i++) {
+        const size_t at = (i % 100) * count / 100;
+        size_t member;
+        coral_required_true(coral$tree_set$get_at(&set, at,
+                                                  (void **) &member));
+        sum -= member;
+    }
+    coral$bench$report("order statistic tree, percentile by get_at", queries,
+                       coral$bench$now() - start);
+    if ($empty("order statistic tree", &set, count)) {
+        return EXIT_FAILURE;
+    }
+    /* both ways must have found the same members */
+    return sum ? EXIT_FAILURE : EXIT_SUCCESS;
+}
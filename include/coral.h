@@ -6,9 +6,14 @@
 #include <stdint.h>
 
 #include "coral/error.h"
+#include "coral/allocator.h"
 #include "coral/notification.h"
+#include "coral/notification_dispatcher.h"
 #include "coral/autorelease_pool.h"
+#include "coral/region.h"
 #include "coral/object.h"
+#include "coral/selector.h"
+#include "coral/inline_cache.h"
 #include "coral/interface.h"
 #include "coral/class.h"
 #include "coral/integer.h"
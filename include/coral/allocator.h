@@ -0,0 +1,71 @@
+#ifndef _CORAL_ALLOCATOR_H_
+#define _CORAL_ALLOCATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* The subsystem a block is used by, passed along with every request so that
+ * an allocator can keep separate pools or statistics. A block keeps the tag
+ * it was last allocated or resized with. */
+#define CORAL_ALLOCATOR_TAG_OTHER           0
+#define CORAL_ALLOCATOR_TAG_OBJECT          1
+#define CORAL_ALLOCATOR_TAG_TREE_NODE       2
+#define CORAL_ALLOCATOR_TAG_ARRAY           3
+#define CORAL_ALLOCATOR_TAG_STRING          4
+
+/* Memory used by coral is obtained through an allocator. The calling thread's
+ * allocator is used if one was installed, otherwise the global one, which
+ * unless replaced is backed by malloc(3)/realloc(3)/free(3). Every block
+ * remembers the allocator that provided it and is returned to it, whichever
+ * allocator is installed when, and on whatever thread, the block is freed.
+ * An allocator must therefore remain valid for as long as any of its blocks
+ * are in use. Small objects are served by coral's own per-thread slabs while
+ * the default allocator is in use. The limbs of coral integers are left to
+ * GMP, which allocates them with whatever memory functions the process has
+ * given it. */
+struct coral_allocator {
+    /* allocate size bytes aligned to alignment, a power of two, or return
+     * NULL if there is insufficient memory */
+    void *(*allocate)(void *context, size_t tag, size_t size,
+                      size_t alignment);
+    /* resize the block at ptr from size to new_size bytes, keeping its
+     * contents and alignment, or return NULL if there is insufficient memory
+     * in which case ptr must be left untouched. If NULL then blocks are
+     * resized by allocating a new block and freeing the old one. */
+    void *(*reallocate)(void *context, size_t tag, void *ptr, size_t size,
+                        size_t new_size, size_t alignment);
+    /* release the block at ptr of size bytes. If NULL then blocks are never
+     * released, for example by a bump allocator that is reset as a whole. */
+    void (*deallocate)(void *context, size_t tag, void *ptr, size_t size,
+                       size_t alignment);
+    void *context;
+};
+
+/**
+ * @brief Install the allocator used by all threads that have none of their
+ * own.
+ * @param [in] allocator to install or <i>NULL</i> to restore the default.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_INVALID_VALUE if allocator has no allocate function.
+ */
+bool coral_allocator_set_global(const struct coral_allocator *allocator);
+
+/**
+ * @brief Install the allocator used by the calling thread.
+ * @param [in] allocator to install or <i>NULL</i> to use the global
+ * allocator again.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_INVALID_VALUE if allocator has no allocate function.
+ */
+bool coral_allocator_set_thread(const struct coral_allocator *allocator);
+
+/**
+ * @brief Retrieve the allocator in effect for the calling thread.
+ * @param [out] out receive the allocator.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ */
+bool coral_allocator_get(const struct coral_allocator **out);
+
+#endif /* _CORAL_ALLOCATOR_H_ */
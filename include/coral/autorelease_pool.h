@@ -2,10 +2,67 @@
 #define _CORAL_AUTORELEASE_POOL_H_
 
 #include <stddef.h>
+#include <stdbool.h>
+
+struct coral_class;
+
+/* Statistics of the calling thread's autorelease pools, cheap enough to be
+ * kept at all times. */
+struct coral_autorelease_pool_statistics {
+    size_t depth; /* pools started and not yet ended */
+    size_t pending; /* objects waiting to be released */
+    size_t high_water_mark; /* most objects that were pending at once */
+    size_t drained; /* objects released by ending or draining pools */
+    size_t coalesced; /* releases saved by coalescing */
+};
 
 /**
  * @brief Release all objects in the autorelease pool.
  */
 void coral_autorelease_pool_drain();
 
+/**
+ * @brief Coalesce the releases of objects that were autoreleased more than
+ * once when this thread's autorelease pools are drained.
+ * <p>While enabled, the objects of a pool are tallied and each distinct
+ * object has all of its pending references released by a single atomic
+ * operation. This pays off when the same objects are autoreleased
+ * repeatedly, for example in a loop of lookups, and otherwise only adds the
+ * cost of tallying.</p>
+ * @param [in] enabled true to coalesce releases, false to release every
+ * entry on its own which is the default.
+ */
+void coral_autorelease_pool_set_coalescing(bool enabled);
+
+/**
+ * @brief Retrieve the statistics of this thread's autorelease pools.
+ * @param [out] out receive the statistics.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ */
+bool coral_autorelease_pool_get_statistics(
+        struct coral_autorelease_pool_statistics *out);
+
+/**
+ * @brief Lower the high water mark to the number of pending objects.
+ * <p>Allows the peak of a phase, such as one iteration of a long loop, to be
+ * measured on its own.</p>
+ */
+void coral_autorelease_pool_reset_high_water_mark();
+
+/**
+ * @brief Report how many of the pending objects belong to each class.
+ * <p>The pending objects are only counted when this is called, which takes
+ * time proportional to their number.</p>
+ * @param [in] on_class called once for every class with pending objects.
+ * @param [in] args passed to on_class.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if on_class is <i>NULL</i>.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to count the pending objects.
+ */
+bool coral_autorelease_pool_get_class_counts(
+        void (*on_class)(struct coral_class *class, size_t count, void *args),
+        void *args);
+
 #endif /* _CORAL_AUTORELEASE_POOL_H_ */
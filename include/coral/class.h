@@ -132,6 +132,7 @@ struct coral_class_method_name {
  * @throws CORAL_ERROR_INVALID_VALUE if method name is invalid by having either
  * <i>ZERO</i> size or <i>NULL</i> data.
  * @throws CORAL_ERROR_METHOD_ALREADY_EXISTS if method is already in the class.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the class is frozen.
  * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is uninitialized or
  * (being) destroyed.
  */
@@ -149,6 +150,7 @@ bool coral_class_method_add(struct coral_class *object,
  * @throws CORAL_ERROR_INVALID_VALUE if method name is invalid by having either
  * <i>ZERO</i> size or <i>NULL</i> data.
  * @throws CORAL_ERROR_METHOD_NOT_FOUND if method is not in the class.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the class is frozen.
  * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is uninitialized or
  * (being) destroyed.
  */
@@ -173,4 +175,52 @@ bool coral_class_method_get(struct coral_class *object,
                             struct coral_class_method_name *name,
                             coral_invokable_t *out);
 
+struct coral_selector;
+
+/**
+ * @brief Retrieve the invokable for the given selector.
+ * <p>Unlike looking up the method by name this neither hashes nor compares
+ * the name of the method.</p>
+ * @param [in] object class which we will look up the method by selector.
+ * @param [in] selector of method whose invokable we would like to retrieve.
+ * @param [out] out receive the invokable.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if selector or out is <i>NULL</i>.
+ * @throws CORAL_ERROR_METHOD_NOT_FOUND if method is not in the class.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is uninitialized or
+ * (being) destroyed.
+ */
+bool coral_class_method_get_selector(struct coral_class *object,
+                                     const struct coral_selector *selector,
+                                     coral_invokable_t *out);
+
+/**
+ * @brief Freeze the methods of the class.
+ * <p>The methods are compiled into an immutable table in which every lookup
+ * is a single probe, after which looking up a method takes neither the lock
+ * of the class nor allocates. Methods can no longer be added or removed.
+ * Freezing a frozen class has no effect.</p>
+ * @param [in] object class to freeze.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to freeze the class.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is uninitialized or
+ * (being) destroyed.
+ */
+bool coral_class_freeze(struct coral_class *object);
+
+/**
+ * @brief Check if the class is frozen.
+ * @param [in] object class to check.
+ * @param [out] out receive true if the class is frozen, otherwise false.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is uninitialized or
+ * (being) destroyed.
+ */
+bool coral_class_is_frozen(struct coral_class *object, bool *out);
+
 #endif /* _CORAL_CLASS_H_ */
@@ -0,0 +1,50 @@
+#ifndef _CORAL_INLINE_CACHE_H_
+#define _CORAL_INLINE_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CORAL_INLINE_CACHE_MAXIMUM_ENTRIES 4
+
+struct coral_class;
+struct coral_selector;
+
+/* Caches the invokable of one selector per receiver class at a call site. A
+ * cache with a single entry is monomorphic, one with more entries is
+ * polymorphic and replaces its entries in turn once they have all been
+ * used. Only methods of frozen classes are cached as those cannot change,
+ * an entry is keyed on the class and the generation it was frozen with.
+ * The cache is owned by the caller and must not be used by more than one
+ * thread at a time. */
+struct coral_inline_cache {
+    const struct coral_selector *selector;
+    size_t capacity;
+    size_t count;
+    size_t next;
+    size_t hits;
+    size_t misses;
+    struct {
+        const struct coral_class *class;
+        size_t generation;
+        bool (*invokable)(void *this, void *data, void *args);
+    } entries[CORAL_INLINE_CACHE_MAXIMUM_ENTRIES];
+};
+
+/**
+ * @brief Initialize the inline cache.
+ * @param [in] object inline cache to be initialized.
+ * @param [in] selector of the method that is dispatched at the call site.
+ * @param [in] capacity number of receiver classes to cache, one for a
+ * monomorphic cache.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if selector is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if capacity is <i>ZERO</i> or larger than
+ * CORAL_INLINE_CACHE_MAXIMUM_ENTRIES.
+ */
+bool coral_inline_cache_init(struct coral_inline_cache *object,
+                             const struct coral_selector *selector,
+                             size_t capacity);
+
+#endif /* _CORAL_INLINE_CACHE_H_ */
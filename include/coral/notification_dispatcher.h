@@ -0,0 +1,57 @@
+#ifndef _CORAL_NOTIFICATION_DISPATCHER_H_
+#define _CORAL_NOTIFICATION_DISPATCHER_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Asynchronous notification dispatcher.
+ *
+ * While running, notifications posted to observed objects are pushed onto a
+ * lock-free queue instead of being delivered by the posting thread, which is
+ * usually holding the write lock of the object. A pool of workers takes the
+ * whole queue at once and delivers it as a batch, a worker that was idle
+ * first waits briefly to let the batch build up. Repeated notifications for
+ * the same object within a batch are delivered only once. Notifications in a
+ * batch are delivered in the order that they were posted, but batches may be
+ * delivered concurrently when there is more than one worker.
+ * CORAL_NOTIFICATION_OBJECT_DESTROYED is always delivered synchronously. */
+
+struct coral_notification_dispatcher_statistics {
+    size_t posted; /* notifications queued for the workers */
+    size_t delivered; /* notifications delivered by the workers */
+    size_t coalesced; /* repeated notifications that were dropped */
+    size_t batches; /* batches taken by the workers */
+};
+
+/**
+ * @brief Start the notification dispatcher.
+ * @param [in] workers number of threads that deliver the notifications.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_INVALID_VALUE if workers is zero.
+ * @throws CORAL_ERROR_OBJECT_ALREADY_EXISTS if the dispatcher is running.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to start the dispatcher.
+ * @throws CORAL_ERROR_SYSCALL_FAILED if a worker could not be created.
+ */
+bool coral_notification_dispatcher_start(size_t workers);
+
+/**
+ * @brief Stop the notification dispatcher.
+ * <p>Every notification that has already been queued is delivered before
+ * the workers exit, after which notifications are delivered synchronously
+ * again. Must not be called concurrently with start.</p>
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the dispatcher is not running.
+ */
+bool coral_notification_dispatcher_stop();
+
+/**
+ * @brief Retrieve the statistics of the notification dispatcher.
+ * @param [out] out receive the statistics.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ */
+bool coral_notification_dispatcher_get_statistics(
+        struct coral_notification_dispatcher_statistics *out);
+
+#endif /* _CORAL_NOTIFICATION_DISPATCHER_H_ */
@@ -87,6 +87,10 @@ extern const char *is_equal;
 
 /**
  * @brief Return a copy of the given object.
+ * <p>The copy shares the contents of object until either of them is first
+ * invoked with readonly set to false, only then is the class copy method
+ * called to give the copy contents of its own. If the class has no copy
+ * method the copy remains an alias of object.</p>
  * @param [in] object that we would like to copy.
  * @param [out] out receive the copy.
  * @return On success true, otherwise false if an error has occurred.
@@ -95,6 +99,7 @@ extern const char *is_equal;
  * @throws CORAL_ERROR_INVALID_VALUE if object and *out are the same object.
  * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is uninitialized or
  * (being) destroyed.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if object may not be copied.
  */
 bool coral_object_copy(void *object, void **out);
 
@@ -114,6 +119,22 @@ extern const char *copy;
  */
 bool coral_object_retain(void *object);
 
+/**
+ * @brief Retain each of the given objects.
+ * <p>All objects are checked before any of them is retained, and consecutive
+ * occurrences of the same object are retained with a single atomic
+ * operation.</p>
+ * @param [in] objects array of objects, <i>NULL</i> members are skipped.
+ * @param [in] count number of members in objects.
+ * @return On success true, otherwise false if an error has occurred in which
+ * case none of the objects were retained.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if objects is <i>NULL</i> while
+ * count is not zero.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if any of the objects is
+ * uninitialized or (being) destroyed.
+ */
+bool coral_object_retain_many(void **objects, size_t count);
+
 /**
  * @brief Release and possibly free object resources.
  * @param [in] object whose reference count we are to decrease and upon zero
@@ -125,6 +146,23 @@ bool coral_object_retain(void *object);
  */
 bool coral_object_release(void *object);
 
+/**
+ * @brief Release each of the given objects and possibly free their
+ * resources.
+ * <p>All objects are checked before any of them is released, and consecutive
+ * occurrences of the same object are released with a single atomic
+ * operation.</p>
+ * @param [in] objects array of objects, <i>NULL</i> members are skipped.
+ * @param [in] count number of members in objects.
+ * @return On success true, otherwise false if an error has occurred in which
+ * case none of the objects were released.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if objects is <i>NULL</i> while
+ * count is not zero.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if any of the objects is
+ * uninitialized or (being) destroyed.
+ */
+bool coral_object_release_many(void **objects, size_t count);
+
 /**
  * @brief Allow object to return from current function.
  * @param [in] object whose reference count will be retained and released in
@@ -187,4 +225,51 @@ bool coral_object_invoke(void *object,
 bool coral_object_dispatch(void *object, bool readonly, const char *method,
                            void *args);
 
+struct coral_selector;
+
+/**
+ * @brief Lookup method on object by its selector and then invoke it.
+ * <p>The method is found by its interned selector, the name of the method is
+ * neither hashed nor compared.</p>
+ * @param [in] object instance.
+ * @param [in] readonly set to true if calling the method will not change
+ * the state of the object, otherwise use false.
+ * @param [in] selector of the method.
+ * @param [in, out] args used by function to modify object and to provide
+ * results.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_METHOD_NOT_FOUND if the given method could not be found.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is not a valid
+ * instance.
+ * @note If object or selector is <i>NULL</i> we will call abort(3).
+ */
+bool coral_object_dispatch_selector(void *object,
+                                    bool readonly,
+                                    const struct coral_selector *selector,
+                                    void *args);
+
+struct coral_inline_cache;
+
+/**
+ * @brief Lookup method on object through the inline cache of the call site
+ * and then invoke it.
+ * <p>When the class of object is in the cache the method is not looked up
+ * on the class at all.</p>
+ * @param [in] object instance.
+ * @param [in] readonly set to true if calling the method will not change
+ * the state of the object, otherwise use false.
+ * @param [in] cache of the call site.
+ * @param [in, out] args used by function to modify object and to provide
+ * results.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_METHOD_NOT_FOUND if the given method could not be found.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is not a valid
+ * instance.
+ * @note If object or cache is <i>NULL</i> we will call abort(3).
+ */
+bool coral_object_dispatch_cached(void *object,
+                                  bool readonly,
+                                  struct coral_inline_cache *cache,
+                                  void *args);
+
 #endif /* _CORAL_OBJECT_H_ */
@@ -0,0 +1,59 @@
+#ifndef _CORAL_REGION_H_
+#define _CORAL_REGION_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/* A region serves all memory that the calling thread asks of coral, objects,
+ * tree nodes and collection storage alike, by bumping a cursor through large
+ * chunks. Freeing a block inside a region only counts it as dead and the
+ * chunks are given back as a whole once the region ends. Each region also
+ * starts an autorelease pool scope which is collected when it ends, so that
+ * a request can create its temporary objects without releasing any of them
+ * individually. */
+struct coral_region;
+
+/**
+ * @brief Start a region on the calling thread.
+ * <p>The chunks of the region come from the allocator that was in effect
+ * when it started, which must remain valid until all of the region's memory
+ * has been returned. Regions nest, the innermost one is used.</p>
+ * @param [out] out receive the region.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to start the region.
+ */
+bool coral_region_start(struct coral_region **out);
+
+/**
+ * @brief End the innermost region of the calling thread.
+ * <p>Objects added to the autorelease pool since the region started are
+ * released. Blocks of the region that are still in use afterwards, such as
+ * objects that were retained by something outside of the region, have
+ * escaped, in which case the chunks of the region are kept until the last of
+ * them has been freed. Otherwise the chunks are returned when it ends.</p>
+ * @param [in] region to end.
+ * @param [out] out receive the number of blocks that escaped the region.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if region is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if region is not the innermost region of
+ * the calling thread.
+ */
+bool coral_region_end(struct coral_region *region, size_t *out);
+
+/**
+ * @brief Check if a block was allocated in the given region.
+ * @param [in] region to search.
+ * @param [in] block to check.
+ * @param [out] out receive true if the block lies in one of the region's
+ * chunks, otherwise false.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if region is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if block or out is <i>NULL</i>.
+ */
+bool coral_region_contains(const struct coral_region *region,
+                           const void *block, bool *out);
+
+#endif /* _CORAL_REGION_H_ */
@@ -0,0 +1,32 @@
+#ifndef _CORAL_SELECTOR_H_
+#define _CORAL_SELECTOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* An interned method name. Every name is registered only once, so two
+ * selectors for the same name are the very same instance and may be compared
+ * by pointer or id. Selectors live for as long as the process does. */
+struct coral_selector {
+    const char *name;
+    size_t size;
+    size_t id;
+    size_t hash;
+};
+
+/**
+ * @brief Retrieve the selector for the given method name.
+ * <p>The selector is registered if this is the first time that the name is
+ * used, callers should retrieve it once and keep it around.</p>
+ * @param [in] name of the method.
+ * @param [out] out receive the selector.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if name or out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if name is empty.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to register the selector.
+ */
+bool coral_selector_of(const char *name, const struct coral_selector **out);
+
+#endif /* _CORAL_SELECTOR_H_ */
@@ -53,6 +53,30 @@ bool coral_tree_map_init(struct coral_tree_map *object,
                          int (*compare)(const void *first,
                                         const void *second));
 
+/**
+ * @brief Initialize the tree map instance to keep its entries in engine.
+ * @param [in] object instance to be initialized.
+ * @param [in] limit range values used to provide a lower and upper limit to
+ * the number of entries contained within the tree map.
+ * @param [in] engine one of <i>CORAL_TREE_SET_ENGINE_RED_BLACK_TREE</i>,
+ * <i>CORAL_TREE_SET_ENGINE_B_TREE</i>,
+ * <i>CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE</i> or
+ * <i>CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE</i>.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if the <u>first key</u> is considered
+ * to be respectively less than, equal to, or greater than the <u>second
+ * key</u>.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if compare is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if engine is not one of the above.
+ */
+bool coral_tree_map_init_with_engine(struct coral_tree_map *object,
+                                     struct coral_range_values *limit,
+                                     int engine,
+                                     int (*compare)(const void *first,
+                                                    const void *second));
+
 /**
  * @brief Destroy the tree map instance.
  * @param [in] object instance to be destroyed.
@@ -176,6 +200,60 @@ bool coral_tree_map_get_count(struct coral_tree_map *object, size_t *out);
 bool coral_tree_map_insert(struct coral_tree_map *object,
                            struct coral_tree_map_entry *entry);
 
+/**
+ * @brief Build an empty tree map out of entries that are already sorted.
+ * <p>The keys and values are retained and the entries are linked into the
+ * tree map in linear time, rather than searching for and rebalancing after
+ * each one in turn.</p>
+ * @param [in] object instance which is to be built.
+ * @param [in] entries to be copied into the tree map, in ascending order by
+ * key without duplicate keys.
+ * @param [in] count of entries.
+ * @return On success true, otherwise false if an error has occurred and the
+ * tree map is left empty.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if entries is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if an entry's key is <i>NULL</i> or the
+ * entries are not in strictly ascending order by key.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the tree map is not empty or the
+ * count of entries will exceed the upper limit on the total number of
+ * instances allowed.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to hold the entries.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object, or any of the keys
+ * or values, is uninitialized or (being) destroyed.
+ */
+bool coral_tree_map_build(struct coral_tree_map *object,
+                          const struct coral_tree_map_entry *entries,
+                          size_t count);
+
+/**
+ * @brief Build an empty tree map out of entries in any order.
+ * <p>The entries are sorted once they have been copied, which leaves the
+ * order of entries untouched, and are then built as with
+ * coral_tree_map_build(...).</p>
+ * @param [in] object instance which is to be built.
+ * @param [in] entries to be copied into the tree map, without duplicate
+ * keys.
+ * @param [in] count of entries.
+ * @return On success true, otherwise false if an error has occurred and the
+ * tree map is left empty.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if entries is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if an entry's key is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_ALREADY_EXISTS if a key is given more than once.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the tree map is not empty or the
+ * count of entries will exceed the upper limit on the total number of
+ * instances allowed.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to hold the entries.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object, or any of the keys
+ * or values, is uninitialized or (being) destroyed.
+ */
+bool coral_tree_map_build_unsorted(struct coral_tree_map *object,
+                                   const struct coral_tree_map_entry *entries,
+                                   size_t count);
+
 /**
  * @brief Delete entry from tree map.
  * @param [in] object instance where we would like to delete the entry.
@@ -7,6 +7,22 @@
 
 struct coral_tree_set;
 
+/* Members are kept in a red black tree, one member to a node, whose members
+ * stay where they are until deleted. */
+#define CORAL_TREE_SET_ENGINE_RED_BLACK_TREE    0
+/* Members are kept in a b tree, many members to a node, which takes fewer
+ * cache misses to search or scan but moves members on insert and delete. */
+#define CORAL_TREE_SET_ENGINE_B_TREE            1
+/* Members are kept in a red black tree whose nodes also count the members in
+ * their subtree, which costs a word per member but finds a member by its
+ * index, or the index of a member, in O(log n). */
+#define CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE  2
+/* Members are kept in a red black tree whose nodes sit side by side in one
+ * array and link to each other by 32-bit indices, which takes less memory and
+ * fewer cache misses than nodes linked by pointers, but moves the members
+ * whenever the array grows. */
+#define CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE    3
+
 #pragma mark coral_object
 
 struct coral_class;
@@ -47,6 +63,29 @@ bool coral_tree_set_init(struct coral_tree_set *object,
                          int (*compare)(const void *first,
                                         const void *second));
 
+/**
+ * @brief Initialize the tree set instance to keep its instances in engine.
+ * @param [in] object instance to be initialized.
+ * @param [in] limit range values used to provide a lower and upper limit to
+ * the number of items contained within the tree set.
+ * @param [in] engine one of <i>CORAL_TREE_SET_ENGINE_RED_BLACK_TREE</i>,
+ * <i>CORAL_TREE_SET_ENGINE_B_TREE</i>,
+ * <i>CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE</i> or
+ * <i>CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE</i>.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if <u>first</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>second</u>.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if compare is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if engine is not one of the above.
+ */
+bool coral_tree_set_init_with_engine(struct coral_tree_set *object,
+                                     struct coral_range_values *limit,
+                                     int engine,
+                                     int (*compare)(const void *first,
+                                                    const void *second));
+
 /**
  * @brief Destroy the tree set instance.
  * @param [in] object instance to be destroyed.
@@ -168,6 +207,58 @@ bool coral_tree_set_get_count(struct coral_tree_set *object, size_t *out);
  */
 bool coral_tree_set_insert(struct coral_tree_set *object, void *instance);
 
+/**
+ * @brief Build an empty tree set out of instances that are already sorted.
+ * <p>The instances are retained and linked into the tree set in linear time,
+ * rather than searching for and rebalancing after each one in turn.</p>
+ * @param [in] object instance which is to be built.
+ * @param [in] instances to be added to the tree set, in ascending order by
+ * the comparison of the tree set, without duplicates.
+ * @param [in] count of instances.
+ * @return On success true, otherwise false if an error has occurred and the
+ * tree set is left empty.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if instances, or any one of them,
+ * is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the instances are not in strictly
+ * ascending order.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the tree set is not empty or the
+ * count of instances will exceed the upper limit on the total number of
+ * instances allowed.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to hold the instances.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object, or any one of the
+ * instances, is uninitialized or (being) destroyed.
+ */
+bool coral_tree_set_build(struct coral_tree_set *object, void **instances,
+                          size_t count);
+
+/**
+ * @brief Build an empty tree set out of instances in any order.
+ * <p>The instances are sorted once they have been copied, which leaves the
+ * order of instances untouched, and are then built as with
+ * coral_tree_set_build(...).</p>
+ * @param [in] object instance which is to be built.
+ * @param [in] instances to be added to the tree set, without duplicates.
+ * @param [in] count of instances.
+ * @return On success true, otherwise false if an error has occurred and the
+ * tree set is left empty.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if instances, or any one of them,
+ * is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_ALREADY_EXISTS if an instance is given more than
+ * once.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the tree set is not empty or the
+ * count of instances will exceed the upper limit on the total number of
+ * instances allowed.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to hold the instances.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object, or any one of the
+ * instances, is uninitialized or (being) destroyed.
+ */
+bool coral_tree_set_build_unsorted(struct coral_tree_set *object,
+                                   void **instances, size_t count);
+
 /**
  * @brief Delete instance from tree set.
  * @param [in] object where we would like to delete the instance.
@@ -223,6 +314,42 @@ bool coral_tree_set_get_first(struct coral_tree_set *object, void **out);
  */
 bool coral_tree_set_get_last(struct coral_tree_set *object, void **out);
 
+/**
+ * @brief Retrieve the instance at index.
+ * @param [in] object from which we are to fetch the instance.
+ * @param [in] at zero based index of the instance in ascending order.
+ * @param [out] out receive the instance at index.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the tree set does not use the
+ * <i>CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE</i> engine.
+ * @throws CORAL_ERROR_INDEX_OUT_OF_BOUNDS if at is not less than the count
+ * of instances.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is uninitialized or
+ * (being) destroyed.
+ */
+bool coral_tree_set_get_at(struct coral_tree_set *object, size_t at,
+                           void **out);
+
+/**
+ * @brief Retrieve the count of instances less than instance.
+ * <p>Instance need not be in the tree set, if it is then the count is also
+ * its index.</p>
+ * @param [in] object whose instances are to be counted.
+ * @param [in] instance whose rank we want.
+ * @param [out] out receive the count of instances less than instance.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if instance or out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the tree set does not use the
+ * <i>CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE</i> engine.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is uninitialized or
+ * (being) destroyed.
+ */
+bool coral_tree_set_rank_of(struct coral_tree_set *object, void *instance,
+                            size_t *out);
+
 /**
  * @brief Retrieve the next instance.
  * @param [in] object from which we are to retrieve the next instance.
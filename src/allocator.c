@@ -0,0 +1,227 @@
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include <coral.h>
+
+#include "private/allocator.h"
+#include "test/cmocka.h"
+
+#pragma mark private -
+
+#define $TAG_BITS 3
+
+/* Every block is preceded by a header that records the allocator that
+ * provided it, the size that was requested from that allocator and its tag.
+ * The tag takes the top bits of the size so the header stays two words. */
+struct $header {
+    const struct coral_allocator *allocator;
+    size_t size: CHAR_BIT * sizeof(size_t) - $TAG_BITS;
+    size_t tag: $TAG_BITS;
+};
+
+#define $ALIGNMENT alignof(max_align_t)
+#define $SIZE_MAX (SIZE_MAX >> $TAG_BITS)
+
+_Static_assert(sizeof(struct $header) <= $ALIGNMENT,
+               "header must not disturb the alignment of blocks");
+_Static_assert(CORAL_ALLOCATOR_TAG_STRING < (1 << $TAG_BITS),
+               "header must have room for every tag");
+
+static void *$default_alloc(void *context, const size_t tag,
+                            const size_t size, const size_t alignment) {
+    if (alignment <= $ALIGNMENT) {
+        return malloc(size);
+    }
+    const size_t size_ = (size + alignment - 1) & ~(alignment - 1);
+    return aligned_alloc(alignment, size_);
+}
+
+static void *$default_realloc(void *context, const size_t tag, void *ptr,
+                              const size_t size, const size_t new_size,
+                              const size_t alignment) {
+    if (alignment <= $ALIGNMENT) {
+        return realloc(ptr, new_size);
+    }
+    void *result = $default_alloc(context, tag, new_size, alignment);
+    if (result) {
+        memcpy(result, ptr, size < new_size ? size : new_size);
+        free(ptr);
+    }
+    return result;
+}
+
+static void $default_free(void *context, const size_t tag, void *ptr,
+                          const size_t size, const size_t alignment) {
+    free(ptr);
+}
+
+static const struct coral_allocator $default = {
+        .allocate = $default_alloc,
+        .reallocate = $default_realloc,
+        .deallocate = $default_free
+};
+
+static atomic_uintptr_t $global;
+static thread_local const struct coral_allocator *$thread = NULL;
+
+static const struct coral_allocator *$current() {
+    if ($thread) {
+        return $thread;
+    }
+    const struct coral_allocator *global = (const struct coral_allocator *)
+            atomic_load_explicit(&$global, memory_order_acquire);
+    return global ? global : &$default;
+}
+
+static struct $header *$header_of(void *ptr) {
+    coral_required(ptr);
+    return (struct $header *) ((unsigned char *) ptr - $ALIGNMENT);
+}
+
+static void *$block_of(struct $header *header) {
+    coral_required(header);
+    return (unsigned char *) header + $ALIGNMENT;
+}
+
+bool coral$allocator$is_default() {
+    return &$default == $current();
+}
+
+const struct coral_allocator *coral$allocator$get_thread() {
+    return $thread;
+}
+
+/* Sizes that do not fit next to the tag are as unsatisfiable as overflows */
+static bool $header_size(const size_t size, size_t *out) {
+    coral_required(out);
+    return coral_add_size_t($ALIGNMENT, size, out) && *out <= $SIZE_MAX;
+}
+
+bool coral$allocator$alloc(const size_t tag, const size_t size, void **out) {
+    coral_required_true(tag <= CORAL_ALLOCATOR_TAG_STRING);
+    coral_required(out);
+    const struct coral_allocator *allocator = $current();
+    size_t size_;
+    struct $header *header;
+    if (!$header_size(size, &size_)
+        || !(header = allocator->allocate(allocator->context, tag, size_,
+                                          $ALIGNMENT))) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    header->allocator = allocator;
+    header->size = size_;
+    header->tag = tag;
+    *out = $block_of(header);
+    return true;
+}
+
+bool coral$allocator$calloc(const size_t tag, const size_t count,
+                            const size_t size, void **out) {
+    coral_required(out);
+    size_t size_;
+    if (!coral_multiply_size_t(count, size, &size_)) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    if (!coral$allocator$alloc(tag, size_, out)) {
+        return false;
+    }
+    memset(*out, 0, size_);
+    return true;
+}
+
+bool coral$allocator$realloc(const size_t tag, void *ptr, const size_t size,
+                             void **out) {
+    coral_required_true(tag <= CORAL_ALLOCATOR_TAG_STRING);
+    coral_required(out);
+    if (!ptr) {
+        return coral$allocator$alloc(tag, size, out);
+    }
+    struct $header *header = $header_of(ptr);
+    const struct coral_allocator *allocator = header->allocator;
+    const size_t old_size = header->size;
+    /* blocks move to the allocator in effect when they are resized */
+    if (allocator != $current()) {
+        if (!coral$allocator$alloc(tag, size, out)) {
+            return false;
+        }
+        const size_t used = old_size - $ALIGNMENT;
+        memcpy(*out, ptr, used < size ? used : size);
+        coral$allocator$free(ptr);
+        return true;
+    }
+    size_t size_;
+    if (!$header_size(size, &size_)) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    const size_t old_tag = header->tag;
+    struct $header *result;
+    if (allocator->reallocate && old_tag == tag) {
+        result = allocator->reallocate(allocator->context, tag, header,
+                                       old_size, size_, $ALIGNMENT);
+    } else if ((result = allocator->allocate(allocator->context, tag, size_,
+                                             $ALIGNMENT))) {
+        /* a block that changes subsystem is moved rather than resized */
+        memcpy(result, header, old_size < size_ ? old_size : size_);
+        if (allocator->deallocate) {
+            allocator->deallocate(allocator->context, old_tag, header,
+                                  old_size, $ALIGNMENT);
+        }
+    }
+    if (!result) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    result->allocator = allocator;
+    result->size = size_;
+    result->tag = tag;
+    *out = $block_of(result);
+    return true;
+}
+
+void coral$allocator$free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    struct $header *header = $header_of(ptr);
+    const struct coral_allocator *allocator = header->allocator;
+    if (allocator->deallocate) {
+        allocator->deallocate(allocator->context, header->tag, header,
+                              header->size, $ALIGNMENT);
+    }
+}
+
+#pragma mark public -
+
+bool coral_allocator_set_global(const struct coral_allocator *allocator) {
+    if (allocator && !allocator->allocate) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    atomic_store_explicit(&$global, (uintptr_t) allocator,
+                          memory_order_release);
+    return true;
+}
+
+bool coral_allocator_set_thread(const struct coral_allocator *allocator) {
+    if (allocator && !allocator->allocate) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    $thread = allocator;
+    return true;
+}
+
+bool coral_allocator_get(const struct coral_allocator **out) {
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    *out = $current();
+    return true;
+}
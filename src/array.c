@@ -3,9 +3,11 @@
 #include <threads.h>
 #include <coral.h>
 
+#include "private/allocator.h"
 #include "private/array.h"
 #include "private/coral.h"
 #include "private/class.h"
+#include "private/object.h"
 #include "test/cmocka.h"
 
 #pragma mark private -
@@ -37,7 +39,7 @@ __attribute__((constructor(CORAL_CLASS_LOAD_PRIORITY_ARRAY)))
 static void $on_load() {
     struct coral_range_values value = {0, SIZE_MAX};
     coral_required_true(coral_range_of_rate(&$limit, value, 1.5));
-    coral_required_true(coral_range_retain($limit));
+    coral_required_true(coral$object$set_immortal($limit));
 
     struct coral_class_method_name $method_names[] = {
             {destroy,  strlen(destroy)},
@@ -47,7 +49,7 @@ static void $on_load() {
     /* class for array */
     coral_required_true(coral_class_alloc(&$class));
     coral_required_true(coral_class_init($class));
-    coral_required_true(coral_class_retain($class));
+    coral_required_true(coral$object$set_immortal($class));
     /* destroy */
     coral_required_true(coral_class_method_add(
             $class, &$method_names[0],
@@ -64,18 +66,20 @@ static void $on_load() {
     /* class for search_pattern */
     coral_required_true(coral_class_alloc(&$class$search_pattern));
     coral_required_true(coral_class_init($class$search_pattern));
-    coral_required_true(coral_class_retain($class$search_pattern));
+    coral_required_true(coral$object$set_immortal($class$search_pattern));
     /* destroy */
     coral_required_true(coral_class_method_add(
             $class$search_pattern, &$method_names[0],
             (coral_invokable_t) $array$search_pattern$destroy));
+    coral_required_true(coral_class_freeze($class));
+    coral_required_true(coral_class_freeze($class$search_pattern));
 
     coral_autorelease_pool_drain();
 }
 
 __attribute__((destructor(CORAL_CLASS_LOAD_PRIORITY_ARRAY)))
 static void $on_unload() {
-    coral_required_true(coral_range_release($limit));
+    coral_required_true(coral_range_destroy($limit));
     coral_required_true(coral_class_destroy($class));
     coral_required_true(coral_class_destroy($class$search_pattern));
 
@@ -121,7 +125,7 @@ bool coral$array$invalidate(struct coral$array *object,
     object->size = 0;
     object->count = 0;
     object->capacity = 0;
-    free(object->data);
+    coral$allocator$free(object->data);
     object->data = NULL;
     atomic_fetch_add(&object->id, 1);
     return true;
@@ -169,7 +173,8 @@ bool coral$array$set_capacity(struct coral$array *object, size_t capacity) {
     size_t size;
     void *data = NULL;
     if (!coral_multiply_size_t(capacity, object->size, &size)
-        || (size && !(data = realloc(object->data, size)))) {
+        || (size && !coral$allocator$realloc(
+                CORAL_ALLOCATOR_TAG_ARRAY, object->data, size, &data))) {
         coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
         return false;
     }
@@ -235,7 +240,8 @@ static bool coral$array$set_size(struct coral$array *object,
     size_t size_;
     void *data;
     if (!coral_multiply_size_t(object->capacity, size, &size_)
-        || !(data = realloc(object->data, size_))) {
+        || !coral$allocator$realloc(
+                CORAL_ALLOCATOR_TAG_ARRAY, object->data, size_, &data)) {
         coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
         return false;
     }
@@ -459,7 +465,7 @@ bool coral$array$sort(struct coral$array *object,
 }
 
 static void $context_on_destroy(void *ptr) {
-    free(ptr);
+    coral$allocator$free(ptr);
 }
 
 struct coral$array$search_pattern$context {
@@ -547,7 +553,9 @@ bool coral$array$search_pattern$init_linear(
     struct coral$array$search_pattern$context **address = NULL;
     bool result = coral_context_of(&context, $context_on_destroy)
                   && coral_context_get(context, (void **) &address)
-                  && (*address = calloc(1, sizeof(**address)))
+                  && coral$allocator$calloc(CORAL_ALLOCATOR_TAG_OTHER,
+                                            1, sizeof(**address),
+                                            (void **) address)
                   && coral$range$init(&object->range,
                                       values,
                                       $linear_search_pattern$step_function,
@@ -569,7 +577,9 @@ bool coral$array$search_pattern$init_binary(
     struct coral$array$search_pattern$context_binary **address = NULL;
     bool result = coral_context_of(&context, $context_on_destroy)
                   && coral_context_get(context, (void **) &address)
-                  && (*address = calloc(1, sizeof(**address)))
+                  && coral$allocator$calloc(CORAL_ALLOCATOR_TAG_OTHER,
+                                            1, sizeof(**address),
+                                            (void **) address)
                   && coral$range$init(&object->range,
                                       values,
                                       $binary_search_pattern$step_function,
@@ -647,21 +657,14 @@ struct coral_array {
     struct coral$array array;
 };
 
-static void $array_destroy$object_destroy(void **object, const size_t size) {
-    void *instance = *object;
-    if (!instance) {
-        return;
-    }
-    coral_required_true(coral_object_release(instance));
-}
-
 static bool $array_destroy(struct coral_array *this,
                            void *data,
                            void *args) {
     coral_required(this);
-    void (*const on_destroy)(void *, const size_t) =
-    (void (*)(void *, const size_t)) $array_destroy$object_destroy;
-    return coral$array$invalidate(&this->array, on_destroy);
+    struct coral$array *array = &this->array;
+    coral_required_true(coral_object_release_many((void **) array->data,
+                                                  array->count));
+    return coral$array$invalidate(array, NULL);
 }
 
 static bool $array_is_equal(void *this,
@@ -672,7 +675,7 @@ static bool $array_is_equal(void *this,
     coral_required(args->other);
     coral_required(args->out);
     struct coral_array *object = data;
-    struct coral_array *other = args->other;
+    struct coral_array *other = coral$object$get_data(args->other);
     struct {
         size_t object;
         size_t other;
@@ -742,13 +745,16 @@ static bool $array_copy(void *this,
                 object, i, (struct coral$array$item *) &o));
         coral_required_true(coral$array$get(
                 src, i, (struct coral$array$item *) &p));
-        void *q = *(void **) o.data;
-        if (q && !coral_object_copy(q, p.data)
-            || !coral_object_retain(*(void **) p.data)) {
+        void *q = *(void **) p.data;
+        if (q && !coral_object_copy(q, o.data)) {
+            /* the copies made so far are owned by the array */
+            coral_required_true(coral_object_retain_many(
+                    (void **) object->data, i));
             return false;
         }
     }
-    return true;
+    return coral_object_retain_many((void **) object->data,
+                                    object->count);
 }
 
 struct $array_get_capacity_args {
@@ -802,7 +808,17 @@ static bool $array_set_count(void *this,
     coral_required(data);
     coral_required(args);
     struct coral$array *object = &data->array;
-    return coral$array$set_count(object, args->count);
+    const size_t count = object->count;
+    if (!coral$array$set_count(object, args->count)) {
+        return false;
+    }
+    if (count != args->count) {
+        coral$object_post_notification(
+                this, count < args->count
+                      ? CORAL_NOTIFICATION_CONTAINER_INCREASED
+                      : CORAL_NOTIFICATION_CONTAINER_DECREASED);
+    }
+    return true;
 }
 
 struct $array_get_args {
@@ -846,9 +862,6 @@ static bool $array_set(void *this,
         return false;
     }
     void *i = *(void **) item.data;
-    if (i) {
-        coral_required_true(coral_object_release(i));
-    }
     bool result;
     if (!args->instance) {
         result = coral$array$set(object, args->at, NULL);
@@ -863,6 +876,14 @@ static bool $array_set(void *this,
             }
         }
     }
+    if (result) {
+        /* the replaced instance is released only once the new one is held */
+        if (i) {
+            coral_required_true(coral_object_release(i));
+        }
+        coral$object_post_notification(this,
+                                       CORAL_NOTIFICATION_CONTAINER_CHANGED);
+    }
     return result;
 }
 
@@ -877,19 +898,25 @@ static bool $array_add(void *this,
     coral_required(args);
     struct coral$array *object = &data->array;
 
+    bool result;
     if (!args->instance) {
-        return coral$array$add(object, NULL);
-    }
-    struct coral$array$item item = {
-            .data = &args->instance,
-            .size = sizeof(&args->instance)
-    };
-    if (!coral_object_retain(args->instance)) {
-        return false;
+        result = coral$array$add(object, NULL);
+    } else {
+        struct coral$array$item item = {
+                .data = &args->instance,
+                .size = sizeof(&args->instance)
+        };
+        if (!coral_object_retain(args->instance)) {
+            return false;
+        }
+        result = coral$array$add(object, &item);
+        if (!result) {
+            coral_required_true(coral_object_release(args->instance));
+        }
     }
-    bool result = coral$array$add(object, &item);
-    if (!result) {
-        coral_required_true(coral_object_release(args->instance));
+    if (result) {
+        coral$object_post_notification(this,
+                                       CORAL_NOTIFICATION_CONTAINER_INCREASED);
     }
     return result;
 }
@@ -905,7 +932,12 @@ static bool $array_remove(void *this, struct coral_array *data, void *args) {
         && (instance = *(void **) item.data)) {
         coral_required_true(coral_object_release(instance));
     }
-    return coral$array$remove(object);
+    if (!coral$array$remove(object)) {
+        return false;
+    }
+    coral$object_post_notification(this,
+                                   CORAL_NOTIFICATION_CONTAINER_DECREASED);
+    return true;
 }
 
 struct $array_insert_args {
@@ -920,19 +952,25 @@ static bool $array_insert(void *this,
     coral_required(args);
     struct coral$array *object = &data->array;
 
+    bool result;
     if (!args->instance) {
-        return coral$array$insert(object, args->at, NULL);
-    }
-    if (!coral_object_retain(args->instance)) {
-        return false;
+        result = coral$array$insert(object, args->at, NULL);
+    } else {
+        if (!coral_object_retain(args->instance)) {
+            return false;
+        }
+        struct coral$array$item item = {
+                .data = &args->instance,
+                .size = sizeof(&args->instance)
+        };
+        result = coral$array$insert(object, args->at, &item);
+        if (!result) {
+            coral_required_true(coral_object_release(args->instance));
+        }
     }
-    struct coral$array$item item = {
-            .data = &args->instance,
-            .size = sizeof(&args->instance)
-    };
-    bool result = coral$array$insert(object, args->at, &item);
-    if (!result) {
-        coral_required_true(coral_object_release(args->instance));
+    if (result) {
+        coral$object_post_notification(this,
+                                       CORAL_NOTIFICATION_CONTAINER_INCREASED);
     }
     return result;
 }
@@ -954,7 +992,12 @@ static bool $array_delete(void *this,
         && (instance = *(void **) item.data)) {
         coral_required_true(coral_object_release(instance));
     }
-    return coral$array$delete(object, args->at);
+    if (!coral$array$delete(object, args->at)) {
+        return false;
+    }
+    coral$object_post_notification(this,
+                                   CORAL_NOTIFICATION_CONTAINER_DECREASED);
+    return true;
 }
 
 static thread_local int (*$object_compare)(const void *, const void *);
@@ -979,7 +1022,12 @@ static bool $array_sort(void *this,
     coral_required(args->compare);
     $object_compare = args->compare;
     struct coral$array *object = &data->array;
-    return coral$array$sort(object, args->values, $array_object_compare);
+    if (!coral$array$sort(object, args->values, $array_object_compare)) {
+        return false;
+    }
+    coral$object_post_notification(this,
+                                   CORAL_NOTIFICATION_CONTAINER_CHANGED);
+    return true;
 }
 
 struct coral_array_search_pattern {
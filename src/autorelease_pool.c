@@ -1,90 +1,418 @@
 #include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <threads.h>
+#include <pthread.h>
+#include <sys/mman.h>
 #include <coral.h>
 
+#include "private/allocator.h"
 #include "private/autorelease_pool.h"
+#include "private/object.h"
 #include "test/cmocka.h"
 
 #pragma mark private
 
-static thread_local struct coral$autorelease_pool$entry *$items = NULL;
-static thread_local struct coral$autorelease_pool$entry *$stack = NULL;
+/* Objects are kept in a thread-local stack of page sized chunks. A pool is
+ * only a watermark, the size of the stack when it was started, so starting
+ * and ending a pool that tracks nothing costs a few loads and stores. Chunks
+ * are never returned while the thread uses them, so a steady state of
+ * start/add/end cycles does not allocate or free memory. */
 
-static void
-coral$autorelease_pool$drain(struct coral$autorelease_pool$entry *end) {
-    while ($items && $items != end) {
-        struct coral$autorelease_pool$entry *entry = $items;
-        if (entry->object && !coral_object_release(entry->object)) {
+#define $CHUNK_SIZE 4096
+#define $MAXIMUM_SPARE_CHUNKS 4
+/* coalescing tallies up to $BATCH objects at a time in a table that is kept
+ * at most half full */
+#define $BATCH 1024
+#define $TABLE_BITS 11
+#define $TABLE_CAPACITY ((size_t) 1 << $TABLE_BITS)
+
+struct $chunk {
+    struct $chunk *prev;
+    struct $chunk *next;
+    void *slots[];
+};
+
+#define $SLOTS (($CHUNK_SIZE - sizeof(struct $chunk)) / sizeof(void *))
+
+struct $tally {
+    void *object;
+    size_t count;
+};
+
+struct $table {
+    uint16_t used[$BATCH];
+    struct $tally tallies[$TABLE_CAPACITY];
+};
+
+static thread_local struct $chunk *$bottom = NULL;
+static thread_local struct $chunk *$chunk = NULL;
+static thread_local size_t $count = 0;
+static thread_local size_t $size = 0;
+static thread_local size_t $mark = 0;
+static thread_local size_t $depth = 0;
+static thread_local size_t $chunks = 0;
+static thread_local struct $table *$table = NULL;
+static thread_local bool $coalescing = false;
+static thread_local bool $is_coalescing = false;
+static thread_local size_t $high_water_mark = 0;
+static thread_local size_t $drained = 0;
+static thread_local size_t $coalesced = 0;
+static pthread_once_t $once = PTHREAD_ONCE_INIT;
+static pthread_key_t $key;
+
+static void $on_thread_exit(void *bottom) {
+    for (struct $chunk *chunk = bottom, *next; chunk; chunk = next) {
+        next = chunk->next;
+        coral_required_true(!munmap(chunk, $CHUNK_SIZE));
+    }
+    if ($bottom == bottom) {
+        $bottom = $chunk = NULL;
+        $count = $size = $mark = $depth = $chunks = 0;
+    }
+    if ($table) {
+        coral_required_true(!munmap($table, sizeof(*$table)));
+        $table = NULL;
+    }
+}
+
+static void $key_create() {
+    coral_required_true(!pthread_key_create(&$key, $on_thread_exit));
+}
+
+static struct $chunk *$chunk_of(void *slot) {
+    const uintptr_t mask = ~(uintptr_t) ($CHUNK_SIZE - 1);
+    return (struct $chunk *) ((uintptr_t) slot & mask);
+}
+
+static void **$slot_prev(void **slot) {
+    struct $chunk *chunk = $chunk_of(slot);
+    return slot != chunk->slots ? slot - 1 : &chunk->prev->slots[$SLOTS - 1];
+}
+
+static void **$top() {
+    if ($count) {
+        return &$chunk->slots[$count - 1];
+    }
+    return &$chunk->prev->slots[$SLOTS - 1];
+}
+
+static void $grow() {
+    struct $chunk *next = $chunk ? $chunk->next : $bottom;
+    if (!next) {
+        next = mmap(NULL, $CHUNK_SIZE, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        // TODO: try and handle low memory conditions
+        coral_required_true(MAP_FAILED != next);
+        coral_required_true(next == $chunk_of(next));
+        next->prev = $chunk;
+        next->next = NULL;
+        if ($chunk) {
+            $chunk->next = next;
+        } else {
+            coral_required_true(!pthread_once(&$once, $key_create));
+            coral_required_true(!pthread_setspecific($key, next));
+            $bottom = next;
+        }
+        $chunks += 1;
+    }
+    $chunk = next;
+    $count = 0;
+}
+
+static void $push(void *object) {
+    if (!$chunk || $SLOTS == $count) {
+        $grow();
+    }
+    $chunk->slots[$count++] = object;
+    $size += 1;
+    if ($size > $high_water_mark) {
+        $high_water_mark = $size;
+    }
+}
+
+static void *$pop() {
+    if (!$count) {
+        $chunk = $chunk->prev;
+        $count = $SLOTS;
+    }
+    $size -= 1;
+    return $chunk->slots[--$count];
+}
+
+static void $release(void *object) {
+    $drained += 1;
+    if (!coral_object_release(object)) {
+        coral_required_true(
+                CORAL_ERROR_OBJECT_IS_UNINITIALIZED == coral_error);
+        coral_error = CORAL_ERROR_NONE;
+    }
+}
+
+static bool $table_get() {
+    if (!$table) {
+        struct $table *table = mmap(NULL, sizeof(*table),
+                                    PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == table) {
+            return false;
+        }
+        $table = table;
+    }
+    return true;
+}
+
+static size_t $table_index(void *object) {
+    const uint64_t hash = (uint64_t) (uintptr_t) object
+                          * UINT64_C(0x9E3779B97F4A7C15);
+    return (size_t) (hash >> (64 - $TABLE_BITS));
+}
+
+/* Pop up to $BATCH objects, that lie above floor, into the table and then
+ * release each distinct object once with the number of times it was popped. */
+static void $coalesce(const size_t *floor) {
+    struct $tally *tallies = $table->tallies;
+    size_t count = 0, distinct = 0;
+    for (; count < $BATCH && $size > *floor; count++) {
+        void *object = $pop();
+        size_t i = $table_index(object);
+        while (tallies[i].object && tallies[i].object != object) {
+            i = (1 + i) & ($TABLE_CAPACITY - 1);
+        }
+        if (!tallies[i].object) {
+            tallies[i].object = object;
+            $table->used[distinct++] = (uint16_t) i;
+        }
+        tallies[i].count += 1;
+    }
+    $drained += count;
+    $coalesced += count - distinct;
+    for (size_t j = 0; j < distinct; j++) {
+        struct $tally *tally = &tallies[$table->used[j]];
+        if (!coral$object$release_many(tally->object, tally->count)) {
             coral_required_true(
                     CORAL_ERROR_OBJECT_IS_UNINITIALIZED == coral_error);
             coral_error = CORAL_ERROR_NONE;
         }
-        $items = entry->next;
-        free(entry);
+        tally->object = NULL;
+        tally->count = 0;
     }
 }
 
-static void
-coral$autorelease_pool$push(struct coral$autorelease_pool$entry **head,
-                            void *object) {
-    coral_required(head);
-    struct coral$autorelease_pool$entry *entry = calloc(1, sizeof(*entry));
-    // TODO: try and handle low memory conditions
-    coral_required(entry);
-    entry->object = object;
-    entry->next = *head;
-    *head = entry;
+/* Release the objects above floor, which is read again after every release
+ * as releasing an object may add objects to, or move, the current pool. */
+static void $collect(const size_t *floor) {
+    /* pools that end while releasing coalesced objects use the plain path as
+     * the table is in use */
+    if (!$coalescing || $is_coalescing || !$table_get()) {
+        while ($size > *floor) {
+            $release($pop());
+        }
+        return;
+    }
+    $is_coalescing = true;
+    while ($size > *floor) {
+        $coalesce(floor);
+    }
+    $is_coalescing = false;
 }
 
-void
-coral$autorelease_pool$get_stack(struct coral$autorelease_pool$entry **out) {
-    coral_required(out);
-    *out = $stack;
+static void $trim() {
+    size_t spare = 0;
+    struct $chunk *chunk = $chunk ? $chunk->next : NULL;
+    while (chunk && spare < $MAXIMUM_SPARE_CHUNKS) {
+        chunk = chunk->next;
+        spare += 1;
+    }
+    if (!chunk) {
+        return;
+    }
+    chunk->prev->next = NULL;
+    for (struct $chunk *next; chunk; chunk = next) {
+        next = chunk->next;
+        coral_required_true(!munmap(chunk, $CHUNK_SIZE));
+        $chunks -= 1;
+    }
+}
+
+struct $census {
+    struct coral_class **classes;
+    size_t *counts;
+    size_t capacity;
+    size_t count;
+};
+
+static size_t $census_index(const struct $census *census,
+                            struct coral_class *class) {
+    const uint64_t hash = (uint64_t) (uintptr_t) class
+                          * UINT64_C(0x9E3779B97F4A7C15);
+    size_t i = (size_t) (hash >> 32) & (census->capacity - 1);
+    while (census->classes[i] && census->classes[i] != class) {
+        i = (1 + i) & (census->capacity - 1);
+    }
+    return i;
 }
 
-void
-coral$autorelease_pool$get_items(struct coral$autorelease_pool$entry **out) {
+static bool $census_resize(struct $census *census, const size_t capacity) {
+    struct $census resized = {
+            .capacity = capacity,
+            .count = census->count
+    };
+    if (!coral$allocator$calloc(CORAL_ALLOCATOR_TAG_OTHER,
+                                capacity, sizeof(struct coral_class *),
+                                (void **) &resized.classes)
+        || !coral$allocator$calloc(CORAL_ALLOCATOR_TAG_OTHER,
+                                   capacity, sizeof(size_t),
+                                   (void **) &resized.counts)) {
+        coral$allocator$free(resized.classes);
+        return false;
+    }
+    for (size_t i = 0; i < census->capacity; i++) {
+        if (census->classes[i]) {
+            const size_t j = $census_index(&resized, census->classes[i]);
+            resized.classes[j] = census->classes[i];
+            resized.counts[j] = census->counts[i];
+        }
+    }
+    coral$allocator$free(census->classes);
+    coral$allocator$free(census->counts);
+    *census = resized;
+    return true;
+}
+
+static bool $census_add(struct $census *census, void *object) {
+    struct coral_class *class;
+    if (!coral$object$get_class(coral$object_from(object), &class)) {
+        /* object was destroyed while it was pending */
+        coral_error = CORAL_ERROR_NONE;
+        return true;
+    }
+    if (2 * (1 + census->count) > census->capacity
+        && !$census_resize(census, 2 * census->capacity)) {
+        return false;
+    }
+    const size_t i = $census_index(census, class);
+    if (!census->classes[i]) {
+        census->classes[i] = class;
+        census->count += 1;
+    }
+    census->counts[i] += 1;
+    return true;
+}
+
+void coral$autorelease_pool$get_chunks(size_t *out) {
     coral_required(out);
-    *out = $items;
+    *out = $chunks;
+}
+
+size_t coral$autorelease_pool$get_depth() {
+    return $depth;
 }
 
 void coral$autorelease_pool$add(void *object) {
     coral_required(object);
-    coral$autorelease_pool$push(&$items, object);
+    $push(object);
 }
 
 void coral$autorelease_pool$add_previous(void *object) {
     coral_required(object);
-    coral_required($stack);
-    coral_required($stack->next);
-    struct coral$autorelease_pool$entry *entry = $stack->next->object;
-    coral$autorelease_pool$push(&entry->next, object);
+    $push(object);
+    if (!$depth) {
+        return;
+    }
+    /* move the objects of the current pool up by one slot to make room for
+     * object just below them */
+    void **slot = $top();
+    for (size_t i = 1 + $mark; i < $size; i++) {
+        void **prev = $slot_prev(slot);
+        *slot = *prev;
+        slot = prev;
+    }
+    *slot = object;
+    $mark += 1;
 }
 
-void coral$autorelease_pool$start() {
-    coral$autorelease_pool$push(&$items, NULL);
-    coral$autorelease_pool$push(&$stack, $items);
+size_t coral$autorelease_pool$start() {
+    const size_t watermark = $mark;
+    $mark = $size;
+    $depth += 1;
+    return watermark;
 }
 
-void coral$autorelease_pool$end() {
-    struct coral$autorelease_pool$entry *stack = $stack;
-    if (!stack) {
-        return;
+void coral$autorelease_pool$end(const size_t watermark) {
+    $collect(&$mark);
+    /* the pools may have been drained while this one was in use */
+    $mark = watermark < $size ? watermark : $size;
+    if ($depth) {
+        $depth -= 1;
     }
-    $stack = stack->next;
-    struct coral$autorelease_pool$entry *item = stack->object;
-    coral$autorelease_pool$drain(item->next);
-    free(stack);
 }
 
 #pragma mark public
 
 void coral_autorelease_pool_drain() {
-    while ($stack) {
-        struct coral$autorelease_pool$entry *entry = $stack;
-        $stack = entry->next;
-        free(entry);
+    static const size_t floor = 0;
+    $mark = 0;
+    $depth = 0;
+    $collect(&floor);
+    $trim();
+}
+
+void coral_autorelease_pool_set_coalescing(const bool enabled) {
+    $coalescing = enabled;
+}
+
+bool coral_autorelease_pool_get_statistics(
+        struct coral_autorelease_pool_statistics *out) {
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    *out = (struct coral_autorelease_pool_statistics) {
+            .depth = $depth,
+            .pending = $size,
+            .high_water_mark = $high_water_mark,
+            .drained = $drained,
+            .coalesced = $coalesced
+    };
+    return true;
+}
+
+void coral_autorelease_pool_reset_high_water_mark() {
+    $high_water_mark = $size;
+}
+
+bool coral_autorelease_pool_get_class_counts(
+        void (*on_class)(struct coral_class *class, size_t count, void *args),
+        void *args) {
+    if (!on_class) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    struct $census census = {};
+    if (!$census_resize(&census, 16)) {
+        return false;
+    }
+    size_t remaining = $size;
+    for (struct $chunk *chunk = $bottom; remaining; chunk = chunk->next) {
+        const size_t count = remaining < $SLOTS ? remaining : $SLOTS;
+        for (size_t i = 0; i < count; i++) {
+            if (!$census_add(&census, chunk->slots[i])) {
+                coral$allocator$free(census.classes);
+                coral$allocator$free(census.counts);
+                return false;
+            }
+        }
+        remaining -= count;
+    }
+    /* on_class may use the pools as the census is complete */
+    for (size_t i = 0; i < census.capacity; i++) {
+        if (census.classes[i]) {
+            on_class(census.classes[i], census.counts[i], args);
+        }
     }
-    coral$autorelease_pool$drain(NULL);
+    coral$allocator$free(census.classes);
+    coral$allocator$free(census.counts);
+    return true;
 }
@@ -0,0 +1,728 @@
+#include <stdlib.h>
+#include <string.h>
+#include <coral.h>
+
+#include "private/allocator.h"
+#include "private/b_tree.h"
+#include "test/cmocka.h"
+
+#pragma mark private
+
+/* Nodes have room for one more than their order, so that they can take in
+ * the item, or child, that has them split. */
+static inline size_t $keys_offset(const struct coral$b_tree *object) {
+    return sizeof(struct coral$b_tree$inner)
+           + (1 + object->inner_order) * sizeof(void *);
+}
+
+static inline unsigned char *$keys(const struct coral$b_tree *object,
+                                   const struct coral$b_tree$inner *node) {
+    return (unsigned char *) node + $keys_offset(object);
+}
+
+static bool $leaf_alloc(const struct coral$b_tree *object,
+                        struct coral$b_tree$leaf **out) {
+    const size_t size = sizeof(struct coral$b_tree$leaf)
+                        + (1 + object->leaf_order) * object->size;
+    return coral$allocator$alloc(CORAL_ALLOCATOR_TAG_TREE_NODE, size,
+                                 (void **) out);
+}
+
+static bool $inner_alloc(const struct coral$b_tree *object,
+                         struct coral$b_tree$inner **out) {
+    const size_t size = $keys_offset(object)
+                        + object->inner_order * object->size;
+    return coral$allocator$alloc(CORAL_ALLOCATOR_TAG_TREE_NODE, size,
+                                 (void **) out);
+}
+
+/* Index of the first of count items that is not less than item, is_equal
+ * tells whether that one matches item. */
+static size_t $lower_bound(const struct coral$b_tree *object,
+                           const unsigned char *items,
+                           const size_t count,
+                           const void *item,
+                           bool *is_equal) {
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        const int result = object->compare(item, items + middle * object->size);
+        if (!result) {
+            *is_equal = true;
+            return middle;
+        }
+        if (result < 0) {
+            high = middle;
+        } else {
+            low = 1 + middle;
+        }
+    }
+    *is_equal = false;
+    return low;
+}
+
+/* Ask for the lines of the first half of a leaf as soon as its address is
+ * known, so that they arrive together rather than one miss per probe of the
+ * binary search. Inner nodes are left alone, they are few and mostly cached,
+ * and the second half is more often empty than not. */
+static inline void $prefetch(const struct coral$b_tree$leaf *leaf) {
+    for (size_t i = 0; i < CORAL_B_TREE_NODE_SIZE / 2; i += 64) {
+        __builtin_prefetch((const unsigned char *) leaf + i);
+    }
+}
+
+/* Leaf where item is, or would be, kept. The inner nodes on the way down and
+ * which of their children was taken are recorded in path and at, unless path
+ * is NULL. */
+static struct coral$b_tree$leaf *
+$descend(const struct coral$b_tree *object, const void *item,
+         struct coral$b_tree$inner **path, size_t *at) {
+    void *node = object->root;
+    for (size_t level = 0; 1 + level < object->height; level++) {
+        struct coral$b_tree$inner *inner = node;
+        bool is_equal;
+        size_t i = $lower_bound(object, $keys(object, inner),
+                                inner->count - 1, item, &is_equal);
+        /* items equal to the key are kept to its right */
+        i += is_equal;
+        if (path) {
+            path[level] = inner;
+            at[level] = i;
+        }
+        node = inner->children[i];
+    }
+    $prefetch(node);
+    return node;
+}
+
+/* Find the leaf and index of item. */
+static bool $find(const struct coral$b_tree *object, const void *item,
+                  struct coral$b_tree$leaf **leaf, size_t *at) {
+    if (!object->root) {
+        coral_error = CORAL_ERROR_OBJECT_NOT_FOUND;
+        return false;
+    }
+    *leaf = $descend(object, item, NULL, NULL);
+    bool is_equal;
+    *at = $lower_bound(object, (*leaf)->items, (*leaf)->count, item,
+                       &is_equal);
+    if (!is_equal) {
+        coral_error = CORAL_ERROR_OBJECT_NOT_FOUND;
+        return false;
+    }
+    return true;
+}
+
+/* Drop key i - 1 and child i of node. */
+static void $inner_remove(const struct coral$b_tree *object,
+                          struct coral$b_tree$inner *node, const size_t i) {
+    unsigned char *keys = $keys(object, node);
+    const size_t moved = node->count - 1 - i;
+    memmove(keys + (i - 1) * object->size, keys + i * object->size,
+            moved * object->size);
+    memmove(&node->children[i], &node->children[1 + i],
+            moved * sizeof(void *));
+    node->count -= 1;
+}
+
+/* Take in a child that has fallen below half its order, either by borrowing
+ * from a sibling or by merging with one, which may leave parent short of a
+ * child in turn. Returns true if parent lost a child. */
+static bool $leaf_rebalance(struct coral$b_tree *object,
+                            struct coral$b_tree$inner *parent,
+                            const size_t p) {
+    const size_t size = object->size;
+    const size_t minimum = object->leaf_order / 2;
+    unsigned char *keys = $keys(object, parent);
+    struct coral$b_tree$leaf *node = parent->children[p];
+    if (p) {
+        struct coral$b_tree$leaf *left = parent->children[p - 1];
+        if (left->count > minimum) {
+            memmove(node->items + size, node->items, node->count * size);
+            left->count -= 1;
+            memcpy(node->items, left->items + left->count * size, size);
+            node->count += 1;
+            memcpy(keys + (p - 1) * size, node->items, size);
+            return false;
+        }
+    }
+    if (1 + p < parent->count) {
+        struct coral$b_tree$leaf *right = parent->children[1 + p];
+        if (right->count > minimum) {
+            memcpy(node->items + node->count * size, right->items, size);
+            node->count += 1;
+            right->count -= 1;
+            memmove(right->items, right->items + size, right->count * size);
+            memcpy(keys + p * size, right->items, size);
+            return false;
+        }
+    }
+    const size_t i = p ? p : 1;
+    struct coral$b_tree$leaf *left = parent->children[i - 1];
+    struct coral$b_tree$leaf *right = parent->children[i];
+    memcpy(left->items + left->count * size, right->items, right->count * size);
+    left->count += right->count;
+    left->next = right->next;
+    if (right->next) {
+        right->next->prev = left;
+    } else {
+        object->last = left;
+    }
+    coral$allocator$free(right);
+    $inner_remove(object, parent, i);
+    return true;
+}
+
+static bool $inner_rebalance(struct coral$b_tree *object,
+                             struct coral$b_tree$inner *parent,
+                             const size_t p) {
+    const size_t size = object->size;
+    const size_t minimum = object->inner_order / 2;
+    unsigned char *keys = $keys(object, parent);
+    struct coral$b_tree$inner *node = parent->children[p];
+    unsigned char *node_keys = $keys(object, node);
+    if (p) {
+        struct coral$b_tree$inner *left = parent->children[p - 1];
+        if (left->count > minimum) {
+            /* rotate right through the parent key */
+            memmove(node_keys + size, node_keys, (node->count - 1) * size);
+            memmove(&node->children[1], &node->children[0],
+                    node->count * sizeof(void *));
+            memcpy(node_keys, keys + (p - 1) * size, size);
+            node->children[0] = left->children[left->count - 1];
+            node->count += 1;
+            memcpy(keys + (p - 1) * size,
+                   $keys(object, left) + (left->count - 2) * size, size);
+            left->count -= 1;
+            return false;
+        }
+    }
+    if (1 + p < parent->count) {
+        struct coral$b_tree$inner *right = parent->children[1 + p];
+        if (right->count > minimum) {
+            /* rotate left through the parent key */
+            unsigned char *right_keys = $keys(object, right);
+            memcpy(node_keys + (node->count - 1) * size, keys + p * size,
+                   size);
+            node->children[node->count] = right->children[0];
+            node->count += 1;
+            memcpy(keys + p * size, right_keys, size);
+            memmove(right_keys, right_keys + size, (right->count - 2) * size);
+            memmove(&right->children[0], &right->children[1],
+                    (right->count - 1) * sizeof(void *));
+            right->count -= 1;
+            return false;
+        }
+    }
+    const size_t i = p ? p : 1;
+    struct coral$b_tree$inner *left = parent->children[i - 1];
+    struct coral$b_tree$inner *right = parent->children[i];
+    unsigned char *left_keys = $keys(object, left);
+    /* the parent key comes down between the keys of both */
+    memcpy(left_keys + (left->count - 1) * size, keys + (i - 1) * size, size);
+    memcpy(left_keys + left->count * size, $keys(object, right),
+           (right->count - 1) * size);
+    memcpy(&left->children[left->count], right->children,
+           right->count * sizeof(void *));
+    left->count += right->count;
+    coral$allocator$free(right);
+    $inner_remove(object, parent, i);
+    return true;
+}
+
+static void $release(void *node, const size_t height) {
+    if (height > 1) {
+        struct coral$b_tree$inner *inner = node;
+        for (size_t i = 0; i < inner->count; i++) {
+            $release(inner->children[i], height - 1);
+        }
+    }
+    coral$allocator$free(node);
+}
+
+/* Release the nodes of a build that ran out of memory, the first built of
+ * them are a level higher than the rest. */
+static void $build_release(void **nodes, const size_t built,
+                           const size_t first, const size_t count,
+                           const size_t height) {
+    for (size_t i = 0; i < built; i++) {
+        $release(nodes[i], 1 + height);
+    }
+    for (size_t i = first; i < count; i++) {
+        $release(nodes[i], height);
+    }
+}
+
+#pragma mark public
+
+bool coral$b_tree$init(struct coral$b_tree *object,
+                       const size_t size,
+                       int (*compare)(const void *first, const void *second)) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!compare) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (!size) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    size_t leaf_order = (CORAL_B_TREE_NODE_SIZE
+                         - sizeof(struct coral$b_tree$leaf)) / size;
+    size_t inner_order = (CORAL_B_TREE_NODE_SIZE
+                          - sizeof(struct coral$b_tree$inner))
+                         / (sizeof(void *) + size);
+    /* one of each is kept spare for splitting */
+    leaf_order = leaf_order > CORAL_B_TREE_ORDER_MINIMUM
+            ? leaf_order - 1 : CORAL_B_TREE_ORDER_MINIMUM;
+    inner_order = inner_order > CORAL_B_TREE_ORDER_MINIMUM
+            ? inner_order - 1 : CORAL_B_TREE_ORDER_MINIMUM;
+    size_t bytes;
+    if (!coral_multiply_size_t(1 + CORAL_B_TREE_ORDER_MINIMUM, size, &bytes)
+        || !coral_add_size_t(bytes, CORAL_B_TREE_NODE_SIZE, &bytes)) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    *object = (struct coral$b_tree) {
+            .size = size,
+            .leaf_order = leaf_order,
+            .inner_order = inner_order,
+            .compare = compare
+    };
+    return true;
+}
+
+bool coral$b_tree$invalidate(struct coral$b_tree *object,
+                             void (*on_destroy)(void *)) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (on_destroy) {
+        for (struct coral$b_tree$leaf *leaf = object->first; leaf;
+             leaf = leaf->next) {
+            for (size_t i = 0; i < leaf->count; i++) {
+                on_destroy(leaf->items + i * object->size);
+            }
+        }
+    }
+    if (object->root) {
+        $release(object->root, object->height);
+    }
+    *object = (struct coral$b_tree) {};
+    return true;
+}
+
+bool coral$b_tree$get_count(struct coral$b_tree *object, size_t *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    *out = object->count;
+    return true;
+}
+
+bool coral$b_tree$search(struct coral$b_tree *object, const void *item,
+                         void **out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!item || !out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    struct coral$b_tree$leaf *leaf;
+    size_t at;
+    if (!$find(object, item, &leaf, &at)) {
+        return false;
+    }
+    *out = leaf->items + at * object->size;
+    return true;
+}
+
+bool coral$b_tree$insert(struct coral$b_tree *object, const void *item) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!item) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    const size_t size = object->size;
+    if (!object->root) {
+        struct coral$b_tree$leaf *leaf;
+        if (!$leaf_alloc(object, &leaf)) {
+            return false;
+        }
+        *leaf = (struct coral$b_tree$leaf) {.count = 1};
+        memcpy(leaf->items, item, size);
+        object->root = object->first = object->last = leaf;
+        object->height = 1;
+        object->count = 1;
+        return true;
+    }
+    struct coral$b_tree$inner *path[CORAL_B_TREE_HEIGHT_MAXIMUM];
+    size_t at[CORAL_B_TREE_HEIGHT_MAXIMUM];
+    struct coral$b_tree$leaf *leaf = $descend(object, item, path, at);
+    bool is_equal;
+    const size_t i = $lower_bound(object, leaf->items, leaf->count, item,
+                                  &is_equal);
+    if (is_equal) {
+        coral_error = CORAL_ERROR_OBJECT_ALREADY_EXISTS;
+        return false;
+    }
+    /* allocate every node the splits will need up front, so that running out
+     * of memory leaves the tree as it was */
+    struct coral$b_tree$leaf *spare_leaf = NULL;
+    struct coral$b_tree$inner *spare[1 + CORAL_B_TREE_HEIGHT_MAXIMUM];
+    size_t spares = 0;
+    if (leaf->count == object->leaf_order) {
+        size_t level = object->height - 1;
+        for (; level && path[level - 1]->count == object->inner_order;
+               level--) {
+            spares += 1;
+        }
+        /* the root splits, so a new root is needed above it */
+        spares += !level;
+        bool result = $leaf_alloc(object, &spare_leaf);
+        for (size_t j = 0; result && j < spares; j++) {
+            if (!(result = $inner_alloc(object, &spare[j]))) {
+                while (j--) {
+                    coral$allocator$free(spare[j]);
+                }
+            }
+        }
+        if (!result) {
+            coral$allocator$free(spare_leaf);
+            return false;
+        }
+    }
+    memmove(leaf->items + (1 + i) * size, leaf->items + i * size,
+            (leaf->count - i) * size);
+    memcpy(leaf->items + i * size, item, size);
+    leaf->count += 1;
+    object->count += 1;
+    if (leaf->count <= object->leaf_order) {
+        return true;
+    }
+    struct coral$b_tree$leaf *right = spare_leaf;
+    const size_t keep = leaf->count / 2;
+    right->count = leaf->count - keep;
+    memcpy(right->items, leaf->items + keep * size, right->count * size);
+    leaf->count = keep;
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next) {
+        leaf->next->prev = right;
+    } else {
+        object->last = right;
+    }
+    leaf->next = right;
+    /* hand the first item of the new node and the node itself up a level */
+    const unsigned char *key = right->items;
+    void *child = right;
+    for (size_t level = object->height - 1;; level--) {
+        if (!level) {
+            struct coral$b_tree$inner *root = spare[--spares];
+            root->count = 2;
+            root->children[0] = object->root;
+            root->children[1] = child;
+            memcpy($keys(object, root), key, size);
+            object->root = root;
+            object->height += 1;
+            break;
+        }
+        struct coral$b_tree$inner *parent = path[level - 1];
+        const size_t p = at[level - 1];
+        unsigned char *keys = $keys(object, parent);
+        const size_t moved = parent->count - 1 - p;
+        memmove(keys + (1 + p) * size, keys + p * size, moved * size);
+        memcpy(keys + p * size, key, size);
+        memmove(&parent->children[2 + p], &parent->children[1 + p],
+                moved * sizeof(void *));
+        parent->children[1 + p] = child;
+        parent->count += 1;
+        if (parent->count <= object->inner_order) {
+            break;
+        }
+        struct coral$b_tree$inner *sibling = spare[--spares];
+        const size_t kept = parent->count / 2;
+        sibling->count = parent->count - kept;
+        memcpy(sibling->children, &parent->children[kept],
+               sibling->count * sizeof(void *));
+        memcpy($keys(object, sibling), keys + kept * size,
+               (sibling->count - 1) * size);
+        parent->count = kept;
+        /* the key between the halves moves up, it is left in place past the
+         * keys the parent still has */
+        key = keys + (kept - 1) * size;
+        child = sibling;
+    }
+    coral_required_true(!spares);
+    return true;
+}
+
+bool coral$b_tree$build(struct coral$b_tree *object, const void *items,
+                        const size_t count) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!items) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (object->root) {
+        coral_error = CORAL_ERROR_OBJECT_UNAVAILABLE;
+        return false;
+    }
+    const size_t size = object->size;
+    const unsigned char *item = items;
+    for (size_t i = 1; i < count; i++, item += size) {
+        if (object->compare(item, item + size) >= 0) {
+            coral_error = CORAL_ERROR_INVALID_VALUE;
+            return false;
+        }
+    }
+    if (!count) {
+        return true;
+    }
+    /* as few nodes as will hold them, sharing the items or children out
+     * evenly, which keeps every node at least half full */
+    size_t nodes_count = (count + object->leaf_order - 1) / object->leaf_order;
+    void **nodes;
+    const unsigned char **firsts;
+    if (!coral$allocator$alloc(CORAL_ALLOCATOR_TAG_TREE_NODE,
+                               nodes_count * sizeof(void *),
+                               (void **) &nodes)) {
+        return false;
+    }
+    if (!coral$allocator$alloc(CORAL_ALLOCATOR_TAG_TREE_NODE,
+                               nodes_count * sizeof(void *),
+                               (void **) &firsts)) {
+        coral$allocator$free(nodes);
+        return false;
+    }
+    struct coral$b_tree$leaf *prev = NULL;
+    item = items;
+    for (size_t i = 0; i < nodes_count; i++) {
+        struct coral$b_tree$leaf *leaf;
+        if (!$leaf_alloc(object, &leaf)) {
+            $build_release(nodes, 0, 0, i, 1);
+            coral$allocator$free(firsts);
+            coral$allocator$free(nodes);
+            return false;
+        }
+        const size_t taken = count / nodes_count + (i < count % nodes_count);
+        *leaf = (struct coral$b_tree$leaf) {.prev = prev, .count = taken};
+        memcpy(leaf->items, item, taken * size);
+        item += taken * size;
+        if (prev) {
+            prev->next = leaf;
+        }
+        nodes[i] = prev = leaf;
+        firsts[i] = leaf->items;
+    }
+    object->first = nodes[0];
+    object->last = prev;
+    size_t height = 1;
+    /* each level of inner nodes is written over the start of the one below
+     * it, a node only ever takes children from its own index onwards */
+    while (nodes_count > 1) {
+        const size_t children = nodes_count;
+        nodes_count = (children + object->inner_order - 1)
+                      / object->inner_order;
+        size_t first = 0;
+        for (size_t i = 0; i < nodes_count; i++) {
+            struct coral$b_tree$inner *inner;
+            if (!$inner_alloc(object, &inner)) {
+                $build_release(nodes, i, first, children, height);
+                coral$allocator$free(firsts);
+                coral$allocator$free(nodes);
+                object->first = object->last = NULL;
+                return false;
+            }
+            inner->count = children / nodes_count
+                           + (i < children % nodes_count);
+            memcpy(inner->children, &nodes[first],
+                   inner->count * sizeof(void *));
+            unsigned char *keys = $keys(object, inner);
+            for (size_t j = 1; j < inner->count; j++) {
+                memcpy(keys + (j - 1) * size, firsts[first + j], size);
+            }
+            firsts[i] = firsts[first];
+            nodes[i] = inner;
+            first += inner->count;
+        }
+        height += 1;
+    }
+    object->root = nodes[0];
+    object->height = height;
+    object->count = count;
+    coral$allocator$free(firsts);
+    coral$allocator$free(nodes);
+    return true;
+}
+
+bool coral$b_tree$delete(struct coral$b_tree *object, const void *item) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!item) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (!object->root) {
+        coral_error = CORAL_ERROR_OBJECT_NOT_FOUND;
+        return false;
+    }
+    struct coral$b_tree$inner *path[CORAL_B_TREE_HEIGHT_MAXIMUM];
+    size_t at[CORAL_B_TREE_HEIGHT_MAXIMUM];
+    struct coral$b_tree$leaf *leaf = $descend(object, item, path, at);
+    bool is_equal;
+    const size_t i = $lower_bound(object, leaf->items, leaf->count, item,
+                                  &is_equal);
+    if (!is_equal) {
+        coral_error = CORAL_ERROR_OBJECT_NOT_FOUND;
+        return false;
+    }
+    const size_t size = object->size;
+    leaf->count -= 1;
+    memmove(leaf->items + i * size, leaf->items + (1 + i) * size,
+            (leaf->count - i) * size);
+    object->count -= 1;
+    if (1 == object->height) {
+        if (!leaf->count) {
+            coral$allocator$free(leaf);
+            *object = (struct coral$b_tree) {
+                    .size = object->size,
+                    .leaf_order = object->leaf_order,
+                    .inner_order = object->inner_order,
+                    .compare = object->compare
+            };
+        }
+        return true;
+    }
+    if (leaf->count >= object->leaf_order / 2) {
+        return true;
+    }
+    size_t level = object->height - 2;
+    if (!$leaf_rebalance(object, path[level], at[level])) {
+        return true;
+    }
+    for (; level; level--) {
+        if (path[level]->count >= object->inner_order / 2
+            || !$inner_rebalance(object, path[level - 1], at[level - 1])) {
+            return true;
+        }
+    }
+    /* a root left with a single child hands over to it */
+    struct coral$b_tree$inner *root = object->root;
+    if (1 == root->count) {
+        object->root = root->children[0];
+        object->height -= 1;
+        coral$allocator$free(root);
+    }
+    return true;
+}
+
+bool coral$b_tree$get_first(struct coral$b_tree *object, void **out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    struct coral$b_tree$leaf *leaf = object->first;
+    if (!leaf) {
+        coral_error = CORAL_ERROR_OBJECT_NOT_FOUND;
+        return false;
+    }
+    *out = leaf->items;
+    return true;
+}
+
+bool coral$b_tree$get_last(struct coral$b_tree *object, void **out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    struct coral$b_tree$leaf *leaf = object->last;
+    if (!leaf) {
+        coral_error = CORAL_ERROR_OBJECT_NOT_FOUND;
+        return false;
+    }
+    *out = leaf->items + (leaf->count - 1) * object->size;
+    return true;
+}
+
+bool coral$b_tree$get_next(struct coral$b_tree *object, const void *item,
+                           void **out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!item || !out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    struct coral$b_tree$leaf *leaf;
+    size_t at;
+    if (!$find(object, item, &leaf, &at)) {
+        return false;
+    }
+    if (1 + at < leaf->count) {
+        *out = leaf->items + (1 + at) * object->size;
+        return true;
+    }
+    if (!leaf->next) {
+        coral_error = CORAL_ERROR_END_OF_SEQUENCE;
+        return false;
+    }
+    *out = leaf->next->items;
+    return true;
+}
+
+bool coral$b_tree$get_prev(struct coral$b_tree *object, const void *item,
+                           void **out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!item || !out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    struct coral$b_tree$leaf *leaf;
+    size_t at;
+    if (!$find(object, item, &leaf, &at)) {
+        return false;
+    }
+    if (at) {
+        *out = leaf->items + (at - 1) * object->size;
+        return true;
+    }
+    if (!leaf->prev) {
+        coral_error = CORAL_ERROR_END_OF_SEQUENCE;
+        return false;
+    }
+    *out = leaf->prev->items + (leaf->prev->count - 1) * object->size;
+    return true;
+}
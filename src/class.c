@@ -1,9 +1,12 @@
 #include <stddef.h>
 #include <string.h>
+#include <stdatomic.h>
 #include <coral.h>
 
+#include "private/allocator.h"
 #include "private/class.h"
-#include "private/tree_map.h"
+#include "private/object.h"
+#include "private/selector.h"
 #include "test/cmocka.h"
 
 #pragma mark private -
@@ -33,7 +36,7 @@ static void $on_load() {
     };
     coral_required_true(coral_class_alloc(&$class));
     coral_required_true(coral_class_init($class));
-    coral_required_true(coral_class_retain($class));
+    coral_required_true(coral$object$set_immortal($class));
     /* destroy */
     coral_required_true(coral_class_method_add(
             $class, &$method_names[0],
@@ -46,6 +49,7 @@ static void $on_load() {
     coral_required_true(coral_class_method_add(
             $class, &$method_names[2],
             (coral_invokable_t) $class_is_equal));
+    coral_required_true(coral_class_freeze($class));
 
     coral_autorelease_pool_drain();
 }
@@ -57,35 +61,174 @@ static void $on_unload() {
     coral_autorelease_pool_drain();
 }
 
-struct coral_class {
-    struct coral$tree_map methods;
+struct $method {
+    const struct coral_selector *selector;
+    coral_invokable_t invokable;
+};
+
+/* Perfect tables are at most this many times the methods' power of two */
+#define $FROZEN_SPREAD 4
+
+/* Immutable method table of a frozen class, the selector's id masked by mask
+ * is unique for every method so a lookup is a single probe. When no mask
+ * within $FROZEN_SPREAD does that the table is empty and lookups probe the
+ * open addressed methods, which no longer change either */
+struct $frozen {
+    void *allocation;
+    size_t generation;
+    size_t mask;
+    bool is_perfect;
+    _Alignas(64) struct $method items[];
 };
 
-struct $method_entry {
-    struct {
-        struct coral_class_method_name name;
-    } key;
-    struct {
-        coral_invokable_t invokable;
-    } value;
+/* Every freeze takes the next generation so that a class allocated at the
+ * address of a destroyed one can be told apart */
+static atomic_size_t $generation;
+
+/* Open addressing on the hash of the selector, lookups compare the interned
+ * selectors by pointer only */
+struct coral_class {
+    struct $method *methods;
+    size_t capacity;
+    size_t count;
+    atomic_uintptr_t frozen;
 };
 
-static int
-$class_method_name_compare(const struct coral_class_method_name *a,
-                           const struct coral_class_method_name *b) {
-    if (a->size < b->size) {
-        return (-1);
-    } else if (a->size > b->size) {
-        return 1;
+static struct $method *$class_method_find(const struct coral_class *data,
+                                          const struct coral_selector *selector) {
+    coral_required(data);
+    if (!selector || !data->capacity) {
+        return NULL;
+    }
+    const size_t mask = data->capacity - 1;
+    for (size_t i = selector->hash & mask;; i = (i + 1) & mask) {
+        struct $method *method = &data->methods[i];
+        if (!method->selector) {
+            return NULL;
+        }
+        if (method->selector == selector) {
+            return method;
+        }
+    }
+}
+
+static void $class_method_put(struct coral_class *data,
+                              const struct $method *method) {
+    coral_required(data);
+    coral_required(method);
+    const size_t mask = data->capacity - 1;
+    size_t i = method->selector->hash & mask;
+    while (data->methods[i].selector) {
+        i = (i + 1) & mask;
+    }
+    data->methods[i] = *method;
+}
+
+static bool $class_method_reserve(struct coral_class *data) {
+    coral_required(data);
+    if (2 * (1 + data->count) <= data->capacity) {
+        return true;
+    }
+    const size_t capacity = data->capacity ? 2 * data->capacity : 8;
+    struct $method *methods;
+    if (!coral$allocator$calloc(CORAL_ALLOCATOR_TAG_OTHER,
+                                capacity, sizeof(*methods),
+                                (void **) &methods)) {
+        return false;
+    }
+    struct $method *old = data->methods;
+    const size_t old_capacity = data->capacity;
+    data->methods = methods;
+    data->capacity = capacity;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old[i].selector) {
+            $class_method_put(data, &old[i]);
+        }
+    }
+    coral$allocator$free(old);
+    return true;
+}
+
+static const struct $frozen *$class_get_frozen(const struct coral_class *data) {
+    coral_required(data);
+    return (const struct $frozen *) atomic_load_explicit(
+            &((struct coral_class *) data)->frozen, memory_order_acquire);
+}
+
+static bool $frozen_get(const struct coral_class *data,
+                        const struct $frozen *frozen,
+                        const struct coral_selector *selector,
+                        coral_invokable_t *out) {
+    coral_required(data);
+    coral_required(frozen);
+    coral_required(out);
+    const struct $method *method = !selector
+            ? NULL
+            : frozen->is_perfect
+              ? &frozen->items[selector->id & frozen->mask]
+              : $class_method_find(data, selector);
+    if (!method || method->selector != selector) {
+        coral_error = CORAL_ERROR_METHOD_NOT_FOUND;
+        return false;
+    }
+    *out = method->invokable;
+    return true;
+}
+
+/* Find the smallest power of two whose mask tells every method's id apart,
+ * out is left untouched if there is none within $FROZEN_SPREAD */
+static bool $frozen_get_mask(const struct coral_class *data, size_t *out) {
+    coral_required(data);
+    coral_required(out);
+    size_t size = 1;
+    while (size < data->count) {
+        size <<= 1;
+    }
+    const size_t limit = $FROZEN_SPREAD * size;
+    for (; size <= limit; size <<= 1) {
+        bool *is_used;
+        if (!coral$allocator$calloc(CORAL_ALLOCATOR_TAG_OTHER,
+                                    size, sizeof(bool), (void **) &is_used)) {
+            return false;
+        }
+        bool is_perfect = true;
+        for (size_t i = 0; is_perfect && i < data->capacity; i++) {
+            const struct coral_selector *selector = data->methods[i].selector;
+            if (!selector) {
+                continue;
+            }
+            bool *slot = &is_used[selector->id & (size - 1)];
+            is_perfect = !*slot;
+            *slot = true;
+        }
+        coral$allocator$free(is_used);
+        if (is_perfect) {
+            *out = size - 1;
+            return true;
+        }
+    }
+    return true;
+}
+
+static void $frozen_free(struct coral_class *data) {
+    coral_required(data);
+    struct $frozen *frozen = (struct $frozen *) atomic_exchange_explicit(
+            &data->frozen, 0, memory_order_relaxed);
+    if (frozen) {
+        coral$allocator$free(frozen->allocation);
     }
-    return memcmp(a->data, b->data, a->size);
 }
 
 static bool $class_destroy(struct coral_class *this,
                            void *data,
                            void *args) {
     coral_required(this);
-    return coral$tree_map$invalidate(&this->methods, NULL);
+    $frozen_free(this);
+    coral$allocator$free(this->methods);
+    this->methods = NULL;
+    this->capacity = 0;
+    this->count = 0;
+    return true;
 }
 
 static bool $class_hash_code(void *this,
@@ -107,7 +250,7 @@ static bool $class_is_equal(void *this,
 }
 
 struct $class_method_add_args {
-    struct coral_class_method_name *name;
+    const struct coral_selector *selector;
     coral_invokable_t invokable;
 };
 
@@ -116,24 +259,29 @@ static bool $class_method_add(void *this,
                               struct $class_method_add_args *args) {
     coral_required(data);
     coral_required(args);
-    coral_required(args->name);
-    coral_required(args->name->data);
-    coral_required_true(args->name->size > 0);
+    coral_required(args->selector);
     coral_required(args->invokable);
-    struct $method_entry entry;
-    bool result = coral$tree_map$get(&data->methods, args->name,
-                                     (void **) &entry);
-    if (result) {
+    if ($class_get_frozen(data)) {
+        coral_error = CORAL_ERROR_OBJECT_UNAVAILABLE;
+        return false;
+    }
+    if ($class_method_find(data, args->selector)) {
         coral_error = CORAL_ERROR_METHOD_ALREADY_EXISTS;
         return false;
     }
-    entry.key.name = *args->name;
-    entry.value.invokable = args->invokable;
-    return coral$tree_map$insert(&data->methods, &entry);
+    if (!$class_method_reserve(data)) {
+        return false;
+    }
+    $class_method_put(data, &(struct $method) {
+            .selector = args->selector,
+            .invokable = args->invokable
+    });
+    data->count += 1;
+    return true;
 }
 
 struct $class_method_remove_args {
-    struct coral_class_method_name *name;
+    const struct coral_selector *selector;
 };
 
 static bool $class_method_remove(void *this,
@@ -141,22 +289,33 @@ static bool $class_method_remove(void *this,
                                  struct $class_method_remove_args *args) {
     coral_required(data);
     coral_required(args);
-    coral_required(args->name);
-    coral_required(args->name->data);
-    coral_required_true(args->name->size > 0);
-    struct $method_entry entry;
-    bool result = coral$tree_map$get(&data->methods, args->name,
-                                     (void **) &entry);
-    if (!result) {
-        coral_required_true(CORAL_ERROR_OBJECT_NOT_FOUND == coral_error);
+    if ($class_get_frozen(data)) {
+        coral_error = CORAL_ERROR_OBJECT_UNAVAILABLE;
+        return false;
+    }
+    struct $method *method = $class_method_find(data, args->selector);
+    if (!method) {
         coral_error = CORAL_ERROR_METHOD_NOT_FOUND;
         return false;
     }
-    return coral$tree_map$delete(&data->methods, args->name);
+    /* backward shift deletion keeps every probe sequence intact */
+    const size_t mask = data->capacity - 1;
+    size_t i = method - data->methods;
+    for (size_t j = (i + 1) & mask; data->methods[j].selector;
+         j = (j + 1) & mask) {
+        const size_t home = data->methods[j].selector->hash & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            data->methods[i] = data->methods[j];
+            i = j;
+        }
+    }
+    data->methods[i] = (struct $method) {};
+    data->count -= 1;
+    return true;
 }
 
 struct $class_method_get_args {
-    struct coral_class_method_name *name;
+    const struct coral_selector *selector;
     coral_invokable_t *out;
 };
 
@@ -165,20 +324,82 @@ static bool $class_method_get(void *this,
                               struct $class_method_get_args *args) {
     coral_required(data);
     coral_required(args);
-    coral_required(args->name);
-    coral_required(args->name->data);
-    coral_required_true(args->name->size > 0);
     coral_required(args->out);
-    struct $method_entry entry;
-    bool result = coral$tree_map$get(&data->methods, args->name,
-                                     (void **) &entry);
-    if (!result) {
-        coral_required_true(CORAL_ERROR_OBJECT_NOT_FOUND == coral_error);
+    const struct $frozen *frozen = $class_get_frozen(data);
+    if (frozen) {
+        return $frozen_get(data, frozen, args->selector, args->out);
+    }
+    const struct $method *method = $class_method_find(data, args->selector);
+    if (!method) {
         coral_error = CORAL_ERROR_METHOD_NOT_FOUND;
-    } else {
-        *args->out = entry.value.invokable;
+        return false;
+    }
+    *args->out = method->invokable;
+    return true;
+}
+
+static bool $class_freeze(void *this,
+                          struct coral_class *data,
+                          void *args) {
+    coral_required(data);
+    if ($class_get_frozen(data)) {
+        return true;
+    }
+    size_t mask = SIZE_MAX;
+    if (!$frozen_get_mask(data, &mask)) {
+        return false;
+    }
+    const bool is_perfect = SIZE_MAX != mask;
+    const size_t alignment = _Alignof(struct $frozen);
+    void *allocation;
+    if (!coral$allocator$calloc(CORAL_ALLOCATOR_TAG_OTHER,
+                                1, sizeof(struct $frozen)
+                                   + (is_perfect ? 1 + mask : 0)
+                                     * sizeof(struct $method)
+                                   + alignment - 1, &allocation)) {
+        return false;
+    }
+    struct $frozen *frozen = (struct $frozen *)
+            (((uintptr_t) allocation + alignment - 1) & ~(alignment - 1));
+    frozen->allocation = allocation;
+    frozen->generation = 1 + atomic_fetch_add_explicit(
+            &$generation, 1, memory_order_relaxed);
+    frozen->mask = is_perfect ? mask : 0;
+    frozen->is_perfect = is_perfect;
+    for (size_t i = 0; is_perfect && i < data->capacity; i++) {
+        const struct $method *method = &data->methods[i];
+        if (method->selector) {
+            frozen->items[method->selector->id & mask] = *method;
+        }
     }
-    return result;
+    atomic_store_explicit(&data->frozen, (uintptr_t) frozen,
+                          memory_order_release);
+    return true;
+}
+
+struct $class_is_frozen_args {
+    bool *out;
+};
+
+static bool $class_is_frozen(void *this,
+                             struct coral_class *data,
+                             struct $class_is_frozen_args *args) {
+    coral_required(data);
+    coral_required(args);
+    coral_required(args->out);
+    *args->out = NULL != $class_get_frozen(data);
+    return true;
+}
+
+bool coral$class$is_frozen(const struct coral_class *object) {
+    coral_required(object);
+    return NULL != $class_get_frozen(object);
+}
+
+size_t coral$class$get_generation(const struct coral_class *object) {
+    coral_required(object);
+    const struct $frozen *frozen = $class_get_frozen(object);
+    return frozen ? frozen->generation : 0;
 }
 
 #pragma mark public -
@@ -188,13 +409,7 @@ bool coral_class_alloc(struct coral_class **out) {
 }
 
 bool coral_class_init(struct coral_class *object) {
-    return coral_object_init(object, $class)
-           && coral$tree_map$init(
-            &object->methods,
-            NULL,
-            sizeof((*(struct $method_entry *) 0).key),
-            sizeof((*(struct $method_entry *) 0).value),
-            (int (*)(const void *, const void *)) $class_method_name_compare);
+    return coral_object_init(object, $class);
 }
 
 bool coral_class_destroy(struct coral_class *object) {
@@ -276,9 +491,11 @@ bool coral_class_method_add(struct coral_class *object,
         return false;
     }
     struct $class_method_add_args args = {
-            .name = name,
             .invokable = invokable
     };
+    if (!coral$selector$of(name->data, name->size, &args.selector)) {
+        return false;
+    }
     return coral_object_invoke(
             object,
             false,
@@ -298,10 +515,11 @@ bool coral_class_method_remove(struct coral_class *object,
     }
     if (!name->size || !name->data) {
         coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
     }
-    struct $class_method_remove_args args = {
-            .name = name
-    };
+    /* a name that was never registered is not a method of any class */
+    struct $class_method_remove_args args = {};
+    coral$selector$find(name->data, name->size, &args.selector);
     return coral_object_invoke(
             object,
             false,
@@ -322,9 +540,42 @@ bool coral_class_method_get(struct coral_class *object,
     }
     if (!name->size || !name->data) {
         coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    /* a name that was never registered is not a method of any class */
+    struct $class_method_get_args args = {
+            .out = out
+    };
+    coral$selector$find(name->data, name->size, &args.selector);
+    const struct $frozen *frozen = $class_get_frozen(object);
+    if (frozen) {
+        return $frozen_get(object, frozen, args.selector, out);
+    }
+    return coral_object_invoke(
+            object,
+            true,
+            (coral_invokable_t) $class_method_get,
+            &args);
+}
+
+bool coral_class_method_get_selector(struct coral_class *object,
+                                     const struct coral_selector *selector,
+                                     coral_invokable_t *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!selector || !out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    /* a frozen class never changes, look it up without taking the lock */
+    const struct $frozen *frozen = $class_get_frozen(object);
+    if (frozen) {
+        return $frozen_get(object, frozen, selector, out);
     }
     struct $class_method_get_args args = {
-            .name = name,
+            .selector = selector,
             .out = out
     };
     return coral_object_invoke(
@@ -333,3 +584,34 @@ bool coral_class_method_get(struct coral_class *object,
             (coral_invokable_t) $class_method_get,
             &args);
 }
+
+bool coral_class_freeze(struct coral_class *object) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    return coral_object_invoke(
+            object,
+            false,
+            (coral_invokable_t) $class_freeze,
+            NULL);
+}
+
+bool coral_class_is_frozen(struct coral_class *object, bool *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    struct $class_is_frozen_args args = {
+            .out = out
+    };
+    return coral_object_invoke(
+            object,
+            true,
+            (coral_invokable_t) $class_is_frozen,
+            &args);
+}
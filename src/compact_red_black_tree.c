@@ -0,0 +1,648 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdalign.h>
+#include <coral.h>
+
+#include "private/allocator.h"
+#include "private/compact_red_black_tree.h"
+#include "test/cmocka.h"
+
+#pragma mark private
+
+#define $NIL        CORAL_COMPACT_RED_BLACK_TREE_NIL
+#define $RED        ((uint32_t) 1 << 31)
+
+static inline struct coral$compact_red_black_tree$node *
+$node(const struct coral$compact_red_black_tree *object, const uint32_t i) {
+    return (struct coral$compact_red_black_tree$node *)
+            (object->nodes + (size_t) i * object->stride);
+}
+
+static inline void *
+$item(const struct coral$compact_red_black_tree *object, const uint32_t i) {
+    return (unsigned char *) $node(object, i) + object->offset;
+}
+
+static inline uint32_t $parent(const struct coral$compact_red_black_tree *o,
+                               const uint32_t i) {
+    return $node(o, i)->parent & ~$RED;
+}
+
+static inline void $set_parent(const struct coral$compact_red_black_tree *o,
+                               const uint32_t i, const uint32_t parent) {
+    struct coral$compact_red_black_tree$node *node = $node(o, i);
+    node->parent = (node->parent & $RED) | parent;
+}
+
+static inline bool $is_red(const struct coral$compact_red_black_tree *o,
+                           const uint32_t i) {
+    return $node(o, i)->parent & $RED;
+}
+
+static inline void $set_red(const struct coral$compact_red_black_tree *o,
+                            const uint32_t i, const bool is_red) {
+    struct coral$compact_red_black_tree$node *node = $node(o, i);
+    node->parent = is_red ? node->parent | $RED : node->parent & ~$RED;
+}
+
+static bool $is_node(const struct coral$compact_red_black_tree *object,
+                     const uint32_t i) {
+    if ($NIL == i || i >= object->used) {
+        coral_error = CORAL_ERROR_INDEX_OUT_OF_BOUNDS;
+        return false;
+    }
+    return true;
+}
+
+/* Rotate node x down to the side of is_left, its child on the other side
+ * takes its place. */
+static void $rotate(struct coral$compact_red_black_tree *object,
+                    const uint32_t x, const bool is_left) {
+    struct coral$compact_red_black_tree$node *X = $node(object, x);
+    const uint32_t y = is_left ? X->right : X->left;
+    struct coral$compact_red_black_tree$node *Y = $node(object, y);
+    const uint32_t b = is_left ? Y->left : Y->right;
+    if (is_left) {
+        X->right = b;
+    } else {
+        X->left = b;
+    }
+    if ($NIL != b) {
+        $set_parent(object, b, x);
+    }
+    const uint32_t p = $parent(object, x);
+    $set_parent(object, y, p);
+    if ($NIL == p) {
+        object->root = y;
+    } else {
+        struct coral$compact_red_black_tree$node *P = $node(object, p);
+        if (x == P->left) {
+            P->left = y;
+        } else {
+            P->right = y;
+        }
+    }
+    if (is_left) {
+        Y->left = x;
+    } else {
+        Y->right = x;
+    }
+    $set_parent(object, x, y);
+}
+
+static uint32_t $minimum(const struct coral$compact_red_black_tree *object,
+                         uint32_t i) {
+    for (uint32_t left; $NIL != (left = $node(object, i)->left); i = left);
+    return i;
+}
+
+static uint32_t $maximum(const struct coral$compact_red_black_tree *object,
+                         uint32_t i) {
+    for (uint32_t right; $NIL != (right = $node(object, i)->right);
+         i = right);
+    return i;
+}
+
+/* Node that follows, or precedes, node i in order or the sentinel if there is
+ * none. */
+static uint32_t $step(const struct coral$compact_red_black_tree *object,
+                      uint32_t i, const bool is_next) {
+    const uint32_t child = is_next
+            ? $node(object, i)->right
+            : $node(object, i)->left;
+    if ($NIL != child) {
+        return is_next ? $minimum(object, child) : $maximum(object, child);
+    }
+    /* climb until we arrive from the other side */
+    uint32_t p;
+    for (; $NIL != (p = $parent(object, i)); i = p) {
+        if (i == (is_next ? $node(object, p)->left
+                          : $node(object, p)->right)) {
+            break;
+        }
+    }
+    return p;
+}
+
+static bool $resize(struct coral$compact_red_black_tree *object,
+                    const uint32_t capacity) {
+    size_t size;
+    if (!coral_multiply_size_t(capacity, object->stride, &size)) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    void *nodes;
+    if (!coral$allocator$realloc(CORAL_ALLOCATOR_TAG_TREE_NODE,
+                                 object->nodes, size, &nodes)) {
+        return false;
+    }
+    object->nodes = nodes;
+    object->capacity = capacity;
+    return true;
+}
+
+static bool $take(struct coral$compact_red_black_tree *object,
+                  uint32_t *out) {
+    coral_required(out);
+    if ($NIL != object->available) {
+        *out = object->available;
+        object->available = $node(object, *out)->left;
+        return true;
+    }
+    if (object->used == object->capacity) {
+        const uint32_t maximum = CORAL_COMPACT_RED_BLACK_TREE_CAPACITY_MAXIMUM;
+        if (maximum == object->capacity) {
+            coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+            return false;
+        }
+        /* grow by half, so that less of a large arena lies unused */
+        const uint32_t capacity = object->capacity < maximum / 3 * 2
+                ? object->capacity + object->capacity / 2
+                : maximum;
+        if (!$resize(object, capacity)) {
+            return false;
+        }
+    }
+    *out = object->used++;
+    return true;
+}
+
+static void $insert_repair(struct coral$compact_red_black_tree *object,
+                           uint32_t z) {
+    uint32_t p;
+    while ($is_red(object, p = $parent(object, z))) {
+        const uint32_t g = $parent(object, p);
+        const bool is_left = p == $node(object, g)->left;
+        const uint32_t u = is_left
+                ? $node(object, g)->right
+                : $node(object, g)->left;
+        if ($is_red(object, u)) {
+            /* uncle is RED, push the blackness down from grandparent */
+            $set_red(object, p, false);
+            $set_red(object, u, false);
+            $set_red(object, g, true);
+            z = g;
+            continue;
+        }
+        if (z == (is_left
+                  ? $node(object, p)->right
+                  : $node(object, p)->left)) {
+            /* straighten z, parent and grandparent into a line */
+            z = p;
+            $rotate(object, z, is_left);
+            p = $parent(object, z);
+        }
+        $set_red(object, p, false);
+        $set_red(object, g, true);
+        $rotate(object, g, !is_left);
+    }
+    $set_red(object, object->root, false);
+}
+
+/* Put v where u is, as far as the parent of u is concerned. */
+static void $transplant(struct coral$compact_red_black_tree *object,
+                        const uint32_t u, const uint32_t v) {
+    const uint32_t p = $parent(object, u);
+    if ($NIL == p) {
+        object->root = v;
+    } else if (u == $node(object, p)->left) {
+        $node(object, p)->left = v;
+    } else {
+        $node(object, p)->right = v;
+    }
+    /* may well be the sentinel, whose parent the repair relies on */
+    $set_parent(object, v, p);
+}
+
+static void $delete_repair(struct coral$compact_red_black_tree *object,
+                           uint32_t x) {
+    while (x != object->root && !$is_red(object, x)) {
+        const uint32_t p = $parent(object, x);
+        const bool is_left = x == $node(object, p)->left;
+        /* child of i on the side of x, and on the other side */
+#define $N(i)   (is_left ? $node(object, i)->left : $node(object, i)->right)
+#define $O(i)   (is_left ? $node(object, i)->right : $node(object, i)->left)
+        uint32_t w = $O(p);
+        if ($is_red(object, w)) {
+            /* sibling is RED, turn it into a BLACK one */
+            $set_red(object, w, false);
+            $set_red(object, p, true);
+            $rotate(object, p, is_left);
+            w = $O(p);
+        }
+        if (!$is_red(object, $N(w)) && !$is_red(object, $O(w))) {
+            /* both children of sibling are BLACK, move the double black up */
+            $set_red(object, w, true);
+            x = p;
+            continue;
+        }
+        if (!$is_red(object, $O(w))) {
+            /* closest child of sibling is RED, make it the farthest one */
+            $set_red(object, $N(w), false);
+            $set_red(object, w, true);
+            $rotate(object, w, !is_left);
+            w = $O(p);
+        }
+        $set_red(object, w, $is_red(object, p));
+        $set_red(object, p, false);
+        $set_red(object, $O(w), false);
+        $rotate(object, p, is_left);
+        x = object->root;
+#undef $N
+#undef $O
+    }
+    $set_red(object, x, false);
+}
+
+/* Link the middle of the nodes from first onwards under parent and recurse
+ * into either half, colouring red the nodes at depth red as the red black
+ * tree build does. */
+static uint32_t $build_N(struct coral$compact_red_black_tree *object,
+                         const uint32_t first, const uint32_t count,
+                         const uint32_t parent, const size_t depth,
+                         const size_t red) {
+    if (!count) {
+        return $NIL;
+    }
+    const uint32_t middle = first + count / 2;
+    struct coral$compact_red_black_tree$node *node = $node(object, middle);
+    node->parent = parent | (depth == red ? $RED : 0);
+    node->left = $build_N(object, first, count / 2, middle, 1 + depth, red);
+    node->right = $build_N(object, 1 + middle, count - count / 2 - 1,
+                           middle, 1 + depth, red);
+    return middle;
+}
+
+#pragma mark public
+
+bool coral$compact_red_black_tree$init(
+        struct coral$compact_red_black_tree *object,
+        const size_t size,
+        int (*compare)(const void *first, const void *second)) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!compare) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (!size) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    /* the size of a type is a multiple of its alignment, so its lowest set
+     * bit is an alignment that suits any item of that size */
+    size_t alignment = size & -size;
+    if (alignment > alignof(max_align_t)) {
+        alignment = alignof(max_align_t);
+    }
+    if (alignment < alignof(struct coral$compact_red_black_tree$node)) {
+        alignment = alignof(struct coral$compact_red_black_tree$node);
+    }
+    const size_t offset = sizeof(struct coral$compact_red_black_tree$node)
+                          + alignment - 1
+                          - (sizeof(struct coral$compact_red_black_tree$node)
+                             + alignment - 1) % alignment;
+    size_t stride;
+    if (!coral_add_size_t(size, offset + alignment - 1, &stride)) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    stride -= stride % alignment;
+    void *nodes;
+    size_t capacity;
+    if (!coral_multiply_size_t(CORAL_COMPACT_RED_BLACK_TREE_CAPACITY_MINIMUM,
+                               stride, &capacity)
+        || !coral$allocator$alloc(CORAL_ALLOCATOR_TAG_TREE_NODE,
+                                  capacity, &nodes)) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    *object = (struct coral$compact_red_black_tree) {
+            .nodes = nodes,
+            .size = size,
+            .offset = offset,
+            .stride = stride,
+            .capacity = CORAL_COMPACT_RED_BLACK_TREE_CAPACITY_MINIMUM,
+            .used = 1,
+            .root = $NIL,
+            .available = $NIL,
+            .compare = compare
+    };
+    *$node(object, $NIL) = (struct coral$compact_red_black_tree$node) {};
+    return true;
+}
+
+bool coral$compact_red_black_tree$invalidate(
+        struct coral$compact_red_black_tree *object,
+        void (*on_destroy)(void *)) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (on_destroy && object->count) {
+        for (uint32_t i = $minimum(object, object->root); $NIL != i;
+             i = $step(object, i, true)) {
+            on_destroy($item(object, i));
+        }
+    }
+    coral$allocator$free(object->nodes);
+    *object = (struct coral$compact_red_black_tree) {};
+    return true;
+}
+
+bool coral$compact_red_black_tree$get_count(
+        struct coral$compact_red_black_tree *object, size_t *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    *out = object->count;
+    return true;
+}
+
+bool coral$compact_red_black_tree$get_footprint(
+        struct coral$compact_red_black_tree *object, size_t *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    *out = (size_t) object->capacity * object->stride;
+    return true;
+}
+
+bool coral$compact_red_black_tree$set_capacity(
+        struct coral$compact_red_black_tree *object, const size_t capacity) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    /* the sentinel and deleted nodes that are yet to be reused stay put */
+    if (capacity < object->used - 1
+        || capacity >= CORAL_COMPACT_RED_BLACK_TREE_CAPACITY_MAXIMUM) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    return $resize(object, 1 + (uint32_t) capacity);
+}
+
+bool coral$compact_red_black_tree$get_item(
+        struct coral$compact_red_black_tree *object, const uint32_t node,
+        void **out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (!$is_node(object, node)) {
+        return false;
+    }
+    *out = $item(object, node);
+    return true;
+}
+
+bool coral$compact_red_black_tree$search(
+        struct coral$compact_red_black_tree *object, const void *item,
+        uint32_t *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!item || !out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    uint32_t at = $NIL;
+    for (uint32_t i = object->root; $NIL != i;) {
+        at = i;
+        const struct coral$compact_red_black_tree$node *node = $node(object, i);
+        const int result = object->compare(item, $item(object, i));
+        if (!result) {
+            *out = i;
+            return true;
+        }
+        i = result < 0 ? node->left : node->right;
+    }
+    *out = at;
+    coral_error = CORAL_ERROR_OBJECT_NOT_FOUND;
+    return false;
+}
+
+bool coral$compact_red_black_tree$insert(
+        struct coral$compact_red_black_tree *object, const void *item,
+        uint32_t *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!item) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    uint32_t p;
+    if (coral$compact_red_black_tree$search(object, item, &p)) {
+        coral_error = CORAL_ERROR_OBJECT_ALREADY_EXISTS;
+        return false;
+    }
+    uint32_t z;
+    if (!$take(object, &z)) {
+        return false;
+    }
+    *$node(object, z) = (struct coral$compact_red_black_tree$node) {
+            .parent = p | $RED
+    };
+    memcpy($item(object, z), item, object->size);
+    if ($NIL == p) {
+        object->root = z;
+    } else if (object->compare(item, $item(object, p)) < 0) {
+        $node(object, p)->left = z;
+    } else {
+        $node(object, p)->right = z;
+    }
+    $insert_repair(object, z);
+    object->count += 1;
+    if (out) {
+        *out = z;
+    }
+    return true;
+}
+
+bool coral$compact_red_black_tree$build(
+        struct coral$compact_red_black_tree *object, const void *items,
+        const size_t count) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!items) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (object->count) {
+        coral_error = CORAL_ERROR_OBJECT_UNAVAILABLE;
+        return false;
+    }
+    if (count >= CORAL_COMPACT_RED_BLACK_TREE_CAPACITY_MAXIMUM) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    const unsigned char *item = items;
+    for (size_t i = 1; i < count; i++, item += object->size) {
+        if (object->compare(item, item + object->size) >= 0) {
+            coral_error = CORAL_ERROR_INVALID_VALUE;
+            return false;
+        }
+    }
+    if (count >= object->capacity && !$resize(object, 1 + (uint32_t) count)) {
+        return false;
+    }
+    /* node i + 1 holds item i, so the nodes are in order in the arena */
+    item = items;
+    for (uint32_t i = 1; i <= count; i++, item += object->size) {
+        memcpy($item(object, i), item, object->size);
+    }
+    /* levels that are complete, the nodes below them are red */
+    size_t red = 0;
+    for (size_t i = count + 1; i > 1; i >>= 1) {
+        red += 1;
+    }
+    object->root = $build_N(object, 1, (uint32_t) count, $NIL, 0, red);
+    object->used = 1 + (uint32_t) count;
+    object->available = $NIL;
+    object->count = count;
+    return true;
+}
+
+bool coral$compact_red_black_tree$delete(
+        struct coral$compact_red_black_tree *object, const void *item) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!item) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    uint32_t z;
+    if (!coral$compact_red_black_tree$search(object, item, &z)) {
+        return false;
+    }
+    struct coral$compact_red_black_tree$node *Z = $node(object, z);
+    bool is_red = $is_red(object, z);
+    uint32_t x;
+    if ($NIL == Z->left) {
+        x = Z->right;
+        $transplant(object, z, x);
+    } else if ($NIL == Z->right) {
+        x = Z->left;
+        $transplant(object, z, x);
+    } else {
+        /* the successor of z takes its place */
+        const uint32_t y = $minimum(object, Z->right);
+        struct coral$compact_red_black_tree$node *Y = $node(object, y);
+        is_red = $is_red(object, y);
+        x = Y->right;
+        if (z == $parent(object, y)) {
+            $set_parent(object, x, y);
+        } else {
+            $transplant(object, y, x);
+            Y->right = Z->right;
+            $set_parent(object, Y->right, y);
+        }
+        $transplant(object, z, y);
+        Y->left = Z->left;
+        $set_parent(object, Y->left, y);
+        $set_red(object, y, $is_red(object, z));
+    }
+    if (!is_red) {
+        $delete_repair(object, x);
+    }
+    /* the sentinel must stay BLACK and lead nowhere */
+    *$node(object, $NIL) = (struct coral$compact_red_black_tree$node) {};
+    Z->left = object->available;
+    object->available = z;
+    object->count -= 1;
+    return true;
+}
+
+bool coral$compact_red_black_tree$get_first(
+        struct coral$compact_red_black_tree *object, uint32_t *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if ($NIL == object->root) {
+        coral_error = CORAL_ERROR_OBJECT_NOT_FOUND;
+        return false;
+    }
+    *out = $minimum(object, object->root);
+    return true;
+}
+
+bool coral$compact_red_black_tree$get_last(
+        struct coral$compact_red_black_tree *object, uint32_t *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if ($NIL == object->root) {
+        coral_error = CORAL_ERROR_OBJECT_NOT_FOUND;
+        return false;
+    }
+    *out = $maximum(object, object->root);
+    return true;
+}
+
+static bool $get_N(struct coral$compact_red_black_tree *object,
+                   const uint32_t node, uint32_t *out, const bool is_next) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (!$is_node(object, node)) {
+        return false;
+    }
+    const uint32_t next = $step(object, node, is_next);
+    if ($NIL == next) {
+        coral_error = CORAL_ERROR_END_OF_SEQUENCE;
+        return false;
+    }
+    *out = next;
+    return true;
+}
+
+bool coral$compact_red_black_tree$get_next(
+        struct coral$compact_red_black_tree *object, const uint32_t node,
+        uint32_t *out) {
+    return $get_N(object, node, out, true);
+}
+
+bool coral$compact_red_black_tree$get_prev(
+        struct coral$compact_red_black_tree *object, const uint32_t node,
+        uint32_t *out) {
+    return $get_N(object, node, out, false);
+}
@@ -3,6 +3,7 @@
 
 #include "private/context.h"
 #include "private/class.h"
+#include "private/object.h"
 
 #pragma mark private -
 
@@ -31,7 +32,7 @@ static void $on_load() {
     };
     coral_required_true(coral_class_alloc(&$class));
     coral_required_true(coral_class_init($class));
-    coral_required_true(coral_class_retain($class));
+    coral_required_true(coral$object$set_immortal($class));
     /* destroy */
     coral_required_true(coral_class_method_add(
             $class, &$method_names[0],
@@ -44,6 +45,7 @@ static void $on_load() {
     coral_required_true(coral_class_method_add(
             $class, &$method_names[2],
             (coral_invokable_t) $context_is_equal));
+    coral_required_true(coral_class_freeze($class));
 
     coral_autorelease_pool_drain();
 }
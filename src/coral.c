@@ -80,18 +80,40 @@ bool coral$atomic_compare_exchange_ptr(atomic_uintptr_t *ptr,
     return atomic_compare_exchange_strong(ptr, (uintptr_t *) &compare, val);
 }
 
+static bool $is_immortal(atomic_size_t *ref_counter) {
+    return CORAL_REF_COUNT_IMMORTAL
+           == atomic_load_explicit(ref_counter, memory_order_relaxed);
+}
+
 void coral$retain(atomic_size_t *ref_counter) {
     coral_required(ref_counter);
+    if ($is_immortal(ref_counter)) {
+        return;
+    }
     const atomic_size_t value = atomic_fetch_add(ref_counter, 1);
     const size_t ref_count = value;
     /* check if we retained a destroyed or an uninitialized instance */
     coral_required_true(0 != ref_count && SIZE_MAX != ref_count);
 }
 
+void coral$retain_many(atomic_size_t *ref_counter, const size_t count) {
+    coral_required(ref_counter);
+    if (!count || $is_immortal(ref_counter)) {
+        return;
+    }
+    const atomic_size_t value = atomic_fetch_add(ref_counter, count);
+    const size_t ref_count = value;
+    /* check if we retained a destroyed or an uninitialized instance */
+    coral_required_true(0 != ref_count && SIZE_MAX != ref_count);
+}
+
 void coral$release(void *object, atomic_size_t *ref_counter,
                    void(*on_destroy)(void *object)) {
     coral_required(object);
     coral_required(ref_counter);
+    if ($is_immortal(ref_counter)) {
+        return;
+    }
     if (coral$atomic_compare_exchange(ref_counter, 1, 0)) {
         if (on_destroy) {
             on_destroy(object);
@@ -107,6 +129,24 @@ void coral$release(void *object, atomic_size_t *ref_counter,
     coral_required_true(0 != ref_count && SIZE_MAX != ref_count);
 }
 
+void coral$release_many(void *object, atomic_size_t *ref_counter,
+                        const size_t count,
+                        void(*on_destroy)(void *object)) {
+    coral_required(object);
+    coral_required(ref_counter);
+    if (!count || !coral$atomic_load(ref_counter)
+        || $is_immortal(ref_counter)) {
+        return;
+    }
+    const atomic_size_t value = atomic_fetch_sub(ref_counter, count);
+    const size_t ref_count = value;
+    /* if we released more references than there were */
+    coral_required_true(count <= ref_count && SIZE_MAX != ref_count);
+    if (count == ref_count && on_destroy) {
+        on_destroy(object);
+    }
+}
+
 #pragma mark public
 
 void coral_required(const void *obj) {
@@ -0,0 +1,69 @@
+#include <string.h>
+#include <coral.h>
+
+#include "private/class.h"
+#include "private/inline_cache.h"
+#include "test/cmocka.h"
+
+#pragma mark private -
+
+bool coral$inline_cache$get(struct coral_inline_cache *object,
+                            struct coral_class *class,
+                            coral_invokable_t *out) {
+    coral_required(object);
+    coral_required(class);
+    coral_required(out);
+    /* the class pointer alone could be a new class at a reused address */
+    const size_t generation = coral$class$get_generation(class);
+    for (size_t i = 0; generation && i < object->count; i++) {
+        if (object->entries[i].class == class
+            && object->entries[i].generation == generation) {
+            object->hits += 1;
+            *out = object->entries[i].invokable;
+            return true;
+        }
+    }
+    object->misses += 1;
+    coral_invokable_t invokable;
+    if (!coral_class_method_get_selector(class, object->selector,
+                                         &invokable)) {
+        return false;
+    }
+    if (generation) {
+        size_t i;
+        if (object->count < object->capacity) {
+            i = object->count++;
+        } else {
+            i = object->next;
+            object->next = (1 + i) % object->capacity;
+        }
+        object->entries[i].class = class;
+        object->entries[i].generation = generation;
+        object->entries[i].invokable = invokable;
+    }
+    *out = invokable;
+    return true;
+}
+
+#pragma mark public -
+
+bool coral_inline_cache_init(struct coral_inline_cache *object,
+                             const struct coral_selector *selector,
+                             const size_t capacity) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!selector) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (!capacity || capacity > CORAL_INLINE_CACHE_MAXIMUM_ENTRIES) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    memset(object, 0, sizeof(*object));
+    object->selector = selector;
+    object->capacity = capacity;
+    return true;
+}
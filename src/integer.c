@@ -3,6 +3,7 @@
 
 #include "private/integer.h"
 #include "private/class.h"
+#include "private/object.h"
 #include "test/cmocka.h"
 
 #pragma mark private -
@@ -34,7 +35,7 @@ static void $on_load() {
     };
     coral_required_true(coral_class_alloc(&$class));
     coral_required_true(coral_class_init($class));
-    coral_required_true(coral_class_retain($class));
+    coral_required_true(coral$object$set_immortal($class));
     /* destroy */
     coral_required_true(coral_class_method_add(
             $class, &$method_names[0],
@@ -47,9 +48,8 @@ static void $on_load() {
     coral_required_true(coral_class_method_add(
             $class, &$method_names[2],
             (coral_invokable_t) $integer_is_equal));
-    /* copy */
-
-
+    /* the methods never change from here on */
+    coral_required_true(coral_class_freeze($class));
     coral_autorelease_pool_drain();
 }
 
@@ -435,7 +435,7 @@ static bool $integer_is_equal(void *this,
         }
     }
     int result;
-    struct coral_integer *other = args->other;
+    struct coral_integer *other = coral$object$get_data(args->other);
     if (!coral$integer$compare(&data->integer,
                                &other->integer,
                                &result)) {
@@ -6,6 +6,7 @@
 #include "private/coral.h"
 #include "private/lock.h"
 #include "private/class.h"
+#include "private/object.h"
 #include "test/cmocka.h"
 
 #pragma mark private -
@@ -26,10 +27,6 @@ static bool $lock_is_equal(void *this,
                            struct coral_lock *data,
                            struct is_equal_args *args);
 
-static bool $lock_copy(void *this,
-                       void *data,
-                       void *args);
-
 __attribute__((constructor(CORAL_CLASS_LOAD_PRIORITY_LOCK)))
 static void $on_load() {
     struct coral_class_method_name $method_names[] = {
@@ -40,7 +37,7 @@ static void $on_load() {
     };
     coral_required_true(coral_class_alloc(&$class));
     coral_required_true(coral_class_init($class));
-    coral_required_true(coral_class_retain($class));
+    coral_required_true(coral$object$set_immortal($class));
     /* destroy */
     coral_required_true(coral_class_method_add(
             $class, &$method_names[0],
@@ -56,7 +53,8 @@ static void $on_load() {
     /* copy */
     coral_required_true(coral_class_method_add(
             $class, &$method_names[3],
-            (coral_invokable_t) $lock_copy));
+            (coral_invokable_t) coral$object$copy_is_unavailable));
+    coral_required_true(coral_class_freeze($class));
 
     coral_autorelease_pool_drain();
 }
@@ -190,13 +188,6 @@ static bool $lock_is_equal(void *this,
     return coral_object_is_equal(this, args->other, args->out);
 }
 
-static bool $lock_copy(void *this,
-                       void *data,
-                       void *args) {
-    coral_error = CORAL_ERROR_OBJECT_UNAVAILABLE;
-    return false; /* copying is not allowed */
-}
-
 static bool $lock_lock(void *this,
                        struct coral_lock *data,
                        void *args) {
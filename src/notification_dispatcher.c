@@ -0,0 +1,281 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <coral.h>
+
+#include "private/allocator.h"
+#include "private/coral.h"
+#include "private/object.h"
+#include "private/slab.h"
+#include "private/notification_dispatcher.h"
+#include "test/cmocka.h"
+
+#pragma mark private -
+
+/* Microseconds that a worker that had to wait lets notifications accumulate
+ * for before it takes the batch */
+#define $BATCH_WINDOW 100
+
+struct $entry {
+    struct $entry *next;
+    void *object;
+    const char *notification;
+};
+
+/* Notifications already delivered in the current batch */
+struct $delivered {
+    struct $entry **items;
+    size_t capacity;
+};
+
+static atomic_uintptr_t $head;
+static atomic_bool $is_running;
+static atomic_size_t $producers;
+static atomic_size_t $waiting;
+static pthread_mutex_t $mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t $condition = PTHREAD_COND_INITIALIZER;
+static bool $is_stopping;
+static pthread_t *$workers;
+static size_t $worker_count;
+static atomic_size_t $posted;
+static atomic_size_t $delivered;
+static atomic_size_t $coalesced;
+static atomic_size_t $batches;
+
+static void $wake_worker() {
+    /* pairs with the increment in $worker, either we see the waiting worker
+     * or it sees the entry that we have just pushed */
+    if (!atomic_load(&$waiting)) {
+        return;
+    }
+    coral_required_true(!pthread_mutex_lock(&$mutex));
+    coral_required_true(!pthread_cond_signal(&$condition));
+    coral_required_true(!pthread_mutex_unlock(&$mutex));
+}
+
+static size_t $hash(const struct $entry *entry) {
+    coral_required(entry);
+    const uintptr_t hash = (uintptr_t) entry->object
+                           ^ ((uintptr_t) entry->notification >> 4);
+    return (size_t) (hash ^ (hash >> 17)) * (size_t) 0x9e3779b97f4a7c15ULL;
+}
+
+/* Remember entry as delivered, returns false if it already was */
+static bool $delivered_add(struct $delivered *delivered,
+                           struct $entry *entry) {
+    coral_required(delivered);
+    coral_required(entry);
+    const size_t mask = delivered->capacity - 1;
+    for (size_t i = $hash(entry) & mask;; i = (i + 1) & mask) {
+        struct $entry *item = delivered->items[i];
+        if (!item) {
+            delivered->items[i] = entry;
+            return true;
+        }
+        if (item->object == entry->object
+            && (item->notification == entry->notification
+                || !strcmp(item->notification, entry->notification))) {
+            return false;
+        }
+    }
+}
+
+static bool $delivered_reset(struct $delivered *delivered,
+                             const size_t count) {
+    coral_required(delivered);
+    size_t capacity = 16;
+    while (capacity < 2 * count) {
+        capacity <<= 1;
+    }
+    if (capacity > delivered->capacity) {
+        struct $entry **items;
+        if (!coral$allocator$realloc(CORAL_ALLOCATOR_TAG_OTHER,
+                                     delivered->items,
+                                     capacity * sizeof(*items),
+                                     (void **) &items)) {
+            coral_error = CORAL_ERROR_NONE;
+            return false;
+        }
+        delivered->items = items;
+        delivered->capacity = capacity;
+    }
+    memset(delivered->items, 0,
+           delivered->capacity * sizeof(*delivered->items));
+    return true;
+}
+
+static void $deliver(struct $entry *entries, struct $delivered *delivered) {
+    coral_required(delivered);
+    /* the queue is a stack, reverse it to deliver in posted order */
+    struct $entry *batch = NULL;
+    size_t count = 0;
+    while (entries) {
+        struct $entry *next = entries->next;
+        entries->next = batch;
+        batch = entries;
+        entries = next;
+        count += 1;
+    }
+    /* without memory to coalesce we still deliver every notification */
+    const bool coalesce = $delivered_reset(delivered, count);
+    size_t delivered_count = 0;
+    while (batch) {
+        struct $entry *next = batch->next;
+        if (!coalesce || $delivered_add(delivered, batch)) {
+            coral$object$notify(batch->object, batch->notification);
+            delivered_count += 1;
+        }
+        coral_required_true(coral_object_release(batch->object));
+        /* the entry must stay valid while it is in the delivered set */
+        batch->next = entries;
+        entries = batch;
+        batch = next;
+    }
+    while (entries) {
+        struct $entry *next = entries->next;
+        coral$slab$free(entries);
+        entries = next;
+    }
+    atomic_fetch_add_explicit(&$delivered, delivered_count,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&$coalesced, count - delivered_count,
+                              memory_order_relaxed);
+    atomic_fetch_add_explicit(&$batches, 1, memory_order_relaxed);
+    coral_autorelease_pool_drain();
+}
+
+static void *$worker(void *arg) {
+    struct $delivered delivered = {};
+    for (;;) {
+        struct $entry *entries = (struct $entry *) atomic_exchange_explicit(
+                &$head, 0, memory_order_acquire);
+        if (entries) {
+            if (atomic_load_explicit(&$head, memory_order_relaxed)) {
+                /* share the work that arrived in the meantime */
+                $wake_worker();
+            }
+            $deliver(entries, &delivered);
+            continue;
+        }
+        coral_required_true(!pthread_mutex_lock(&$mutex));
+        atomic_fetch_add(&$waiting, 1);
+        while (!atomic_load(&$head) && !$is_stopping) {
+            coral_required_true(!pthread_cond_wait(&$condition, &$mutex));
+        }
+        atomic_fetch_sub(&$waiting, 1);
+        const bool stop = $is_stopping && !atomic_load(&$head);
+        const bool is_stopping = $is_stopping;
+        coral_required_true(!pthread_mutex_unlock(&$mutex));
+        if (stop) {
+            break;
+        }
+        if (!is_stopping) {
+            usleep($BATCH_WINDOW);
+        }
+    }
+    coral$allocator$free(delivered.items);
+    return NULL;
+}
+
+static void $join_workers(const size_t count) {
+    coral_required_true(!pthread_mutex_lock(&$mutex));
+    $is_stopping = true;
+    coral_required_true(!pthread_cond_broadcast(&$condition));
+    coral_required_true(!pthread_mutex_unlock(&$mutex));
+    for (size_t i = 0; i < count; i++) {
+        coral_required_true(!pthread_join($workers[i], NULL));
+    }
+    coral$allocator$free($workers);
+    $workers = NULL;
+    $worker_count = 0;
+}
+
+bool coral$notification_dispatcher$post(void *object,
+                                        const char *notification) {
+    coral_required(object);
+    coral_required(notification);
+    atomic_fetch_add(&$producers, 1);
+    bool result = false;
+    struct $entry *entry;
+    if (atomic_load(&$is_running)
+        && coral$slab$alloc(sizeof(*entry), (void **) &entry)) {
+        if (!coral_object_retain(object)) {
+            coral$slab$free(entry);
+        } else {
+            entry->object = object;
+            entry->notification = notification;
+            uintptr_t head = atomic_load_explicit(&$head,
+                                                  memory_order_relaxed);
+            do {
+                entry->next = (struct $entry *) head;
+            } while (!atomic_compare_exchange_weak_explicit(
+                    &$head, &head, (uintptr_t) entry,
+                    memory_order_seq_cst, memory_order_relaxed));
+            atomic_fetch_add_explicit(&$posted, 1, memory_order_relaxed);
+            if (!head) {
+                $wake_worker();
+            }
+            result = true;
+        }
+    }
+    atomic_fetch_sub(&$producers, 1);
+    return result;
+}
+
+#pragma mark public -
+
+bool coral_notification_dispatcher_start(const size_t workers) {
+    if (!workers) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    if ($workers) {
+        coral_error = CORAL_ERROR_OBJECT_ALREADY_EXISTS;
+        return false;
+    }
+    if (!coral$allocator$calloc(CORAL_ALLOCATOR_TAG_OTHER,
+                                workers, sizeof(pthread_t),
+                                (void **) &$workers)) {
+        return false;
+    }
+    $is_stopping = false;
+    for (size_t i = 0; i < workers; i++) {
+        if (pthread_create(&$workers[i], NULL, $worker, NULL)) {
+            $join_workers(i);
+            coral_error = CORAL_ERROR_SYSCALL_FAILED;
+            return false;
+        }
+    }
+    $worker_count = workers;
+    atomic_store(&$is_running, true);
+    return true;
+}
+
+bool coral_notification_dispatcher_stop() {
+    if (!$workers) {
+        coral_error = CORAL_ERROR_OBJECT_UNAVAILABLE;
+        return false;
+    }
+    atomic_store(&$is_running, false);
+    /* wait for the posts that saw us running to have been queued */
+    for (uint8_t state = 0;
+         atomic_load(&$producers);
+         coral_exponential_usleep(&state, MAXIMUM_USLEEP));
+    $join_workers($worker_count);
+    return true;
+}
+
+bool coral_notification_dispatcher_get_statistics(
+        struct coral_notification_dispatcher_statistics *out) {
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    out->posted = atomic_load_explicit(&$posted, memory_order_relaxed);
+    out->delivered = atomic_load_explicit(&$delivered, memory_order_relaxed);
+    out->coalesced = atomic_load_explicit(&$coalesced, memory_order_relaxed);
+    out->batches = atomic_load_explicit(&$batches, memory_order_relaxed);
+    return true;
+}
@@ -1,13 +1,19 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <threads.h>
 #include <coral.h>
 
+#include "private/allocator.h"
 #include "private/autorelease_pool.h"
 #include "private/coral.h"
 #include "private/object.h"
 #include "private/class.h"
+#include "private/inline_cache.h"
+#include "private/notification_dispatcher.h"
 #include "private/rwlock.h"
+#include "private/selector.h"
+#include "private/slab.h"
 #include "test/cmocka.h"
 
 #pragma mark private -
@@ -16,6 +22,10 @@ static bool $is_object(struct coral_object *object);
 
 static struct coral_class *$class;
 
+static thread_local char $thread;
+/* depth of the autorelease pool of the innermost invocation */
+static thread_local size_t $invoke_depth = 0;
+
 #pragma mark + dispatch methods
 
 const char *destroy = "destroy";
@@ -41,7 +51,7 @@ static void $on_load() {
     };
     coral_required_true(coral_class_alloc(&$class));
     coral_required_true(coral_class_init($class));
-    coral_required_true(coral_class_retain($class));
+    coral_required_true(coral$object$set_immortal($class));
     /* hash_code */
     coral_required_true(coral_class_method_add(
             $class, &$method_names[0],
@@ -50,6 +60,7 @@ static void $on_load() {
     coral_required_true(coral_class_method_add(
             $class, &$method_names[1],
             (coral_invokable_t) $object_is_equal));
+    coral_required_true(coral_class_freeze($class));
 
     coral_autorelease_pool_drain();
 }
@@ -60,14 +71,65 @@ static void $on_unload() {
     coral_autorelease_pool_drain();
 }
 
+/* copy_of holds the object whose payload we are using, tagged with how */
+#define $COPY_OF_ALIAS      ((uintptr_t) 1)
+#define $COPY_OF_DETACHED   ((uintptr_t) 2)
+#define $COPY_OF_TAGS       ($COPY_OF_ALIAS | $COPY_OF_DETACHED)
+
+/* Set in the extension pointer while the object has observers */
+#define $EXTENSION_IS_OBSERVED  ((uintptr_t) 1)
+/* Set in the extension pointer while the object has no extension yet, the
+ * rest of it then counts the invokes that are reading the object */
+#define $EXTENSION_IS_READ      ((uintptr_t) 2)
+#define $EXTENSION_READER       ((uintptr_t) 4)
+
+/* Set in the size of objects that do not come from the slabs */
+#define $OBJECT_IS_ALLOCATED    ((uint32_t) 1 << 31)
+
+struct $observer {
+    void *observer;
+    const char *event;
+    void (*on_event)(void *observer, void *object, const char *event);
+};
+
+/* Observer lists are never changed once published, a new list replaces the
+ * current one and the old one is retired until no post may still read it */
+struct $observers {
+    struct $observers *retired;
+    size_t count;
+    struct $observer items[];
+};
+
+/* State of objects that are copied or observed, allocated on first use */
+struct $object_extras {
+    atomic_flag sharers_lock;
+    void *sharers;
+    void *prev_sharer;
+    void *next_sharer;
+    atomic_flag observers_lock;
+    atomic_uintptr_t observers;
+    atomic_size_t posting;
+    struct $observers *retired;
+};
+
+/* State that objects which are only ever read never need, allocated on their
+ * first write, copy or observer */
+struct $object_extension {
+    struct coral$rwlock lock;
+    uintptr_t owner;
+    atomic_size_t depth; /* of invokes under way without the lock */
+    atomic_uint writing; /* of those that write */
+    atomic_bool is_shared;
+    atomic_uintptr_t copy_of;
+    atomic_uintptr_t extras;
+};
+
 struct coral_object {
     struct coral_class *class;
     atomic_size_t ref_count;
-    void *copy_of; // TODO: atomic variable ...
-    struct coral$rwlock lock;
-    size_t size;
-    size_t checksum;
-    // FIXME: Implement observer pattern for events ...
+    atomic_uintptr_t extension;
+    uint32_t size;
+    uint32_t checksum;
 };
 
 struct coral_object *coral$object_from(void *object) {
@@ -117,38 +179,333 @@ bool coral$object$get_ref_count(struct coral_object *object, size_t *out) {
     return true;
 }
 
+bool coral$object$set_immortal(void *object) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    struct coral_object *object_ = coral$object_from(object);
+    if (!coral$atomic_load(&object_->ref_count) || !$is_object(object_)) {
+        coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
+        return false;
+    }
+    coral$atomic_store(&object_->ref_count, CORAL_REF_COUNT_IMMORTAL);
+    return true;
+}
+
+static struct $object_extension *
+$object_get_extension(struct coral_object *object) {
+    coral_required(object);
+    const uintptr_t extension = atomic_load_explicit(&object->extension,
+                                                     memory_order_acquire);
+    if (extension & $EXTENSION_IS_READ) {
+        return NULL;
+    }
+    return (struct $object_extension *) (extension & ~$EXTENSION_IS_OBSERVED);
+}
+
+/* The extension takes over the readers that are under way when it is
+ * installed, they do not hold its lock, so the object is shared and has no
+ * owner from the start. */
+static struct $object_extension *
+$object_extension(struct coral_object *object) {
+    coral_required(object);
+    struct $object_extension *extension = $object_get_extension(object);
+    if (extension) {
+        return extension;
+    }
+    if (!coral$slab$alloc(sizeof(*extension), (void **) &extension)) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return NULL;
+    }
+    if (!coral$rwlock$init(&extension->lock)) {
+        coral$slab$free(extension);
+        return NULL;
+    }
+    uintptr_t expected = atomic_load_explicit(&object->extension,
+                                              memory_order_acquire);
+    do {
+        if (expected && !(expected & $EXTENSION_IS_READ)) {
+            /* another thread has installed its extension before us */
+            coral_required_true(coral$rwlock$invalidate(&extension->lock));
+            coral$slab$free(extension);
+            return (struct $object_extension *)
+                    (expected & ~$EXTENSION_IS_OBSERVED);
+        }
+        const size_t readers = expected / $EXTENSION_READER;
+        extension->owner = readers ? 0 : (uintptr_t) &$thread;
+        atomic_store_explicit(&extension->is_shared, 0 != readers,
+                              memory_order_relaxed);
+        atomic_store_explicit(&extension->depth, readers,
+                              memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(&object->extension,
+                                                    &expected,
+                                                    (uintptr_t) extension,
+                                                    memory_order_acq_rel,
+                                                    memory_order_acquire));
+    return extension;
+}
+
+static struct $object_extras *
+$object_get_extras(struct $object_extension *extension) {
+    coral_required(extension);
+    return (struct $object_extras *) atomic_load_explicit(
+            &extension->extras, memory_order_acquire);
+}
+
+static struct $object_extras *
+$object_extras(struct $object_extension *extension) {
+    coral_required(extension);
+    struct $object_extras *extras = $object_get_extras(extension);
+    if (extras) {
+        return extras;
+    }
+    if (!coral$slab$alloc(sizeof(*extras), (void **) &extras)) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return NULL;
+    }
+    uintptr_t expected = 0;
+    if (!atomic_compare_exchange_strong_explicit(&extension->extras,
+                                                 &expected,
+                                                 (uintptr_t) extras,
+                                                 memory_order_acq_rel,
+                                                 memory_order_acquire)) {
+        /* another thread has installed its extras before us */
+        coral$slab$free(extras);
+        extras = (struct $object_extras *) expected;
+    }
+    return extras;
+}
+
+/* Objects without an extension are read without taking a lock, the readers
+ * count themselves in the extension pointer instead so that whoever installs
+ * the extension knows to wait for them. Returns false if the object already
+ * has an extension, whose lock must be taken instead. */
+static bool $object_read_begin(struct coral_object *object) {
+    coral_required(object);
+    uintptr_t extension = atomic_load_explicit(&object->extension,
+                                               memory_order_acquire);
+    do {
+        if (extension && !(extension & $EXTENSION_IS_READ)) {
+            return false;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(
+            &object->extension, &extension,
+            (extension | $EXTENSION_IS_READ) + $EXTENSION_READER,
+            memory_order_acquire, memory_order_acquire));
+    return true;
+}
+
+static void $object_read_end(struct coral_object *object) {
+    coral_required(object);
+    uintptr_t extension = atomic_load_explicit(&object->extension,
+                                               memory_order_acquire);
+    do {
+        if (!(extension & $EXTENSION_IS_READ)) {
+            /* an extension was installed while we were reading */
+            struct $object_extension *extension_ = (struct $object_extension *)
+                    (extension & ~$EXTENSION_IS_OBSERVED);
+            atomic_fetch_sub_explicit(&extension_->depth, 1,
+                                      memory_order_release);
+            return;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(
+            &object->extension, &extension, extension - $EXTENSION_READER,
+            memory_order_release, memory_order_acquire));
+}
+
+/* An object is owned by the thread that installs its extension, which in
+ * practice is the thread that created it and first wrote to it. The owner
+ * invokes it without taking the lock until any other thread touches it, from
+ * then on the object is shared and every invoke takes the lock. The owner
+ * announces itself through depth, and writing if it writes, and then checks
+ * is_shared, while another thread sets is_shared and then waits for the
+ * owner, so that one of them always sees the other. Other threads that read
+ * only wait for the owner's writes, as the owner may be blocked in a read,
+ * such as awaiting a lock condition, until one of them signals it. */
+static bool $object_lock(struct $object_extension *extension,
+                         const bool readonly) {
+    coral_required(extension);
+    if (extension->owner == (uintptr_t) &$thread) {
+        if (!atomic_load_explicit(&extension->is_shared,
+                                  memory_order_relaxed)) {
+            const size_t depth = atomic_load_explicit(&extension->depth,
+                                                      memory_order_relaxed);
+            const unsigned int writing = atomic_load_explicit(
+                    &extension->writing, memory_order_relaxed);
+            atomic_store(&extension->depth, 1 + depth);
+            if (!readonly) {
+                atomic_store(&extension->writing, 1 + writing);
+            }
+            if (!atomic_load(&extension->is_shared)) {
+                return true;
+            }
+            if (!readonly) {
+                atomic_store_explicit(&extension->writing, writing,
+                                      memory_order_release);
+            }
+            atomic_store_explicit(&extension->depth, depth,
+                                  memory_order_release);
+        }
+        /* we must not wait on the invokes that we ourselves have started */
+    } else {
+        if (!atomic_load_explicit(&extension->is_shared,
+                                  memory_order_acquire)) {
+            atomic_store(&extension->is_shared, true);
+        }
+        for (uint8_t state = 0;
+             readonly
+             ? atomic_load(&extension->writing)
+             : atomic_load(&extension->depth);
+             coral_exponential_usleep(&state, MAXIMUM_USLEEP));
+    }
+    coral_required_true(readonly
+        ? coral$rwlock$read_lock(&extension->lock)
+        : coral$rwlock$write_lock(&extension->lock));
+    return false;
+}
+
+static void $object_unlock(struct $object_extension *extension,
+                           const bool readonly,
+                           const bool is_owned) {
+    coral_required(extension);
+    if (is_owned) {
+        if (!readonly) {
+            const unsigned int writing = atomic_load_explicit(
+                    &extension->writing, memory_order_relaxed);
+            atomic_store_explicit(&extension->writing, writing - 1,
+                                  memory_order_release);
+        }
+        const size_t depth = atomic_load_explicit(&extension->depth,
+                                                  memory_order_relaxed);
+        atomic_store_explicit(&extension->depth, depth - 1,
+                              memory_order_release);
+    } else {
+        coral_required_true(coral$rwlock$unlock(&extension->lock));
+    }
+}
+
+/* Copies are never made of copies that still share their payload, instead they
+ * share the payload of the same source, so one hop always suffices. */
 static struct coral_object *coral$object_resolve(struct coral_object *object) {
     coral_required(object);
-    while (object->copy_of) {
-        object = coral$object_from(object->copy_of);
+    struct $object_extension *extension = $object_get_extension(object);
+    if (!extension) {
+        return object;
     }
-    return object;
+    const uintptr_t copy_of = atomic_load_explicit(&extension->copy_of,
+                                                   memory_order_acquire);
+    if (!copy_of || (copy_of & $COPY_OF_DETACHED)) {
+        return object;
+    }
+    return coral$object_from((void *) (copy_of & ~$COPY_OF_TAGS));
+}
+
+static void $sharers_lock(struct $object_extras *extras) {
+    coral_required(extras);
+    while (atomic_flag_test_and_set_explicit(&extras->sharers_lock,
+                                             memory_order_acquire));
+}
+
+static void $sharers_unlock(struct $object_extras *extras) {
+    coral_required(extras);
+    atomic_flag_clear_explicit(&extras->sharers_lock, memory_order_release);
+}
+
+/* Sharers of a payload are linked through their extras, which are allocated
+ * before the sharer is added. */
+static struct $object_extras *$sharer_extras(void *sharer) {
+    coral_required(sharer);
+    struct $object_extension *extension = $object_get_extension(
+            coral$object_from(sharer));
+    coral_required(extension);
+    struct $object_extras *extras = $object_get_extras(extension);
+    coral_required(extras);
+    return extras;
+}
+
+static void $sharers_add(struct $object_extras *extras, void *sharer) {
+    coral_required(extras);
+    coral_required(sharer);
+    struct $object_extras *sharer_ = $sharer_extras(sharer);
+    $sharers_lock(extras);
+    sharer_->prev_sharer = NULL;
+    sharer_->next_sharer = extras->sharers;
+    if (extras->sharers) {
+        $sharer_extras(extras->sharers)->prev_sharer = sharer;
+    }
+    extras->sharers = sharer;
+    $sharers_unlock(extras);
+}
+
+static void $sharers_remove(struct $object_extras *extras, void *sharer) {
+    coral_required(extras);
+    coral_required(sharer);
+    struct $object_extras *sharer_ = $sharer_extras(sharer);
+    $sharers_lock(extras);
+    if (sharer_->prev_sharer) {
+        $sharer_extras(sharer_->prev_sharer)->next_sharer
+                = sharer_->next_sharer;
+    } else {
+        coral_required_true(extras->sharers == sharer);
+        extras->sharers = sharer_->next_sharer;
+    }
+    if (sharer_->next_sharer) {
+        $sharer_extras(sharer_->next_sharer)->prev_sharer
+                = sharer_->prev_sharer;
+    }
+    sharer_->prev_sharer = sharer_->next_sharer = NULL;
+    $sharers_unlock(extras);
+}
+
+static uint32_t $object_checksum(struct coral_object *object) {
+    coral_required(object);
+    const uint64_t checksum = (uintptr_t) object
+                              ^ (uintptr_t) object->class
+                              ^ object->size;
+    return (uint32_t) (checksum ^ (checksum >> 32));
 }
 
 static bool $object_alloc(const size_t size, void **out) {
     coral_required(out);
     size_t size_;
     struct coral_object *object;
-    if (!coral_add_size_t(sizeof(*object), size, &size_)) {
+    if (!coral_add_size_t(sizeof(*object), size, &size_)
+        || size >= $OBJECT_IS_ALLOCATED) {
         coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
         return false;
     }
-    object = calloc(1, size_);
-    if (!object) {
-        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+    uint32_t flags = 0;
+    /* small objects come from the slabs unless another allocator is in use */
+    if (coral$slab$is_eligible(size_) && coral$allocator$is_default()) {
+        if (!coral$slab$alloc(size_, (void **) &object)) {
+            return false;
+        }
+    } else if (coral$allocator$calloc(CORAL_ALLOCATOR_TAG_OBJECT, 1, size_,
+                                      (void **) &object)) {
+        flags = $OBJECT_IS_ALLOCATED;
+    } else {
         return false;
     }
-    object->size = size;
+    object->size = (uint32_t) size | flags;
     *out = coral$object_to(object);
     return true;
 }
 
+static void $object_free(struct coral_object *object) {
+    coral_required(object);
+    if (object->size & $OBJECT_IS_ALLOCATED) {
+        coral$allocator$free(object);
+    } else {
+        coral$slab$free(object);
+    }
+}
+
 static bool $object_init(void *object, struct coral_class *class) {
     coral_required(object);
     struct coral_object *object_ = coral$object_from(object);
     if (object_->class
         || object_->checksum
-        || !coral$rwlock$init(&object_->lock)
         || !coral$atomic_compare_exchange(&object_->ref_count, 0, 1)) {
         coral_error = CORAL_ERROR_INITIALIZATION_FAILED;
         return false;
@@ -159,18 +516,14 @@ static bool $object_init(void *object, struct coral_class *class) {
     object_->class = coral$object_to(
             coral$object_resolve(
                     coral$object_from(class)));
-    object_->checksum = (size_t) object_
-                        ^ (size_t) object_->class
-                        ^ (size_t) object_->size;
+    object_->checksum = $object_checksum(object_);
     coral$autorelease_pool$add(object);
     return true;
 }
 
 static bool $is_object(struct coral_object *object) {
     coral_required(object);
-    return ((size_t) object
-            ^ (size_t) object->class
-            ^ (size_t) object->size) == object->checksum;
+    return $object_checksum(object) == object->checksum;
 }
 
 static bool $object_retain(void *this, void *data, void *args) {
@@ -194,10 +547,17 @@ static bool $object_release(void *this, void *data, void *args) {
 static bool $object_autorelease(void *this, void *data, void *args) {
     coral_required(this);
     const bool result = $object_retain(this, NULL, NULL);
-    if (result) {
+    if (!result) {
+        return false;
+    }
+    /* an invokable hands the objects it autoreleases to its caller, anyone
+     * else keeps them in their current pool */
+    if ($invoke_depth && $invoke_depth == coral$autorelease_pool$get_depth()) {
         coral$autorelease_pool$add_previous(this);
+    } else {
+        coral$autorelease_pool$add(this);
     }
-    return result;
+    return true;
 }
 
 static bool
@@ -228,12 +588,27 @@ $object_get_dispatch(void *object, const char *method, coral_invokable_t *out) {
         coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
         return false;
     }
-    struct coral_class *class = object_->class;
-    struct coral_class_method_name name = {
-            .data = method,
-            .size = strlen(method)
-    };
-    return coral_class_method_get(class, &name, out);
+    const struct coral_selector *selector;
+    if (!coral$selector$find(method, strlen(method), &selector)) {
+        /* a name that was never registered is not a method of any class */
+        coral_error = CORAL_ERROR_METHOD_NOT_FOUND;
+        return false;
+    }
+    return coral_class_method_get_selector(object_->class, selector, out);
+}
+
+static bool $object_get_dispatch_selector(void *object,
+                                          const struct coral_selector *selector,
+                                          coral_invokable_t *out) {
+    coral_required(object);
+    coral_required(selector);
+    coral_required(out);
+    struct coral_object *object_ = coral$object_from(object);
+    if (!$is_object(object_)) { /* checksum failed */
+        coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
+        return false;
+    }
+    return coral_class_method_get_selector(object_->class, selector, out);
 }
 
 static bool $object_is_initialized(struct coral_object *object) {
@@ -243,28 +618,368 @@ static bool $object_is_initialized(struct coral_object *object) {
            && $is_object(object); /* checksum succeeded */
 }
 
-void
-coral$object_add_observer(struct coral_object *object,
-                          void *observer, const char *event,
-                          void(*on_event)(void *object, const char *event)) {
+static bool $object_copy_into(void *object, void *src) {
+    coral_required(object);
+    coral_required(src);
+    coral_invokable_t copy_func;
+    coral_required_true($object_get_dispatch(object, copy, &copy_func));
+    struct copy_args args = {
+            .src = src
+    };
+    return copy_func(object, object, &args);
+}
+
+/* Give the copy a payload of its own before it is written to, the caller must
+ * hold the copy's write lock. */
+static bool $object_materialize(void *object,
+                                struct $object_extension *extension) {
+    coral_required(object);
+    coral_required(extension);
+    uintptr_t copy_of = atomic_load_explicit(&extension->copy_of,
+                                             memory_order_acquire);
+    void *source = (void *) (copy_of & ~$COPY_OF_TAGS);
+    coral_required(source);
+    if (!(copy_of & $COPY_OF_DETACHED)) {
+        struct $object_extension *source_ = $object_get_extension(
+                coral$object_from(source));
+        coral_required(source_);
+        const bool is_owned = $object_lock(source_, true);
+        /* source may have detached us while we were waiting for its lock */
+        copy_of = atomic_load_explicit(&extension->copy_of,
+                                       memory_order_acquire);
+        if (!(copy_of & $COPY_OF_DETACHED)) {
+            if (!$object_copy_into(object, source)) {
+                $object_unlock(source_, true, is_owned);
+                return false;
+            }
+            $sharers_remove($object_get_extras(source_), object);
+        }
+        $object_unlock(source_, true, is_owned);
+    }
+    atomic_store_explicit(&extension->copy_of, 0, memory_order_release);
+    coral_required_true($object_release(source, NULL, NULL));
+    return true;
+}
+
+/* Give every copy that still shares our payload one of its own before we
+ * change it, the caller must hold our write lock. Detached copies keep their
+ * reference to us until they next take their own write lock, as one of their
+ * readers may be waiting on our lock. */
+static bool $object_detach_sharers(void *object,
+                                   struct $object_extras *extras) {
+    coral_required(object);
+    coral_required(extras);
+    void *sharer;
+    while ((sharer = extras->sharers)) {
+        if (!$object_copy_into(sharer, object)) {
+            return false;
+        }
+        $sharers_remove(extras, sharer);
+        struct $object_extension *sharer_ = $object_get_extension(
+                coral$object_from(sharer));
+        atomic_store_explicit(&sharer_->copy_of,
+                              (uintptr_t) object | $COPY_OF_DETACHED,
+                              memory_order_release);
+    }
+    return true;
+}
+
+static bool $object_invoke(void *object,
+                           struct $object_extension *extension,
+                           const bool readonly,
+                           coral_invokable_t function,
+                           void *args) {
+    coral_required(object);
+    coral_required(extension);
+    coral_required(function);
+    uintptr_t copy_of = atomic_load_explicit(&extension->copy_of,
+                                             memory_order_acquire);
+    if (copy_of && !readonly && !(copy_of & $COPY_OF_ALIAS)) {
+        if (!$object_materialize(object, extension)) {
+            return false;
+        }
+        copy_of = 0;
+    }
+    if (copy_of && !(copy_of & $COPY_OF_DETACHED)) {
+        void *source = (void *) (copy_of & ~$COPY_OF_TAGS);
+        struct $object_extension *source_ = $object_get_extension(
+                coral$object_from(source));
+        coral_required(source_);
+        const bool is_owned = $object_lock(source_, readonly);
+        copy_of = atomic_load_explicit(&extension->copy_of,
+                                       memory_order_acquire);
+        const bool is_shared = !(copy_of & $COPY_OF_DETACHED);
+        bool result = false;
+        if (is_shared) {
+            result = function(object, source, args);
+        }
+        $object_unlock(source_, readonly, is_owned);
+        if (is_shared) {
+            return result;
+        }
+    }
+    if (!readonly) {
+        struct $object_extras *extras = $object_get_extras(extension);
+        if (extras
+            && extras->sharers
+            && !$object_detach_sharers(object, extras)) {
+            return false;
+        }
+    }
+    return function(object, object, args);
+}
+
+struct $object_share_args {
+    void *copy;
+    bool is_alias;
+};
+
+static bool $object_share(void *this,
+                          void *data,
+                          struct $object_share_args *args) {
+    coral_required(data);
+    coral_required(args);
+    coral_required(args->copy);
+    struct $object_extension *copy_ = $object_get_extension(
+            coral$object_from(args->copy));
+    coral_required(copy_);
+    uintptr_t copy_of = (uintptr_t) data;
+    if (args->is_alias) {
+        copy_of |= $COPY_OF_ALIAS;
+    } else {
+        struct $object_extension *data_ = $object_get_extension(
+                coral$object_from(data));
+        coral_required(data_);
+        struct $object_extras *extras;
+        if (!$object_extras(copy_) || !(extras = $object_extras(data_))) {
+            return false;
+        }
+        $sharers_add(extras, args->copy);
+    }
+    coral_required_true($object_retain(data, NULL, NULL));
+    atomic_store_explicit(&copy_->copy_of, copy_of, memory_order_release);
+    return true;
+}
+
+bool coral$object$copy_is_unavailable(void *this, void *data, void *args) {
+    coral_error = CORAL_ERROR_OBJECT_UNAVAILABLE;
+    return false; /* copying is not allowed */
+}
+
+void *coral$object$get_data(void *object) {
+    coral_required(object);
+    return coral$object_to(coral$object_resolve(coral$object_from(object)));
+}
+
+static void $observers_lock(struct $object_extras *extras) {
+    coral_required(extras);
+    while (atomic_flag_test_and_set_explicit(&extras->observers_lock,
+                                             memory_order_acquire));
+}
+
+static void $observers_unlock(struct $object_extras *extras) {
+    coral_required(extras);
+    atomic_flag_clear_explicit(&extras->observers_lock,
+                               memory_order_release);
+}
+
+static void $observers_free(struct $observers *observers) {
+    while (observers) {
+        struct $observers *retired = observers->retired;
+        coral$allocator$free(observers);
+        observers = retired;
+    }
+}
+
+static bool $observer_matches(const struct $observer *observer,
+                              const char *event) {
+    coral_required(observer);
+    return observer->event == event
+           || (observer->event && event && !strcmp(observer->event, event));
+}
+
+/* Publish the new observer list and free the retired ones once no post is in
+ * progress, the caller must hold the observers lock. */
+static void $observers_publish(struct coral_object *object,
+                               struct $object_extras *extras,
+                               struct $observers *observers) {
+    coral_required(object);
+    coral_required(extras);
+    struct $observers *current = (struct $observers *)
+            atomic_exchange(&extras->observers, (uintptr_t) observers);
+    if (observers) {
+        atomic_fetch_or(&object->extension, $EXTENSION_IS_OBSERVED);
+    } else {
+        atomic_fetch_and(&object->extension, ~$EXTENSION_IS_OBSERVED);
+    }
+    if (current) {
+        current->retired = extras->retired;
+        extras->retired = current;
+    }
+    /* a post that starts from now on can only see the new list */
+    if (!atomic_load(&extras->posting)) {
+        $observers_free(extras->retired);
+        extras->retired = NULL;
+    }
+}
+
+bool coral$object_add_observer(void *object,
+                               void *observer,
+                               const char *event,
+                               void (*on_event)(void *observer,
+                                                void *object,
+                                                const char *event)) {
     coral_required(object);
     coral_required(observer);
-    // when event = NULL that means all events
+    coral_required(on_event);
+    struct coral_object *object_ = coral$object_from(object);
+    if (!$object_is_initialized(object_)) {
+        coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
+        return false;
+    }
+    struct $object_extension *extension = $object_extension(object_);
+    struct $object_extras *extras;
+    if (!extension || !(extras = $object_extras(extension))) {
+        return false;
+    }
+    $observers_lock(extras);
+    const struct $observers *current = (struct $observers *)
+            atomic_load_explicit(&extras->observers, memory_order_relaxed);
+    const size_t count = current ? current->count : 0;
+    for (size_t i = 0; i < count; i++) {
+        if (current->items[i].observer == observer
+            && $observer_matches(&current->items[i], event)) {
+            $observers_unlock(extras);
+            coral_error = CORAL_ERROR_OBJECT_ALREADY_EXISTS;
+            return false;
+        }
+    }
+    struct $observers *observers;
+    if (!coral$allocator$calloc(
+            CORAL_ALLOCATOR_TAG_OBJECT,
+            1, sizeof(*observers) + (1 + count) * sizeof(struct $observer),
+            (void **) &observers)) {
+        $observers_unlock(extras);
+        return false;
+    }
+    if (count) {
+        memcpy(observers->items, current->items,
+               count * sizeof(struct $observer));
+    }
+    observers->items[count] = (struct $observer) {
+            .observer = observer,
+            .event = event,
+            .on_event = on_event
+    };
+    observers->count = 1 + count;
+    $observers_publish(object_, extras, observers);
+    $observers_unlock(extras);
+    return true;
 }
 
-void
-coral$object_remove_observer(struct coral_object *object,
-                             void *observer, const char *event) {
+bool coral$object_remove_observer(void *object,
+                                  void *observer,
+                                  const char *event) {
     coral_required(object);
     coral_required(observer);
-    // when event = NULL that means all events
+    struct coral_object *object_ = coral$object_from(object);
+    if (!$object_is_initialized(object_)) {
+        coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
+        return false;
+    }
+    struct $object_extension *extension = $object_get_extension(object_);
+    struct $object_extras *extras;
+    if (!extension || !(extras = $object_get_extras(extension))) {
+        coral_error = CORAL_ERROR_OBJECT_NOT_FOUND;
+        return false;
+    }
+    $observers_lock(extras);
+    const struct $observers *current = (struct $observers *)
+            atomic_load_explicit(&extras->observers, memory_order_relaxed);
+    const size_t count = current ? current->count : 0;
+    size_t remaining = 0;
+    for (size_t i = 0; i < count; i++) {
+        /* when event is NULL every subscription of observer is removed */
+        remaining += current->items[i].observer != observer
+                     || (event && !$observer_matches(&current->items[i],
+                                                     event));
+    }
+    if (remaining == count) {
+        $observers_unlock(extras);
+        coral_error = CORAL_ERROR_OBJECT_NOT_FOUND;
+        return false;
+    }
+    struct $observers *observers = NULL;
+    if (remaining) {
+        if (!coral$allocator$calloc(
+                CORAL_ALLOCATOR_TAG_OBJECT,
+                1, sizeof(*observers) + remaining * sizeof(struct $observer),
+                (void **) &observers)) {
+            $observers_unlock(extras);
+            return false;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (current->items[i].observer != observer
+                || (event && !$observer_matches(&current->items[i], event))) {
+                observers->items[observers->count++] = current->items[i];
+            }
+        }
+    }
+    $observers_publish(object_, extras, observers);
+    $observers_unlock(extras);
+    return true;
+}
+
+void coral$object$notify(void *object, const char *notification) {
+    coral_required(object);
+    coral_required(notification);
+    struct coral_object *object_ = coral$object_from(object);
+    const uintptr_t extension_ = atomic_load_explicit(&object_->extension,
+                                                      memory_order_acquire);
+    if (!(extension_ & $EXTENSION_IS_OBSERVED)) {
+        return;
+    }
+    struct $object_extras *extras = $object_get_extras(
+            (struct $object_extension *) (extension_ & ~$EXTENSION_IS_OBSERVED));
+    atomic_fetch_add(&extras->posting, 1);
+    const struct $observers *observers = (struct $observers *)
+            atomic_load(&extras->observers);
+    const size_t count = observers ? observers->count : 0;
+    for (size_t i = 0; i < count; i++) {
+        const struct $observer *observer = &observers->items[i];
+        if (!observer->event || $observer_matches(observer, notification)) {
+            observer->on_event(observer->observer, object, notification);
+        }
+    }
+    atomic_fetch_sub(&extras->posting, 1);
 }
 
 void coral$object_post_notification(void *object, const char *notification) {
     coral_required(object);
     coral_required(notification);
-    // lock on the dictionary for events ...
-    // for every item in the event ... post to
+    struct coral_object *object_ = coral$object_from(object);
+    if (!(atomic_load_explicit(&object_->extension, memory_order_relaxed)
+          & $EXTENSION_IS_OBSERVED)) {
+        return;
+    }
+    /* the object is no longer retainable once it is being destroyed */
+    if (CORAL_NOTIFICATION_OBJECT_DESTROYED != notification
+        && coral$notification_dispatcher$post(object, notification)) {
+        return;
+    }
+    coral$object$notify(object, notification);
+}
+
+bool coral$object$release_many(void *object, const size_t count) {
+    coral_required(object);
+    struct coral_object *object_ = coral$object_from(object);
+    if (!$object_is_initialized(object_)) {
+        coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
+        return false;
+    }
+    coral$release_many(object, &object_->ref_count, count,
+                       $object_on_destroy);
+    return true;
 }
 
 #pragma mark public -
@@ -280,15 +995,26 @@ bool coral_object_invoke(void *object,
         coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
         return false;
     }
-    object_ = coral$object_resolve(object_);
-    void *data = coral$object_to(object_);
-    coral$autorelease_pool$start();
-    coral_required_true(readonly
-        ? coral$rwlock$read_lock(&object_->lock)
-        : coral$rwlock$write_lock(&object_->lock));
-    const bool result = function(object, data, args);
-    coral_required_true(coral$rwlock$unlock(&object_->lock));
-    coral$autorelease_pool$end();
+    /* objects that are only ever read go without an extension */
+    struct $object_extension *extension = NULL;
+    if (!(readonly && $object_read_begin(object_))
+        && !(extension = $object_extension(object_))) {
+        return false;
+    }
+    const size_t invoke_depth = $invoke_depth;
+    const size_t watermark = coral$autorelease_pool$start();
+    $invoke_depth = coral$autorelease_pool$get_depth();
+    bool result;
+    if (!extension) {
+        result = function(object, object, args);
+        $object_read_end(object_);
+    } else {
+        const bool is_owned = $object_lock(extension, readonly);
+        result = $object_invoke(object, extension, readonly, function, args);
+        $object_unlock(extension, readonly, is_owned);
+    }
+    coral$autorelease_pool$end(watermark);
+    $invoke_depth = invoke_depth;
     return result;
 }
 
@@ -299,6 +1025,31 @@ bool coral_object_dispatch(void *object, bool readonly, const char *method,
            && coral_object_invoke(object, readonly, function, args);
 }
 
+bool coral_object_dispatch_selector(void *object,
+                                    bool readonly,
+                                    const struct coral_selector *selector,
+                                    void *args) {
+    coral_invokable_t function;
+    return $object_get_dispatch_selector(object, selector, &function)
+           && coral_object_invoke(object, readonly, function, args);
+}
+
+bool coral_object_dispatch_cached(void *object,
+                                  bool readonly,
+                                  struct coral_inline_cache *cache,
+                                  void *args) {
+    coral_required(object);
+    coral_required(cache);
+    struct coral_object *object_ = coral$object_from(object);
+    if (!$is_object(object_)) { /* checksum failed */
+        coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
+        return false;
+    }
+    coral_invokable_t function;
+    return coral$inline_cache$get(cache, object_->class, &function)
+           && coral_object_invoke(object, readonly, function, args);
+}
+
 bool coral_object_class(struct coral_class **out) {
     if (!out) {
         coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
@@ -341,17 +1092,48 @@ bool coral_object_destroy(void *object) {
     struct coral_object *object_ = coral$object_from(object);
     coral$atomic_store(&object_->ref_count, 0);
     if ($is_object(object_)) {
-        coral$rwlock$invalidate(&object_->lock);
-        if (object_->copy_of) {
-            coral_required_true($object_release(object_->copy_of, NULL, NULL));
+        struct $object_extension *extension = $object_get_extension(object_);
+        bool is_shared = false;
+        void *source = NULL;
+        if (extension) {
+            const uintptr_t copy_of = atomic_load_explicit(
+                    &extension->copy_of, memory_order_acquire);
+            source = (void *) (copy_of & ~$COPY_OF_TAGS);
+            if (copy_of && !(copy_of & $COPY_OF_TAGS)) {
+                struct $object_extension *source_ = $object_get_extension(
+                        coral$object_from(source));
+                const bool is_owned = $object_lock(source_, true);
+                if (!(atomic_load_explicit(&extension->copy_of,
+                                           memory_order_acquire)
+                      & $COPY_OF_DETACHED)) {
+                    /* our payload was never materialized */
+                    $sharers_remove($object_get_extras(source_), object);
+                    is_shared = true;
+                }
+                $object_unlock(source_, true, is_owned);
+            }
         }
-        if (destroy_func) {
+        if (destroy_func && !is_shared) {
             coral_required_true(destroy_func(object, object, NULL));
         }
         coral$object_post_notification(object,
                                        CORAL_NOTIFICATION_OBJECT_DESTROYED);
+        if (extension) {
+            struct $object_extras *extras = $object_get_extras(extension);
+            if (extras) {
+                $observers_free((struct $observers *) atomic_load_explicit(
+                        &extras->observers, memory_order_relaxed));
+                $observers_free(extras->retired);
+                coral$slab$free(extras);
+            }
+            coral$rwlock$invalidate(&extension->lock);
+            coral$slab$free(extension);
+        }
+        if (source) {
+            coral_required_true($object_release(source, NULL, NULL));
+        }
     }
-    free(object_);
+    $object_free(object_);
     return true;
 }
 
@@ -427,27 +1209,32 @@ bool coral_object_copy(void *object, void **out) {
         && CORAL_ERROR_METHOD_NOT_FOUND != coral_error) {
         return false;
     }
+    if (copy_func == (coral_invokable_t) coral$object$copy_is_unavailable) {
+        return copy_func(object, object, NULL);
+    }
+    /* without a copy method the copy remains an alias of object, otherwise
+     * it shares the payload of object until it is first written to */
+    struct $object_share_args args = {
+            .is_alias = !copy_func
+    };
     bool result = false, did_init = false;
-    // FIXME: copy-of-copy(-of-copy...) case ...
     struct coral_object *object_ = coral$object_from(object);
-    if ($object_alloc(object_->size, out)
-        && $object_init(*out, object_->class)
+    if ($object_alloc(object_->size & ~$OBJECT_IS_ALLOCATED, &args.copy)
+        && $object_init(args.copy, object_->class)
         && (did_init = true)
-        && $object_retain(object, NULL, NULL)
-        && (coral$object_from(*out)->copy_of = object)) {
-        if (copy_func) { // TODO: change to a copy-on-write implementation ...
-            struct copy_args args = {
-                    .src = object
-            };
-            result = copy_func(*out, *out, &args);
-        } else {
-            result = true;
-        }
+        /* readers of the copy take the lock of object */
+        && $object_extension(object_)
+        && $object_extension(coral$object_from(args.copy))) {
+        result = coral_object_invoke(object, true,
+                                     (coral_invokable_t) $object_share,
+                                     &args);
     }
-    if (!result) {
-        if (!did_init) {
+    if (result) {
+        *out = args.copy;
+    } else {
+        if (args.copy && !did_init) {
             const size_t error = coral_error;
-            coral_required_true(coral_object_destroy(*out));
+            coral_required_true(coral_object_destroy(args.copy));
             coral_error = error;
         }
         *out = NULL;
@@ -460,11 +1247,14 @@ bool coral_object_retain(void *object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
         return false;
     }
-    return coral_object_invoke(
-            object,
-            true,
-            $object_retain,
-            NULL);
+    struct coral_object *object_ = coral$object_from(object);
+    if (!$object_is_initialized(object_)) {
+        coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
+        return false;
+    }
+    /* reference counting is atomic and does not need the object's lock nor
+     * an autorelease pool, so we bypass coral_object_invoke(...) */
+    return $object_retain(object, NULL, NULL);
 }
 
 bool coral_object_release(void *object) {
@@ -472,11 +1262,71 @@ bool coral_object_release(void *object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
         return false;
     }
-    return coral_object_invoke(
-            object,
-            true,
-            $object_release,
-            NULL);
+    struct coral_object *object_ = coral$object_from(object);
+    if (!$object_is_initialized(object_)) {
+        coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
+        return false;
+    }
+    return $object_release(object, NULL, NULL);
+}
+
+static bool $objects_are_initialized(void **objects, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (objects[i]
+            && !$object_is_initialized(coral$object_from(objects[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* length of the run of identical pointers that starts at objects[at] */
+static size_t $objects_run(void **objects, const size_t at,
+                           const size_t count) {
+    size_t i = 1 + at;
+    while (i < count && objects[i] == objects[at]) {
+        i++;
+    }
+    return i - at;
+}
+
+bool coral_object_retain_many(void **objects, const size_t count) {
+    if (!objects && count) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (!$objects_are_initialized(objects, count)) {
+        coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
+        return false;
+    }
+    for (size_t i = 0, run; i < count; i += run) {
+        run = $objects_run(objects, i, count);
+        if (objects[i]) {
+            struct coral_object *object_ = coral$object_from(objects[i]);
+            coral$retain_many(&object_->ref_count, run);
+        }
+    }
+    return true;
+}
+
+bool coral_object_release_many(void **objects, const size_t count) {
+    if (!objects && count) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (!$objects_are_initialized(objects, count)) {
+        coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
+        return false;
+    }
+    for (size_t i = 0, run; i < count; i += run) {
+        run = $objects_run(objects, i, count);
+        if (objects[i]) {
+            struct coral_object *object_ = coral$object_from(objects[i]);
+            coral$release_many(objects[i], &object_->ref_count, run,
+                               $object_on_destroy);
+        }
+    }
+    return true;
 }
 
 bool coral_object_autorelease(void *object) {
@@ -484,9 +1334,10 @@ bool coral_object_autorelease(void *object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
         return false;
     }
-    return coral_object_invoke(
-            object,
-            true,
-            $object_autorelease,
-            NULL);
+    struct coral_object *object_ = coral$object_from(object);
+    if (!$object_is_initialized(object_)) {
+        coral_error = CORAL_ERROR_OBJECT_IS_UNINITIALIZED;
+        return false;
+    }
+    return $object_autorelease(object, NULL, NULL);
 }
@@ -0,0 +1,70 @@
+#ifndef _CORAL_PRIVATE_ALLOCATOR_H_
+#define _CORAL_PRIVATE_ALLOCATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Check if the default allocator is in effect for the calling thread.
+ * @return true if blocks come from malloc(3), otherwise false.
+ */
+bool coral$allocator$is_default();
+
+/**
+ * @brief Retrieve the allocator installed for the calling thread.
+ * @return the thread's own allocator or <i>NULL</i> if it has none.
+ */
+const struct coral_allocator *coral$allocator$get_thread();
+
+/**
+ * @brief Allocate a block from the calling thread's allocator.
+ * @param [in] tag CORAL_ALLOCATOR_TAG_* of the subsystem using the block.
+ * @param [in] size in bytes of the block.
+ * @param [out] out receive the uninitialized block.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to allocate the block.
+ * @note If tag is unknown or out is <i>NULL</i> we will call abort(3).
+ */
+bool coral$allocator$alloc(size_t tag, size_t size, void **out);
+
+/**
+ * @brief Allocate a zeroed block for count items of size bytes each.
+ * @param [in] tag CORAL_ALLOCATOR_TAG_* of the subsystem using the block.
+ * @param [in] count number of items.
+ * @param [in] size in bytes of each item.
+ * @param [out] out receive the zeroed block.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to allocate the block or its size overflows.
+ * @note If tag is unknown or out is <i>NULL</i> we will call abort(3).
+ */
+bool coral$allocator$calloc(size_t tag, size_t count, size_t size,
+                            void **out);
+
+/**
+ * @brief Resize a block.
+ * <p>The block is resized by the allocator that provided it if that is the
+ * one in effect and tag is the block's tag, otherwise it is moved to a new
+ * block from the allocator in effect.</p>
+ * @param [in] tag CORAL_ALLOCATOR_TAG_* of the subsystem using the block.
+ * @param [in] ptr block to resize or <i>NULL</i> to allocate a new one.
+ * @param [in] size in bytes that the block should have.
+ * @param [out] out receive the resized block, the contents up to the lesser
+ * of the old and new size are kept.
+ * @return On success true, otherwise false if an error has occurred in which
+ * case ptr is left untouched.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to resize the block.
+ * @note If tag is unknown or out is <i>NULL</i> we will call abort(3).
+ */
+bool coral$allocator$realloc(size_t tag, void *ptr, size_t size, void **out);
+
+/**
+ * @brief Return a block to the allocator that provided it.
+ * @param [in] ptr block to free, <i>NULL</i> is ignored.
+ */
+void coral$allocator$free(void *ptr);
+
+#endif /* _CORAL_PRIVATE_ALLOCATOR_H_ */
@@ -3,36 +3,36 @@
 
 #include <stddef.h>
 
-struct coral$autorelease_pool$entry {
-    struct coral$autorelease_pool$entry *next;
-    void *object;
-};
-
 /**
- * @brief Return the stack of autorelease pools.
- * @param [out] out stack containing entries.
+ * @brief Return the number of chunks that back this thread's pools.
+ * <p>Chunks are reused across pools and only returned when the thread exits
+ * or, beyond a few spare ones, when all pools are drained.</p>
+ * @param [out] out receive the number of chunks.
  * @note If out is <i>NULL</i> we will call abort(3).
  */
-void
-coral$autorelease_pool$get_stack(struct coral$autorelease_pool$entry **out);
+void coral$autorelease_pool$get_chunks(size_t *out);
 
 /**
- * @brief Return items being tracked for autorelease.
- * @param [out] out items being tracked for autorelease.
- * @note If out is <i>NULL</i> we will call abort(3).
+ * @brief Return the number of pools that are in use on this thread.
+ * @return number of pools that were started and have not yet ended.
  */
-void
-coral$autorelease_pool$get_items(struct coral$autorelease_pool$entry **out);
+size_t coral$autorelease_pool$get_depth();
 
 /**
  * @brief Create new autorelease pool.
+ * <p>A pool only records how many objects were tracked when it was started,
+ * no memory is allocated to start or end it.</p>
+ * @return watermark of the enclosing pool which must be given to
+ * coral$autorelease_pool$end.
  */
-void coral$autorelease_pool$start();
+size_t coral$autorelease_pool$start();
 
 /**
  * @brief Destroy autorelease pool and collect any unowned items.
+ * @param [in] watermark as returned by the matching
+ * coral$autorelease_pool$start.
  */
-void coral$autorelease_pool$end();
+void coral$autorelease_pool$end(size_t watermark);
 
 /**
  * @brief Add object to the current autorelease pool.
@@ -44,10 +44,11 @@ void coral$autorelease_pool$add(void *object);
 /**
  * @brief Add object to the previous autorelease pool.
  * <p>Adding to a previous autorelease pool allows the collection of this
- * object to be deferred.</p>
+ * object to be deferred until the pool enclosing the current autorelease pool
+ * has ended. If there is no current autorelease pool then the object is added
+ * to the thread's implicit autorelease pool.</p>
  * @param [in] object instance to be added to previous autorelease pool.
- * @note If object is <i>NULL</i> or there is no previous autorelease pool we
- * will call abort(3).
+ * @note If object is <i>NULL</i> we will call abort(3).
  */
 void coral$autorelease_pool$add_previous(void *object);
 
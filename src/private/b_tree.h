@@ -0,0 +1,209 @@
+#ifndef _CORAL_PRIVATE_B_TREE_H_
+#define _CORAL_PRIVATE_B_TREE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* B+Tree : https://en.wikipedia.org/wiki/B%2B_tree
+ *
+ * Items are copied into the leaves, many to a node, so that a lookup visits
+ * one node per level and there are only a few levels. Inner nodes hold copies
+ * of the first item of the subtree to their right to steer by. Leaves link to
+ * their neighbours, so stepping through the items in order only leaves the
+ * current node once it runs out of items. Items move about within and between
+ * nodes on insert and delete, so a pointer to an item is only valid until the
+ * tree is next modified. Items are aligned to 8 bytes. */
+
+/* bytes a node should span, half a page, as fewer levels to descend make up
+ * for the longer binary search within each node */
+#define CORAL_B_TREE_NODE_SIZE          2048
+/* least order of a node, however big its items are */
+#define CORAL_B_TREE_ORDER_MINIMUM      4
+/* most inner levels, enough for any count since inner nodes never have less
+ * than two children */
+#define CORAL_B_TREE_HEIGHT_MAXIMUM     64
+
+struct coral$b_tree$leaf {
+    struct coral$b_tree$leaf *prev;
+    struct coral$b_tree$leaf *next;
+    size_t count;
+    unsigned char items[];
+};
+
+/* The keys follow the children, key i being the first item of the subtree of
+ * child i + 1. */
+struct coral$b_tree$inner {
+    size_t count; /* of children */
+    void *children[];
+};
+
+struct coral$b_tree {
+    void *root;
+    void *first;
+    void *last;
+    size_t size;
+    size_t count;
+    size_t height;
+    size_t leaf_order;
+    size_t inner_order;
+
+    int (*compare)(const void *, const void *);
+};
+
+/**
+ * @brief Initialize the b tree instance.
+ * @param [in] object instance to be initialized.
+ * @param [in] size in bytes of the items held in the tree.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if <u>first</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>second</u>.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if compare is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if size is zero.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if the nodes for items of
+ * size would not fit in memory.
+ */
+bool coral$b_tree$init(struct coral$b_tree *object,
+                       size_t size,
+                       int (*compare)(const void *first, const void *second));
+
+/**
+ * @brief Invalidate the b tree instance.
+ * <p>The items in the tree are destroyed and each will invoke the provided
+ * <i>on destroy</i> callback, in order, before the nodes are released. The
+ * actual <u>b tree instance is not deallocated</u> since it may have been
+ * embedded in a larger structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @param [in] on_destroy called just before the item is to be destroyed.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ */
+bool coral$b_tree$invalidate(struct coral$b_tree *object,
+                             void (*on_destroy)(void *));
+
+/**
+ * @brief Retrieve the count of items in the tree.
+ * @param [in] object instance whose count is to be retrieved.
+ * @param [out] out receive the count.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ */
+bool coral$b_tree$get_count(struct coral$b_tree *object, size_t *out);
+
+/**
+ * @brief Search for item.
+ * @param [in] object instance to be searched.
+ * @param [in] item to find in the tree.
+ * @param [out] out receive the item held in the tree that matched.
+ * @return If exact match found true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if either item or out is
+ * <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if there was no exact match.
+ */
+bool coral$b_tree$search(struct coral$b_tree *object, const void *item,
+                         void **out);
+
+/**
+ * @brief Insert a copy of item.
+ * @param [in] object instance into which the item is to be inserted.
+ * @param [in] item to be copied into the tree.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if item is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_ALREADY_EXISTS if item is already in the tree.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to split the nodes that are full.
+ */
+bool coral$b_tree$insert(struct coral$b_tree *object, const void *item);
+
+/**
+ * @brief Build the tree out of items in linear time.
+ * <p>The items are copied into as few leaves as will hold them, which are
+ * then gathered under as few inner nodes as will hold them, level by level,
+ * without comparing the items to each other, apart from checking each
+ * against the one before it, to make sure that the items are strictly
+ * ascending.</p>
+ * @param [in] object instance which must be empty.
+ * @param [in] items to be copied into the tree, one after the other in
+ * ascending order without duplicates.
+ * @param [in] count of items.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if items is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the tree is not empty.
+ * @throws CORAL_ERROR_INVALID_VALUE if an item is not greater than the item
+ * before it, in which case the tree is left empty.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory for the nodes, in which case the tree is left empty.
+ */
+bool coral$b_tree$build(struct coral$b_tree *object, const void *items,
+                        size_t count);
+
+/**
+ * @brief Delete item.
+ * @param [in] object instance from which the item is to be deleted.
+ * @param [in] item to be deleted.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if item is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if item is not in the tree.
+ */
+bool coral$b_tree$delete(struct coral$b_tree *object, const void *item);
+
+/**
+ * @brief Retrieve the smallest item.
+ * @param [in] object instance whose first item is to be retrieved.
+ * @param [out] out receive the first item held in the tree.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if the tree is empty.
+ */
+bool coral$b_tree$get_first(struct coral$b_tree *object, void **out);
+
+/**
+ * @brief Retrieve the largest item.
+ * @param [in] object instance whose last item is to be retrieved.
+ * @param [out] out receive the last item held in the tree.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if the tree is empty.
+ */
+bool coral$b_tree$get_last(struct coral$b_tree *object, void **out);
+
+/**
+ * @brief Retrieve the item that follows item.
+ * @param [in] object instance that holds the item.
+ * @param [in] item whose successor we want.
+ * @param [out] out receive the next item held in the tree.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if either item or out is
+ * <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if item is not in the tree.
+ * @throws CORAL_ERROR_END_OF_SEQUENCE if there are no more items.
+ */
+bool coral$b_tree$get_next(struct coral$b_tree *object, const void *item,
+                           void **out);
+
+/**
+ * @brief Retrieve the item that precedes item.
+ * @param [in] object instance that holds the item.
+ * @param [in] item whose predecessor we want.
+ * @param [out] out receive the previous item held in the tree.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if either item or out is
+ * <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if item is not in the tree.
+ * @throws CORAL_ERROR_END_OF_SEQUENCE if there are no more items.
+ */
+bool coral$b_tree$get_prev(struct coral$b_tree *object, const void *item,
+                           void **out);
+
+#endif /* _CORAL_PRIVATE_B_TREE_H_ */
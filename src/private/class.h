@@ -7,4 +7,25 @@
 
 #define CORAL_CLASS_LOAD_PRIORITY_CLASS     100
 
+struct coral_class;
+
+/**
+ * @brief Check if the class is frozen without taking its lock.
+ * @param [in] object class to check.
+ * @return true if the methods of the class can no longer change, otherwise
+ * false.
+ * @note If object is <i>NULL</i> we will call abort(3).
+ */
+bool coral$class$is_frozen(const struct coral_class *object);
+
+/**
+ * @brief Retrieve the generation of a frozen class without taking its lock.
+ * <p>Each freeze is given a new generation, so a class allocated at the
+ * address of a destroyed class never has the generation of the latter.</p>
+ * @param [in] object class whose generation we are to retrieve.
+ * @return generation of the class, or <i>ZERO</i> if it is not frozen.
+ * @note If object is <i>NULL</i> we will call abort(3).
+ */
+size_t coral$class$get_generation(const struct coral_class *object);
+
 #endif /* _CORAL_PRIVATE_CLASS_H_ */
\ No newline at end of file
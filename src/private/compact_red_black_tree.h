@@ -0,0 +1,260 @@
+#ifndef _CORAL_PRIVATE_COMPACT_RED_BLACK_TREE_H_
+#define _CORAL_PRIVATE_COMPACT_RED_BLACK_TREE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Compact Red-Black Tree
+ *
+ * Same balancing as the red black tree, but the nodes are kept together in
+ * one arena and link to each other by 32-bit indices instead of pointers, so
+ * that each node carries 12 bytes of links instead of 24 and more of them fit
+ * in a cache line. The colour is stored in the highest bit of the parent
+ * index. Index 0 is the black sentinel that stands in for every missing child
+ * and for the parent of the root, so index 0 never refers to an item. Items
+ * are copied into the arena, which moves when it grows, so a pointer to an
+ * item is only valid until the next insert. Items are aligned to the largest
+ * power of two that divides their size, up to that of max_align_t, so the
+ * compare callback may read them in place. */
+
+#define CORAL_COMPACT_RED_BLACK_TREE_NIL                ((uint32_t) 0)
+/* most nodes an arena can hold, including the sentinel */
+#define CORAL_COMPACT_RED_BLACK_TREE_CAPACITY_MAXIMUM   \
+    ((uint32_t) INT32_MAX)
+#define CORAL_COMPACT_RED_BLACK_TREE_CAPACITY_MINIMUM   ((uint32_t) 16)
+
+struct coral$compact_red_black_tree$node {
+    uint32_t left;
+    uint32_t right;
+    uint32_t parent; /* color bit is stored in the highest bit */
+};
+
+struct coral$compact_red_black_tree {
+    unsigned char *nodes;
+    size_t size;
+    size_t offset; /* of the item from the start of its node */
+    size_t stride;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t root;
+    uint32_t available; /* deleted nodes linked through their left child */
+    size_t count;
+
+    int (*compare)(const void *, const void *);
+};
+
+/**
+ * @brief Initialize the compact red black tree instance.
+ * @param [in] object instance to be initialized.
+ * @param [in] size in bytes of the items held in the tree.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if <u>first</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>second</u>.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if compare is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if size is zero.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to allocate the arena.
+ */
+bool coral$compact_red_black_tree$init(
+        struct coral$compact_red_black_tree *object,
+        size_t size,
+        int (*compare)(const void *first, const void *second));
+
+/**
+ * @brief Invalidate the compact red black tree instance.
+ * <p>The items in the tree are destroyed and each will invoke the provided
+ * <i>on destroy</i> callback before the arena is released. The actual
+ * <u>compact red black tree instance is not deallocated</u> since it may have
+ * been embedded in a larger structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @param [in] on_destroy called just before the item is to be destroyed.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ */
+bool coral$compact_red_black_tree$invalidate(
+        struct coral$compact_red_black_tree *object,
+        void (*on_destroy)(void *));
+
+/**
+ * @brief Retrieve the count of items in the tree.
+ * @param [in] object instance whose count is to be retrieved.
+ * @param [out] out receive the count.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ */
+bool coral$compact_red_black_tree$get_count(
+        struct coral$compact_red_black_tree *object, size_t *out);
+
+/**
+ * @brief Retrieve the bytes held by the arena of the tree.
+ * @param [in] object instance whose arena size is to be retrieved.
+ * @param [out] out receive the size of the arena in bytes.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ */
+bool coral$compact_red_black_tree$get_footprint(
+        struct coral$compact_red_black_tree *object, size_t *out);
+
+/**
+ * @brief Set the number of items the arena can hold before it has to grow.
+ * <p>The arena grows by half of its capacity whenever it runs out of nodes,
+ * setting the capacity up front avoids both the copies and the unused space
+ * that come with growing.</p>
+ * @param [in] object instance whose arena is to be resized.
+ * @param [in] capacity number of items.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if capacity is less than the number of
+ * nodes in use, deleted ones included, or more than the arena can hold.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to resize the arena.
+ */
+bool coral$compact_red_black_tree$set_capacity(
+        struct coral$compact_red_black_tree *object, size_t capacity);
+
+/**
+ * @brief Retrieve the item of node.
+ * @param [in] object instance that holds the node.
+ * @param [in] node index of the node.
+ * @param [out] out receive the item, which is valid until the next insert.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INDEX_OUT_OF_BOUNDS if node is the sentinel or not in
+ * the arena.
+ */
+bool coral$compact_red_black_tree$get_item(
+        struct coral$compact_red_black_tree *object, uint32_t node,
+        void **out);
+
+/**
+ * @brief Search for item.
+ * @param [in] object instance to be searched.
+ * @param [in] item to find in the tree.
+ * @param [out] out receive the exact matched node or insertion point.
+ * @return If exact match found true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if either item or out is
+ * <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if exact match not found insertion
+ * point will still be reported, which is the sentinel if the tree is empty.
+ */
+bool coral$compact_red_black_tree$search(
+        struct coral$compact_red_black_tree *object, const void *item,
+        uint32_t *out);
+
+/**
+ * @brief Insert a copy of item.
+ * @param [in] object instance into which the item is to be inserted.
+ * @param [in] item to be copied into the tree.
+ * @param [out] out receive the node that holds the item, may be <i>NULL</i>.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if item is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_ALREADY_EXISTS if item is already in the tree.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to grow the arena or it cannot hold any more nodes.
+ */
+bool coral$compact_red_black_tree$insert(
+        struct coral$compact_red_black_tree *object, const void *item,
+        uint32_t *out);
+
+/**
+ * @brief Build the tree out of items in linear time.
+ * <p>The items are copied into the arena in the order given and linked into
+ * a balanced tree without comparing them to each other, apart from checking
+ * each against the one before it, to make sure that the items are strictly
+ * ascending. Deleted nodes that were yet to be reused are dropped.</p>
+ * @param [in] object instance which must be empty.
+ * @param [in] items to be copied into the tree, one after the other in
+ * ascending order without duplicates.
+ * @param [in] count of items.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if items is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the tree is not empty.
+ * @throws CORAL_ERROR_INVALID_VALUE if an item is not greater than the item
+ * before it or the arena cannot hold count items, in which case the tree is
+ * left empty.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to grow the arena.
+ */
+bool coral$compact_red_black_tree$build(
+        struct coral$compact_red_black_tree *object, const void *items,
+        size_t count);
+
+/**
+ * @brief Delete item.
+ * <p>The node of the item is reused by a later insert.</p>
+ * @param [in] object instance from which the item is to be deleted.
+ * @param [in] item to be deleted.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if item is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if item is not in the tree.
+ */
+bool coral$compact_red_black_tree$delete(
+        struct coral$compact_red_black_tree *object, const void *item);
+
+/**
+ * @brief Retrieve the node of the smallest item.
+ * @param [in] object instance whose first node is to be retrieved.
+ * @param [out] out receive the first node.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if the tree is empty.
+ */
+bool coral$compact_red_black_tree$get_first(
+        struct coral$compact_red_black_tree *object, uint32_t *out);
+
+/**
+ * @brief Retrieve the node of the largest item.
+ * @param [in] object instance whose last node is to be retrieved.
+ * @param [out] out receive the last node.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if the tree is empty.
+ */
+bool coral$compact_red_black_tree$get_last(
+        struct coral$compact_red_black_tree *object, uint32_t *out);
+
+/**
+ * @brief Retrieve the node that follows node.
+ * @param [in] object instance that holds the node.
+ * @param [in] node whose successor we want.
+ * @param [out] out receive the next node.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INDEX_OUT_OF_BOUNDS if node is the sentinel or not in
+ * the arena.
+ * @throws CORAL_ERROR_END_OF_SEQUENCE if there are no more nodes.
+ */
+bool coral$compact_red_black_tree$get_next(
+        struct coral$compact_red_black_tree *object, uint32_t node,
+        uint32_t *out);
+
+/**
+ * @brief Retrieve the node that precedes node.
+ * @param [in] object instance that holds the node.
+ * @param [in] node whose predecessor we want.
+ * @param [out] out receive the previous node.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INDEX_OUT_OF_BOUNDS if node is the sentinel or not in
+ * the arena.
+ * @throws CORAL_ERROR_END_OF_SEQUENCE if there are no more nodes.
+ */
+bool coral$compact_red_black_tree$get_prev(
+        struct coral$compact_red_black_tree *object, uint32_t node,
+        uint32_t *out);
+
+#endif /* _CORAL_PRIVATE_COMPACT_RED_BLACK_TREE_H_ */
@@ -80,13 +80,28 @@ void coral$atomic_store_ptr(atomic_uintptr_t *ptr, uintptr_t value);
 bool coral$atomic_compare_exchange_ptr(atomic_uintptr_t *ptr, uintptr_t compare,
                                        uintptr_t value);
 
+/* Reference count of immortal instances. Retaining or releasing them only
+ * reads the counter so that its cache line is never written to by any of the
+ * threads that share it. */
+#define CORAL_REF_COUNT_IMMORTAL        (SIZE_MAX >> 1)
+
 /**
  * @brief Increase the reference counter.
  * @param [in] ref_counter counter to increase.
  * @note If ref_counter is <i>0</i> or <i>SIZE_MAX</i> we will call abort(3).
+ * If ref_counter is <i>CORAL_REF_COUNT_IMMORTAL</i> it is left unchanged.
  */
 void coral$retain(atomic_size_t *ref_counter);
 
+/**
+ * @brief Increase the reference counter by count at once.
+ * @param [in] ref_counter counter to increase.
+ * @param [in] count number of references to add.
+ * @note If ref_counter is <i>0</i> or <i>SIZE_MAX</i> we will call abort(3).
+ * If ref_counter is <i>CORAL_REF_COUNT_IMMORTAL</i> it is left unchanged.
+ */
+void coral$retain_many(atomic_size_t *ref_counter, size_t count);
+
 /**
  * @brief Decrease the reference counter and optionally destroy and free object.
  * @param [in] object instance to deallocate after reference counter
@@ -94,9 +109,25 @@ void coral$retain(atomic_size_t *ref_counter);
  * @param [in] ref_counter counter to decrease.
  * @param [in] destroy function to call to release resources used by object.
  * @note If object, ref_counter<i>NULL</i> or ref_counter is <i>0</i> we
- * will call abort(3).
+ * will call abort(3). If ref_counter is <i>CORAL_REF_COUNT_IMMORTAL</i> it is
+ * left unchanged.
  */
 void coral$release(void *object, atomic_size_t *ref_counter,
                    void(*on_destroy)(void *object));
 
+/**
+ * @brief Decrease the reference counter by count at once and optionally
+ * destroy and free object.
+ * @param [in] object instance to deallocate after reference counter
+ * indicated that object is not in use anymore.
+ * @param [in] ref_counter counter to decrease.
+ * @param [in] count number of references to release.
+ * @param [in] destroy function to call to release resources used by object.
+ * @note If object, ref_counter is <i>NULL</i> or ref_counter is less than
+ * count we will call abort(3). If ref_counter is
+ * <i>CORAL_REF_COUNT_IMMORTAL</i> it is left unchanged.
+ */
+void coral$release_many(void *object, atomic_size_t *ref_counter,
+                        size_t count, void(*on_destroy)(void *object));
+
 #endif /* _CORAL_PRIVATE_CORAL_H_ */
@@ -0,0 +1,28 @@
+#ifndef _CORAL_PRIVATE_INLINE_CACHE_H_
+#define _CORAL_PRIVATE_INLINE_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+struct coral_class;
+struct coral_inline_cache;
+
+/**
+ * @brief Retrieve the invokable of the cached selector for class.
+ * <p>On a miss the method is looked up on class and cached if class is
+ * frozen.</p>
+ * @param [in] object inline cache.
+ * @param [in] class of the receiver.
+ * @param [out] out receive the invokable.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_METHOD_NOT_FOUND if the method could not be found.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if class is uninitialized or
+ * (being) destroyed.
+ * @note If object, class or out is <i>NULL</i> we will call abort(3).
+ */
+bool coral$inline_cache$get(struct coral_inline_cache *object,
+                            struct coral_class *class,
+                            bool (**out)(void *this, void *data, void *args));
+
+#endif /* _CORAL_PRIVATE_INLINE_CACHE_H_ */
@@ -0,0 +1,18 @@
+#ifndef _CORAL_PRIVATE_NOTIFICATION_DISPATCHER_H_
+#define _CORAL_PRIVATE_NOTIFICATION_DISPATCHER_H_
+
+#include <stdbool.h>
+
+/**
+ * @brief Queue the notification for delivery by the workers.
+ * <p>Object is retained until the notification has been delivered.</p>
+ * @param [in] object instance that is posting.
+ * @param [in] notification that is being posted.
+ * @return true if the notification was queued, otherwise false and the
+ * caller must deliver it.
+ * @note If object or notification is <i>NULL</i> we will call abort(3).
+ */
+bool coral$notification_dispatcher$post(void *object,
+                                        const char *notification);
+
+#endif /* _CORAL_PRIVATE_NOTIFICATION_DISPATCHER_H_ */
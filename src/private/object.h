@@ -22,15 +22,114 @@ bool coral$object$get_class(struct coral_object *object,
 
 bool coral$object$get_ref_count(struct coral_object *object, size_t *out);
 
-void
-coral$object_add_observer(struct coral_object *object, void *observer,
-                          const char *event,
-                          void(*on_event)(void *sender, const char *event));
+/**
+ * @brief Make object immortal.
+ * <p>Retaining or releasing an immortal object has no effect, it stays
+ * alive until it is explicitly destroyed. Meant for instances that live as
+ * long as the process, such as classes, which are shared by every thread.</p>
+ * @param [in] object instance to make immortal.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is uninitialized or
+ * (being) destroyed.
+ */
+bool coral$object$set_immortal(void *object);
 
-void
-coral$object_remove_observer(struct coral_object *object, void *observer,
-                             const char *event);
+/**
+ * @brief Release count references of object with a single atomic operation.
+ * @param [in] object instance to release.
+ * @param [in] count number of references to release.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is uninitialized or
+ * (being) destroyed.
+ * @note If object is <i>NULL</i> or holds fewer than count references we
+ * will call abort(3).
+ */
+bool coral$object$release_many(void *object, size_t count);
 
+/**
+ * @brief Copy method for classes whose instances must not be copied.
+ * <p>Copies share the payload of their source until they are first written
+ * to, registering this as the copy method makes coral_object_copy fail
+ * straight away instead.</p>
+ * @return false as copying is not allowed.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE always.
+ */
+bool coral$object$copy_is_unavailable(void *this, void *data, void *args);
+
+/**
+ * @brief Retrieve the data that the invokables of object operate on.
+ * <p>A copy that has not yet been written to uses the data of its source,
+ * objects other than <i>this</i> must be resolved before their data is read
+ * directly.</p>
+ * @param [in] object instance.
+ * @return data of object or of the source whose data it is sharing.
+ * @note If object is <i>NULL</i> we will call abort(3).
+ */
+void *coral$object$get_data(void *object);
+
+/**
+ * @brief Add an observer for the notifications posted by object.
+ * <p>Observers are called on the thread that posts the notification, which
+ * may be holding the lock of object, and must therefore neither block nor
+ * invoke object with readonly set to false. While the notification
+ * dispatcher is running they are instead called on one of its workers.</p>
+ * @param [in] object instance to observe.
+ * @param [in] observer identifies the subscription and is passed back to
+ * on_event.
+ * @param [in] event notification to observe or <i>NULL</i> for all of them.
+ * @param [in] on_event called for every matching notification.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is uninitialized or
+ * (being) destroyed.
+ * @throws CORAL_ERROR_OBJECT_ALREADY_EXISTS if observer is already observing
+ * event.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to add the observer.
+ * @note If object, observer or on_event is <i>NULL</i> we will call abort(3).
+ */
+bool coral$object_add_observer(void *object,
+                               void *observer,
+                               const char *event,
+                               void (*on_event)(void *observer,
+                                                void *object,
+                                                const char *event));
+
+/**
+ * @brief Remove an observer from object.
+ * @param [in] object instance being observed.
+ * @param [in] observer whose subscription is to be removed.
+ * @param [in] event notification to no longer observe or <i>NULL</i> to
+ * remove every subscription of observer.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_IS_UNINITIALIZED if object is uninitialized or
+ * (being) destroyed.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if observer is not observing event.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to remove the observer.
+ * @note If object or observer is <i>NULL</i> we will call abort(3).
+ */
+bool coral$object_remove_observer(void *object,
+                                  void *observer,
+                                  const char *event);
+
+/**
+ * @brief Post notification to the observers of object.
+ * <p>When object has no observers this costs a single atomic load, otherwise
+ * the notification is handed to the notification dispatcher if it is
+ * running or else delivered right away.</p>
+ * @param [in] object instance that is posting.
+ * @param [in] notification that is being posted.
+ * @note If object or notification is <i>NULL</i> we will call abort(3).
+ */
 void coral$object_post_notification(void *object, const char *notification);
 
+/**
+ * @brief Deliver notification to the observers of object right away.
+ * @param [in] object instance that posted.
+ * @param [in] notification that was posted.
+ * @note If object or notification is <i>NULL</i> we will call abort(3).
+ */
+void coral$object$notify(void *object, const char *notification);
+
 #endif /* _CORAL_PRIVATE_OBJECT_H_ */
\ No newline at end of file
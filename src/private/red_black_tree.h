@@ -9,6 +9,9 @@
 
 #define CORAL_RED_BLACK_TREE_COLOR_RED                          0
 #define CORAL_RED_BLACK_TREE_COLOR_BLACK                        1
+/* Nodes of a counted tree keep the count of the nodes in their subtree just
+ * in front of them, which is flagged in their parent pointer by this bit */
+#define CORAL_RED_BLACK_TREE_NODE_IS_COUNTED                    2
 
 #define CORAL_RED_BLACK_TREE_ERROR_Y_IS_NULL                    1
 #define CORAL_RED_BLACK_TREE_ERROR_Y_HAS_NO_PARENT              2
@@ -18,8 +21,14 @@
 #define CORAL_RED_BLACK_TREE_ERROR_X_IS_NOT_LEFT_CHILD_OF_Z     6
 #define CORAL_RED_BLACK_TREE_ERROR_X_IS_NOT_RIGHT_CHILD_OF_Z    7
 
+/* Bytes of the first and of the largest slab that a node pool carves nodes
+ * out of, every new slab is twice the size of the one before it */
+#define CORAL_RED_BLACK_TREE_POOL_SLAB_SIZE_MINIMUM             ((size_t) 1024)
+#define CORAL_RED_BLACK_TREE_POOL_SLAB_SIZE_MAXIMUM             \
+    ((size_t) 64 * 1024)
+
 struct coral$red_black_tree$node {
-    void *parent; /* color bit is stored in the lowest bit */
+    void *parent; /* color bit is stored in the lowest bit, counted in next */
     void *left;
     void *right;
 };
@@ -249,10 +258,15 @@ bool coral$red_black_tree$rotate_left_right(void *node);
  */
 bool coral$red_black_tree$rotate_right_left(void *node);
 
+struct coral$red_black_tree$pool;
+
 struct coral$red_black_tree {
     void *root;
 
     int (*compare)(const void *, const void *);
+    /* created on the first coral$red_black_tree$pool_alloc */
+    struct coral$red_black_tree$pool *pool;
+    bool is_counted;
 };
 
 /**
@@ -280,12 +294,34 @@ bool coral$red_black_tree$init(struct coral$red_black_tree *object,
                                int (*compare)(const void *first,
                                               const void *second));
 
+/**
+ * @brief Initialise the red black tree instance to count its nodes.
+ * <p>Every node keeps the count of the nodes in its subtree, which is kept
+ * up to date by insert, delete and the rotations, so that a node can be
+ * found by its index and the index of a value worked out in O(log n). The
+ * nodes must come from the node pool of the tree, as only those have room
+ * for the count.</p>
+ * @param [in] object instance to be initialised.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if the <u>first node</u> is considered
+ * to be respectively less than, equal to, or greater than the <u>second
+ * node</u>.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if compare is <i>NULL</i>.
+ */
+bool coral$red_black_tree$init_counted(struct coral$red_black_tree *object,
+                                       int (*compare)(const void *first,
+                                                      const void *second));
+
 /**
  * @brief Invalidate the red black tree instance.
  * <p>The nodes in the red black tree are destroyed and each will invoke the
  * provided <i>on node destroy</i> callback. The actual <u>red black tree
  * instance is not deallocated</u> since it may have been embedded in a larger
- * structure.
+ * structure. If the nodes came from the node pool of the tree, all its slabs
+ * are released at once and the nodes are only visited if there is an
+ * <i>on node destroy</i> callback.</p>
  * @param [in] object instance to be invalidated.
  * @param [in] on_node_destroy called just before the node is to be destroyed.
  * @return On success true, otherwise false if an error has occurred.
@@ -336,6 +372,37 @@ bool coral$red_black_tree$search(struct coral$red_black_tree *object,
                                  const void *root, const void *value,
                                  void **out);
 
+/**
+ * @brief Retrieve the node at index.
+ * @param [in] object instance of a counted red black tree.
+ * @param [in] at zero based index of the node in ascending order.
+ * @param [out] out receive the node at index.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the red black tree is not counted.
+ * @throws CORAL_ERROR_INDEX_OUT_OF_BOUNDS if at is not less than the count
+ * of nodes.
+ */
+bool coral$red_black_tree$get_at(struct coral$red_black_tree *object,
+                                 size_t at, void **out);
+
+/**
+ * @brief Retrieve the count of nodes that are less than value.
+ * <p>Value need not be in the red black tree, if it is then the count is
+ * also its index.</p>
+ * @param [in] object instance of a counted red black tree.
+ * @param [in] value whose rank we want.
+ * @param [out] out receive the count of nodes less than value.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if either value or out is
+ * <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the red black tree is not counted.
+ */
+bool coral$red_black_tree$rank_of(struct coral$red_black_tree *object,
+                                  const void *value, size_t *out);
+
 /**
  * @brief Insert node.
  * @param [in] object instance of red black tree which node is to be inserted.
@@ -347,6 +414,8 @@ bool coral$red_black_tree$search(struct coral$red_black_tree *object,
  * the red black tree instance is not empty) or node is <i>NULL</i>.
  * @throws CORAL_ERROR_OBJECT_ALREADY_EXISTS if node is already present in
  * the red black tree instance.
+ * @throws CORAL_ERROR_INVALID_VALUE if the red black tree is counted and the
+ * node is not, or the other way around.
  */
 bool coral$red_black_tree$insert(struct coral$red_black_tree *object,
                                  void *insertion_point, void *node);
@@ -362,4 +431,61 @@ bool coral$red_black_tree$insert(struct coral$red_black_tree *object,
 bool coral$red_black_tree$delete(struct coral$red_black_tree *object,
                                  void *node);
 
+/**
+ * @brief Build the red black tree out of nodes in linear time.
+ * <p>The nodes are linked into a tree that is as balanced as it can be, the
+ * middle node of each run becoming the root of the subtree over that run,
+ * and only the nodes of an incomplete last level are coloured red. No
+ * rotations are performed and each node is compared just once, against the
+ * one before it, to make sure that the nodes are strictly ascending.</p>
+ * @param [in] object instance of red black tree which must be empty.
+ * @param [in] nodes to be linked into the tree, in ascending order without
+ * duplicates.
+ * @param [in] count of nodes.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if nodes is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the red black tree is not empty.
+ * @throws CORAL_ERROR_INVALID_VALUE if a node is not greater than the node
+ * before it, or is counted while the red black tree is not or the other way
+ * around, in which case the red black tree is left empty.
+ */
+bool coral$red_black_tree$build(struct coral$red_black_tree *object,
+                                void **nodes, size_t count);
+
+/**
+ * @brief Create node instance out of the node pool of the tree.
+ * <p>Nodes are carved out of slabs that belong to the tree and nodes that
+ * have been deleted are reused. All the nodes of a tree must either come from
+ * its node pool or none at all, those that do are given back by
+ * coral$red_black_tree$delete and coral$red_black_tree$invalidate releases
+ * all the slabs at once. Nodes of a counted tree come with room for the count
+ * of their subtree.</p>
+ * @param [in] object tree instance whose node pool the node comes from.
+ * @param [in] size bytes needed to be allocated for node instance.
+ * @param [out] out receive the created node instance.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if size differs from the size of the
+ * nodes that the node pool already holds.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to allocate the node instance.
+ */
+bool coral$red_black_tree$pool_alloc(struct coral$red_black_tree *object,
+                                     size_t size, void **out);
+
+/**
+ * @brief Give node instance back to the node pool of the tree.
+ * <p>The node will be reused by the next coral$red_black_tree$pool_alloc.</p>
+ * @param [in] object tree instance whose node pool the node came from.
+ * @param [in] node instance that is not, or no longer, part of the tree.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if node is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the tree has no node pool.
+ */
+bool coral$red_black_tree$pool_free(struct coral$red_black_tree *object,
+                                    void *node);
+
 #endif /* _CORAL_PRIVATE_RED_BLACK_TREE_H_ */
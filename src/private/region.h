@@ -0,0 +1,10 @@
+#ifndef _CORAL_PRIVATE_REGION_H_
+#define _CORAL_PRIVATE_REGION_H_
+
+#include <stddef.h>
+
+/* Size in bytes of the chunks that regions bump allocate from, blocks larger
+ * than a quarter of it are given a chunk of their own */
+#define CORAL_REGION_CHUNK_SIZE         ((size_t) 64 * 1024)
+
+#endif /* _CORAL_PRIVATE_REGION_H_ */
@@ -0,0 +1,38 @@
+#ifndef _CORAL_PRIVATE_SELECTOR_H_
+#define _CORAL_PRIVATE_SELECTOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+struct coral_selector;
+
+/**
+ * @brief Retrieve the selector for the given method name, registering it if
+ * need be.
+ * @param [in] data of the method name, need not be nul-terminated.
+ * @param [in] size of the method name.
+ * @param [out] out receive the selector.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to register the selector.
+ * @note If data or out is <i>NULL</i> or size is <i>ZERO</i> we will call
+ * abort(3).
+ */
+bool coral$selector$of(const char *data, size_t size,
+                       const struct coral_selector **out);
+
+/**
+ * @brief Find the selector of an already registered method name.
+ * <p>Lookups do not take any lock.</p>
+ * @param [in] data of the method name, need not be nul-terminated.
+ * @param [in] size of the method name.
+ * @param [out] out receive the selector.
+ * @return true if the selector was found, otherwise false.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if the name was never registered.
+ * @note If data or out is <i>NULL</i> we will call abort(3).
+ */
+bool coral$selector$find(const char *data, size_t size,
+                         const struct coral_selector **out);
+
+#endif /* _CORAL_PRIVATE_SELECTOR_H_ */
@@ -0,0 +1,73 @@
+#ifndef _CORAL_PRIVATE_SLAB_H_
+#define _CORAL_PRIVATE_SLAB_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Size in bytes, and alignment, of a single slab */
+#define CORAL_SLAB_SIZE                 ((size_t) 64 * 1024)
+/* Block sizes are multiples of this granularity */
+#define CORAL_SLAB_GRANULARITY          ((size_t) 16)
+/* Largest block that will be served from a slab */
+#define CORAL_SLAB_MAXIMUM_BLOCK_SIZE   ((size_t) 512)
+/* Empty slabs kept by each heap before they are returned to the OS */
+#define CORAL_SLAB_MAXIMUM_EMPTY        ((size_t) 32)
+
+/* Slab allocator: https://en.wikipedia.org/wiki/Slab_allocation
+ *
+ * Every thread owns a heap of slabs, one list per size class. Allocation and
+ * deallocation by the owning thread are done without any atomic operations.
+ * Blocks freed by any other thread are pushed onto the slab's remote free
+ * list and collected by the owner when it runs out of free blocks. Slabs that
+ * become empty are kept for reuse by any size class, up to a small limit, and
+ * beyond that are returned to the operating system. Heaps are never freed,
+ * when a thread exits its heap is abandoned and later adopted by the next new
+ * thread that needs one. */
+
+struct coral$slab$statistics {
+    size_t allocations;
+    size_t deallocations;
+    size_t remote_deallocations;
+    size_t slabs_mapped;
+    size_t slabs_unmapped;
+    size_t bytes_mapped;
+};
+
+/**
+ * @brief Check if a block of the given size can be served from a slab.
+ * @param [in] size in bytes of the block.
+ * @return true if size is served by the slab allocator, otherwise false.
+ */
+bool coral$slab$is_eligible(size_t size);
+
+/**
+ * @brief Allocate a zeroed block from the calling thread's slab heap.
+ * @param [in] size in bytes of the block.
+ * @param [out] out receive the block.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_INVALID_VALUE if size is zero or is not eligible to be
+ * served by the slab allocator.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to allocate a new slab.
+ * @note If out is <i>NULL</i> we will call abort(3).
+ */
+bool coral$slab$alloc(size_t size, void **out);
+
+/**
+ * @brief Return a block to the slab that it was allocated from.
+ * <p>The block may be freed from any thread.</p>
+ * @param [in] block previously allocated with coral$slab$alloc.
+ * @note If block is <i>NULL</i> we will call abort(3).
+ */
+void coral$slab$free(void *block);
+
+/**
+ * @brief Retrieve the allocation statistics of the calling thread.
+ * <p>The bytes mapped are for all slabs currently mapped by the process.</p>
+ * @param [out] out receive the statistics.
+ * @note If out is <i>NULL</i> we will call abort(3).
+ */
+void coral$slab$get_statistics(struct coral$slab$statistics *out);
+
+#endif /* _CORAL_PRIVATE_SLAB_H_ */
@@ -43,6 +43,34 @@ bool coral$tree_map$init(struct coral$tree_map *object,
                          int (*compare)(const void *first,
                                         const void *second));
 
+/**
+ * @brief Initialize the tree map instance to keep its entries in engine.
+ * @param [in] object instance to be initialized.
+ * @param [in] limit range values used to provide a lower and upper limit to
+ * the number of entries contained within the tree map.
+ * @param [in] key_size length in bytes of the key.
+ * @param [in] value_size length in bytes of the value.
+ * @param [in] engine one of <i>CORAL_TREE_SET_ENGINE_RED_BLACK_TREE</i>,
+ * <i>CORAL_TREE_SET_ENGINE_B_TREE</i>,
+ * <i>CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE</i> or
+ * <i>CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE</i>.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if the <u>first entry</u> is considered
+ * to be respectively less than, equal to, or greater than the <u>second
+ * entry</u>.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if compare is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if engine is not one of the above.
+ */
+bool coral$tree_map$init_with_engine(struct coral$tree_map *object,
+                                     struct coral_range_values *limit,
+                                     size_t key_size,
+                                     size_t value_size,
+                                     int engine,
+                                     int (*compare)(const void *first,
+                                                    const void *second));
+
 /**
  * @brief Invalidate the tree map instance.
  * <p>The entries in the tree map are destroyed and each will invoke the
@@ -111,6 +139,49 @@ bool coral$tree_map$get_value_size(struct coral$tree_map *object, size_t *out);
  */
 bool coral$tree_map$insert(struct coral$tree_map *object, const void *entry);
 
+/**
+ * @brief Build an empty tree map out of entries sorted by key.
+ * @param [in] object instance which is to be built.
+ * @param [in] entries array whose entries are copied into the tree map, in
+ * ascending order of key without duplicate keys.
+ * @return On success true, otherwise false if an error has occurred and the
+ * tree map is left empty.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if entries is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the size of the entries is not the
+ * size of key and value or the entries are not in strictly ascending order of
+ * key.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the tree map is not empty or the
+ * count of entries will exceed the upper limit on the total number of
+ * instances allowed.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to hold the entries.
+ * @see coral$tree_set$build(...)
+ */
+bool coral$tree_map$build(struct coral$tree_map *object,
+                          struct coral$array *entries);
+
+/**
+ * @brief Build an empty tree map out of entries in any order.
+ * @param [in] object instance which is to be built.
+ * @param [in] entries array whose entries are copied into the tree map.
+ * @return On success true, otherwise false if an error has occurred and the
+ * tree map is left empty.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if entries is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the size of the entries is not the
+ * size of key and value.
+ * @throws CORAL_ERROR_OBJECT_ALREADY_EXISTS if a key occurs more than once.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the tree map is not empty or the
+ * count of entries will exceed the upper limit on the total number of
+ * instances allowed.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to hold the entries.
+ * @see coral$tree_set$build_unsorted(...)
+ */
+bool coral$tree_map$build_unsorted(struct coral$tree_map *object,
+                                   struct coral$array *entries);
+
 /**
  * @brief Delete entry from tree map.
  * @param [in] object instance where we would like to delete the entry.
@@ -178,6 +249,37 @@ bool coral$tree_map$set(struct coral$tree_map *object, const void *entry);
  */
 bool coral$tree_map$get_first(struct coral$tree_map *object, void **out);
 
+/**
+ * @brief Retrieve the entry at index.
+ * @param [in] object instance of tree map whose entry we would like to
+ * retrieve.
+ * @param [in] at zero based index of the entry in ascending order of key.
+ * @param [out] out receive the entry at index.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the tree map does not use the
+ * <i>CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE</i> engine.
+ * @throws CORAL_ERROR_INDEX_OUT_OF_BOUNDS if at is not less than the count
+ * of entries.
+ */
+bool coral$tree_map$get_at(struct coral$tree_map *object, size_t at,
+                           void **out);
+
+/**
+ * @brief Retrieve the count of entries whose key is less than key.
+ * @param [in] object instance of tree map whose entries are to be counted.
+ * @param [in] key whose rank we want, which need not be in the tree map.
+ * @param [out] out receive the count of entries with a lesser key.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if key or out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the tree map does not use the
+ * <i>CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE</i> engine.
+ */
+bool coral$tree_map$rank_of(struct coral$tree_map *object, const void *key,
+                            size_t *out);
+
 /**
  * @brief Retrieve the last entry in the tree map.
  * @param [in] object instance of tree map whose last entry we would like to
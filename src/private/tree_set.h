@@ -7,6 +7,8 @@
 #include <stdatomic.h>
 
 #include "red_black_tree.h"
+#include "b_tree.h"
+#include "compact_red_black_tree.h"
 #include "range.h"
 
 #define CORAL_CLASS_LOAD_PRIORITY_TREE_SET \
@@ -14,12 +16,19 @@
 
 /* Set: https://en.wikipedia.org/wiki/Set_(abstract_data_type) */
 
+struct coral$array;
+
 struct coral$tree_set {
     atomic_size_t id;
     struct coral_range_values limit;
     size_t count;
     size_t size;
-    struct coral$red_black_tree tree;
+    int engine;
+    union {
+        struct coral$red_black_tree tree;
+        struct coral$b_tree b_tree;
+        struct coral$compact_red_black_tree compact_tree;
+    };
 };
 
 /**
@@ -40,6 +49,31 @@ bool coral$tree_set$init(struct coral$tree_set *object,
                          size_t size,
                          int (*compare)(const void *, const void *));
 
+/**
+ * @brief Initialize the tree set instance to keep its members in engine.
+ * @param [in] object instance to be initialized.
+ * @param [in] limit range values used to provide a lower and upper limit to
+ * the number of items contained within the tree set.
+ * @param [in] size in bytes of the members of the set.
+ * @param [in] engine one of <i>CORAL_TREE_SET_ENGINE_RED_BLACK_TREE</i>,
+ * <i>CORAL_TREE_SET_ENGINE_B_TREE</i>,
+ * <i>CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE</i> or
+ * <i>CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE</i>.
+ * @param [in] compare comparison which must return an integer less than,
+ * equal to, or greater than zero if <u>first</u> is considered to be
+ * respectively less than, equal to, or greater than the <u>second</u>.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if compare is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if engine is not one of the above.
+ */
+bool coral$tree_set$init_with_engine(struct coral$tree_set *object,
+                                     struct coral_range_values *limit,
+                                     size_t size,
+                                     int engine,
+                                     int (*compare)(const void *,
+                                                    const void *));
+
 /**
  * @brief Invalidate the tree set instance.
  * <p>The items in the tree set are destroyed and each will invoke the
@@ -87,6 +121,52 @@ bool coral$tree_set$get_size(struct coral$tree_set *object, size_t *out);
  */
 bool coral$tree_set$insert(struct coral$tree_set *object, const void *item);
 
+/**
+ * @brief Build an empty tree set out of items that are already sorted.
+ * <p>The members are linked into a balanced tree, or packed into the leaves
+ * of the b tree, in linear time, rather than searching for and rebalancing
+ * after each one in turn.</p>
+ * @param [in] object instance which is to be built.
+ * @param [in] items array whose items are copied into the tree set, in
+ * ascending order without duplicates.
+ * @return On success true, otherwise false if an error has occurred and the
+ * tree set is left empty.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if items is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the size of the items is not the size
+ * of the members or the items are not in strictly ascending order.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the tree set is not empty or the
+ * count of items will exceed the upper limit on the total number of
+ * instances allowed.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to hold the items.
+ */
+bool coral$tree_set$build(struct coral$tree_set *object,
+                          struct coral$array *items);
+
+/**
+ * @brief Build an empty tree set out of items in any order.
+ * <p>The members are sorted once they have been copied, which leaves the
+ * order of the items untouched, and are then built as with
+ * coral$tree_set$build(...).</p>
+ * @param [in] object instance which is to be built.
+ * @param [in] items array whose items are copied into the tree set.
+ * @return On success true, otherwise false if an error has occurred and the
+ * tree set is left empty.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if items is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the size of the items is not the size
+ * of the members.
+ * @throws CORAL_ERROR_OBJECT_ALREADY_EXISTS if an item occurs more than once.
+ * @throws CORAL_ERROR_OBJECT_UNAVAILABLE if the tree set is not empty or the
+ * count of items will exceed the upper limit on the total number of
+ * instances allowed.
+ * @throws CORAL_ERROR_MEMORY_ALLOCATION_FAILED if there is insufficient
+ * memory to hold the items.
+ */
+bool coral$tree_set$build_unsorted(struct coral$tree_set *object,
+                                   struct coral$array *items);
+
 /**
  * @brief Delete item from tree set.
  * @param [in] object instance where we would like to delete the item.
@@ -112,6 +192,20 @@ bool coral$tree_set$delete(struct coral$tree_set *object, const void *item);
 bool coral$tree_set$contains(struct coral$tree_set *object, const void *item,
                              bool *out);
 
+/**
+ * @brief Search for the member that matches item.
+ * @param [in] object instance that is to be searched.
+ * @param [in] item to find in the tree set.
+ * @param [out] out receive the member as held in the tree set, which remains
+ * valid until the tree set is next modified.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if item or out is <i>NULL</i>.
+ * @throws CORAL_ERROR_OBJECT_NOT_FOUND if no member matches item.
+ */
+bool coral$tree_set$search(struct coral$tree_set *object, const void *item,
+                           void **out);
+
 /**
  * @brief Retrieve the first value in the tree set.
  * @param [in] object instance from which we are to fetch the first value.
@@ -123,6 +217,38 @@ bool coral$tree_set$contains(struct coral$tree_set *object, const void *item,
  */
 bool coral$tree_set$get_first(struct coral$tree_set *object, void **out);
 
+/**
+ * @brief Retrieve the value at index.
+ * @param [in] object instance from which we are to fetch the value.
+ * @param [in] at zero based index of the value in ascending order.
+ * @param [out] out receive the value at index.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the tree set does not use the
+ * <i>CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE</i> engine.
+ * @throws CORAL_ERROR_INDEX_OUT_OF_BOUNDS if at is not less than the count
+ * of values.
+ */
+bool coral$tree_set$get_at(struct coral$tree_set *object, size_t at,
+                           void **out);
+
+/**
+ * @brief Retrieve the count of values less than value.
+ * <p>Value need not be in the tree set, if it is then the count is also its
+ * index.</p>
+ * @param [in] object instance whose values are to be counted.
+ * @param [in] value whose rank we want.
+ * @param [out] out receive the count of values less than value.
+ * @return On success true, otherwise false if an error has occurred.
+ * @throws CORAL_ERROR_OBJECT_PTR_IS_NULL if object is <i>NULL</i>.
+ * @throws CORAL_ERROR_ARGUMENT_PTR_IS_NULL if value or out is <i>NULL</i>.
+ * @throws CORAL_ERROR_INVALID_VALUE if the tree set does not use the
+ * <i>CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE</i> engine.
+ */
+bool coral$tree_set$rank_of(struct coral$tree_set *object, const void *value,
+                            size_t *out);
+
 /**
  * @brief Retrieve the last value in the tree set.
  * @param [in] object instance from which we are to fetch the last value.
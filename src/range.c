@@ -3,8 +3,10 @@
 #include <string.h>
 #include <coral.h>
 
+#include "private/allocator.h"
 #include "private/range.h"
 #include "private/class.h"
+#include "private/object.h"
 #include "test/cmocka.h"
 
 #pragma mark private -
@@ -34,7 +36,7 @@ static void $on_load() {
     };
     coral_required_true(coral_class_alloc(&$class));
     coral_required_true(coral_class_init($class));
-    coral_required_true(coral_class_retain($class));
+    coral_required_true(coral$object$set_immortal($class));
     /* destroy */
     coral_required_true(coral_class_method_add(
             $class, &$method_names[0],
@@ -47,6 +49,7 @@ static void $on_load() {
     coral_required_true(coral_class_method_add(
             $class, &$method_names[2],
             (coral_invokable_t) $range_is_equal));
+    coral_required_true(coral_class_freeze($class));
 
     coral_autorelease_pool_drain();
 }
@@ -254,7 +257,7 @@ static bool $range_step_func_rate(const size_t current,
 }
 
 static void $context_on_destroy(void *ptr) {
-    free(ptr);
+    coral$allocator$free(ptr);
 }
 
 bool coral_range_of_delta(struct coral_range **out,
@@ -269,7 +272,8 @@ bool coral_range_of_delta(struct coral_range **out,
         ssize_t **address = NULL;
         if (coral_context_of(&context, $context_on_destroy)
             && coral_context_get(context, (void **) &address)
-            && (*address = malloc(sizeof(**address)))
+            && coral$allocator$alloc(CORAL_ALLOCATOR_TAG_OTHER,
+                                     sizeof(**address), (void **) address)
             && coral_range_init(*out,
                                 values,
                                 $range_step_func_delta,
@@ -296,7 +300,8 @@ bool coral_range_of_rate(struct coral_range **out,
         double **address = NULL;
         if (coral_context_of(&context, $context_on_destroy)
             && coral_context_get(context, (void **) &address)
-            && (*address = malloc(sizeof(**address)))
+            && coral$allocator$alloc(CORAL_ALLOCATOR_TAG_OTHER,
+                                     sizeof(**address), (void **) address)
             && coral_range_init(*out,
                                 values,
                                 $range_step_func_rate,
@@ -1,6 +1,8 @@
 #include <stdlib.h>
+#include <stdalign.h>
 #include <coral.h>
 
+#include "private/allocator.h"
 #include "private/red_black_tree.h"
 #include "test/cmocka.h"
 
@@ -14,6 +16,125 @@ static void coral$red_black_tree$get_minimum(void *root, void **out);
 
 static void coral$red_black_tree$get_maximum(void *root, void **out);
 
+static void coral$red_black_tree$node_release(
+        struct coral$red_black_tree *object, void *node);
+
+static void *coral$red_black_tree$build_N(void **nodes, size_t count,
+                                          void *parent, size_t depth,
+                                          size_t red);
+
+static bool coral$red_black_tree$node_is_counted(void *node);
+
+static size_t *coral$red_black_tree$node_count(void *node);
+
+static size_t coral$red_black_tree$count_of(void *node);
+
+static void coral$red_black_tree$count_path(void *node, bool is_added);
+
+struct coral$red_black_tree$slab {
+    struct coral$red_black_tree$slab *next;
+    alignas(struct coral$red_black_tree$node) unsigned char data[];
+};
+
+/* Nodes that are given back are linked through their left child until they
+ * are reused. */
+struct coral$red_black_tree$pool {
+    struct coral$red_black_tree$slab *slabs;
+    struct coral$red_black_tree$node *available;
+    size_t size;
+    size_t stride;
+    size_t offset; /* of the node within its stride, past its count */
+    size_t slab_size;
+    unsigned char *cursor;
+    unsigned char *end;
+};
+
+static void coral$red_black_tree$pool_release(
+        struct coral$red_black_tree$pool *pool) {
+    coral_required(pool);
+    for (struct coral$red_black_tree$slab *slab = pool->slabs; slab;) {
+        struct coral$red_black_tree$slab *next = slab->next;
+        coral$allocator$free(slab);
+        slab = next;
+    }
+    coral$allocator$free(pool);
+}
+
+static bool coral$red_black_tree$pool_of(
+        const size_t size, const bool is_counted,
+        struct coral$red_black_tree$pool **out) {
+    coral_required(out);
+    const size_t alignment = alignof(struct coral$red_black_tree$node);
+    const size_t offset = is_counted ? sizeof(size_t) : 0;
+    size_t size_;
+    if (!coral_add_size_t(size, offset
+                                + sizeof(struct coral$red_black_tree$node)
+                                + alignment - 1, &size_)) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    struct coral$red_black_tree$pool *pool;
+    if (!coral$allocator$calloc(CORAL_ALLOCATOR_TAG_TREE_NODE, 1,
+                                sizeof(*pool), (void **) &pool)) {
+        return false;
+    }
+    pool->size = size;
+    pool->stride = size_ - size_ % alignment;
+    pool->offset = offset;
+    pool->slab_size = CORAL_RED_BLACK_TREE_POOL_SLAB_SIZE_MINIMUM;
+    *out = pool;
+    return true;
+}
+
+static bool coral$red_black_tree$pool_take(
+        struct coral$red_black_tree$pool *pool,
+        struct coral$red_black_tree$node **out) {
+    coral_required(pool);
+    coral_required(out);
+    struct coral$red_black_tree$node *node = pool->available;
+    if (node) {
+        pool->available = node->left;
+        *out = node;
+        return true;
+    }
+    if (pool->stride > (size_t) (pool->end - pool->cursor)) {
+        const size_t header = sizeof(struct coral$red_black_tree$slab);
+        size_t size = pool->slab_size;
+        while (size - header < pool->stride) {
+            if (!coral_multiply_size_t(size, 2, &size)) {
+                coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+                return false;
+            }
+        }
+        struct coral$red_black_tree$slab *slab;
+        if (!coral$allocator$alloc(CORAL_ALLOCATOR_TAG_TREE_NODE, size,
+                                   (void **) &slab)) {
+            return false;
+        }
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        pool->cursor = slab->data;
+        pool->end = (unsigned char *) slab + size;
+        if (size < CORAL_RED_BLACK_TREE_POOL_SLAB_SIZE_MAXIMUM) {
+            pool->slab_size = 2 * size;
+        }
+    }
+    *out = (struct coral$red_black_tree$node *) (pool->cursor + pool->offset);
+    pool->cursor += pool->stride;
+    return true;
+}
+
+static void coral$red_black_tree$node_release(
+        struct coral$red_black_tree *object, void *node) {
+    coral_required(object);
+    coral_required(node);
+    if (object->pool) {
+        coral_required_true(coral$red_black_tree$pool_free(object, node));
+    } else {
+        coral_required_true(coral$red_black_tree$node_destroy(node));
+    }
+}
+
 struct coral$red_black_tree$node *coral$red_black_tree$node_from(void *node) {
     coral_required(node);
     const char *node_ = node;
@@ -27,12 +148,38 @@ void *coral$red_black_tree$node_to(struct coral$red_black_tree$node *node) {
     return (void *) (node_ + sizeof(struct coral$red_black_tree$node));
 }
 
+static bool coral$red_black_tree$node_is_counted(void *node) {
+    coral_required(node);
+    struct coral$red_black_tree$node *node_;
+    node_ = coral$red_black_tree$node_from(node);
+    return (size_t) node_->parent & CORAL_RED_BLACK_TREE_NODE_IS_COUNTED;
+}
+
+static size_t *coral$red_black_tree$node_count(void *node) {
+    coral_required(node);
+    return (size_t *) coral$red_black_tree$node_from(node) - 1;
+}
+
+static size_t coral$red_black_tree$count_of(void *node) {
+    return node ? *coral$red_black_tree$node_count(node) : 0;
+}
+
+/* Add or take away one from the count of node and of each of its ancestors. */
+static void coral$red_black_tree$count_path(void *node, const bool is_added) {
+    while (node) {
+        size_t *count = coral$red_black_tree$node_count(node);
+        *count = is_added ? *count + 1 : *count - 1;
+        coral_required_true(coral$red_black_tree$node_get_parent(
+                node, &node));
+    }
+}
+
 bool coral$red_black_tree$node_of(size_t size, void **out) {
     if (coral$red_black_tree$node_alloc(size, out)) {
         if (coral$red_black_tree$node_init(*out)) {
             return true;
         }
-        free(*out);
+        coral$red_black_tree$node_destroy(*out);
         *out = NULL;
     }
     return false;
@@ -49,9 +196,8 @@ bool coral$red_black_tree$node_alloc(const size_t size, void **out) {
         coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
         return false;
     }
-    node_ = calloc(1, size_);
-    if (!node_) {
-        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+    if (!coral$allocator$calloc(CORAL_ALLOCATOR_TAG_TREE_NODE, 1, size_,
+                                (void **) &node_)) {
         return false;
     }
     *out = coral$red_black_tree$node_to(node_);
@@ -75,7 +221,7 @@ bool coral$red_black_tree$node_destroy(void *node) {
     if (node) {
         struct coral$red_black_tree$node *node_;
         node_ = coral$red_black_tree$node_from(node);
-        free(node_);
+        coral$allocator$free(node_);
     }
     return true;
 }
@@ -91,7 +237,9 @@ bool coral$red_black_tree$node_get_parent(void *node, void **out) {
     }
     struct coral$red_black_tree$node *node_;
     node_ = coral$red_black_tree$node_from(node);
-    *out = (void *) ((size_t) node_->parent & ~1);
+    *out = (void *) ((size_t) node_->parent
+                     & ~(size_t) (CORAL_RED_BLACK_TREE_COLOR_BLACK
+                                  | CORAL_RED_BLACK_TREE_NODE_IS_COUNTED));
     return true;
 }
 
@@ -102,10 +250,11 @@ bool coral$red_black_tree$node_set_parent(void *node, void *parent) {
     }
     struct coral$red_black_tree$node *node_;
     node_ = coral$red_black_tree$node_from(node);
-    bool color;
-    coral_required_true(coral$red_black_tree$node_get_color(
-            node, &color));
-    const size_t value = (size_t) parent | color;
+    /* keep both the color and whether the node is counted */
+    const size_t bits = (size_t) node_->parent
+                        & (CORAL_RED_BLACK_TREE_COLOR_BLACK
+                           | CORAL_RED_BLACK_TREE_NODE_IS_COUNTED);
+    const size_t value = (size_t) parent | bits;
     node_->parent = (struct coral$red_black_tree$node *) value;
     return true;
 }
@@ -320,6 +469,16 @@ static bool coral$red_black_tree$rotate_N(void *Y, const bool is_N_left) {
         coral_required_true(set_P(Y, p));
     }
     coral_required_true(set_N(Y, X) && set_P(X, Y));
+    if (coral$red_black_tree$node_is_counted(Y)) {
+        /* Y now spans what X used to, X just its two lower subtrees */
+        void *a;
+        coral_required_true(get_N(X, &a));
+        *coral$red_black_tree$node_count(Y) =
+                *coral$red_black_tree$node_count(X);
+        *coral$red_black_tree$node_count(X) =
+                1 + coral$red_black_tree$count_of(a)
+                + coral$red_black_tree$count_of(b);
+    }
     return true;
 }
 
@@ -410,12 +569,8 @@ bool coral$red_black_tree$alloc(struct coral$red_black_tree **out) {
         coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
         return false;
     }
-    *out = calloc(1, sizeof(**out));
-    if (!*out) {
-        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
-        return false;
-    }
-    return true;
+    return coral$allocator$calloc(CORAL_ALLOCATOR_TAG_OTHER, 1, sizeof(**out),
+                                  (void **) out);
 }
 
 bool coral$red_black_tree$init(struct coral$red_black_tree *object,
@@ -430,6 +585,18 @@ bool coral$red_black_tree$init(struct coral$red_black_tree *object,
         return false;
     }
     object->compare = compare;
+    object->pool = NULL;
+    object->is_counted = false;
+    return true;
+}
+
+bool coral$red_black_tree$init_counted(struct coral$red_black_tree *object,
+                                       int (*compare)(const void *first,
+                                                      const void *second)) {
+    if (!coral$red_black_tree$init(object, compare)) {
+        return false;
+    }
+    object->is_counted = true;
     return true;
 }
 
@@ -439,7 +606,10 @@ bool coral$red_black_tree$invalidate(struct coral$red_black_tree *object,
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
         return false;
     }
-    for (void *node = object->root; node;) {
+    /* pooled nodes are released together with their slabs, so we only need
+     * to visit them if there is something to be done for each one */
+    void *node = object->pool && !on_node_destroy ? NULL : object->root;
+    while (node) {
         void *next;
         coral_required_true(coral$red_black_tree$node_get_left(
                 node, &next));
@@ -462,11 +632,18 @@ bool coral$red_black_tree$invalidate(struct coral$red_black_tree *object,
         if (on_node_destroy) {
             on_node_destroy(node);
         }
-        coral_required_true(coral$red_black_tree$node_destroy(node));
+        if (!object->pool) {
+            coral_required_true(coral$red_black_tree$node_destroy(node));
+        }
         node = next;
     }
+    if (object->pool) {
+        coral$red_black_tree$pool_release(object->pool);
+        object->pool = NULL;
+    }
     object->root = NULL;
     object->compare = NULL;
+    object->is_counted = false;
     return true;
 }
 
@@ -565,6 +742,75 @@ bool coral$red_black_tree$search(struct coral$red_black_tree *object,
     return false;
 }
 
+bool coral$red_black_tree$get_at(struct coral$red_black_tree *object,
+                                 size_t at, void **out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (!object->is_counted) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    if (at >= coral$red_black_tree$count_of(object->root)) {
+        coral_error = CORAL_ERROR_INDEX_OUT_OF_BOUNDS;
+        return false;
+    }
+    void *node = object->root;
+    while (true) {
+        struct coral$red_black_tree$node *node_;
+        node_ = coral$red_black_tree$node_from(node);
+        const size_t left = coral$red_black_tree$count_of(node_->left);
+        if (at < left) {
+            node = node_->left;
+        } else if (at > left) {
+            at -= 1 + left;
+            node = node_->right;
+        } else {
+            *out = node;
+            return true;
+        }
+    }
+}
+
+bool coral$red_black_tree$rank_of(struct coral$red_black_tree *object,
+                                  const void *value, size_t *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!value || !out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (!object->is_counted) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    size_t rank = 0;
+    for (void *node = object->root; node;) {
+        struct coral$red_black_tree$node *node_;
+        node_ = coral$red_black_tree$node_from(node);
+        const int result = object->compare(value, node);
+        if (result > 0) {
+            /* node and all that are to its left are less than value */
+            rank += 1 + coral$red_black_tree$count_of(node_->left);
+            node = node_->right;
+        } else if (result < 0) {
+            node = node_->left;
+        } else {
+            rank += coral$red_black_tree$count_of(node_->left);
+            break;
+        }
+    }
+    *out = rank;
+    return true;
+}
+
 bool coral$red_black_tree$insert(struct coral$red_black_tree *object,
                                  void *parent, void *child) {
     if (!object) {
@@ -575,6 +821,12 @@ bool coral$red_black_tree$insert(struct coral$red_black_tree *object,
         coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
         return false;
     }
+    if (object->is_counted
+        != coral$red_black_tree$node_is_counted(child)) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    void *const inserted = child;
     /* required that child be RED */
     bool color;
     coral_required_true(coral$red_black_tree$node_set_color(
@@ -617,6 +869,19 @@ bool coral$red_black_tree$insert(struct coral$red_black_tree *object,
                 child, parent));
         coral_required_true(set_N(parent, child));
     }
+    if (object->is_counted) {
+        void *left, *right, *parent_;
+        coral_required_true(coral$red_black_tree$node_get_left(
+                inserted, &left));
+        coral_required_true(coral$red_black_tree$node_get_right(
+                inserted, &right));
+        *coral$red_black_tree$node_count(inserted) =
+                1 + coral$red_black_tree$count_of(left)
+                + coral$red_black_tree$count_of(right);
+        coral_required_true(coral$red_black_tree$node_get_parent(
+                inserted, &parent_));
+        coral$red_black_tree$count_path(parent_, true);
+    }
     /* repair */
     while (true) {
         coral_required_true(coral$red_black_tree$node_get_color(
@@ -769,7 +1034,10 @@ bool coral$red_black_tree$delete(struct coral$red_black_tree *object,
                         : coral$red_black_tree$node_set_right;
                     coral_required_true(set_N(parent, NULL));
                 }
-                coral_required_true(coral$red_black_tree$node_destroy(node));
+                if (object->is_counted) {
+                    coral$red_black_tree$count_path(parent, false);
+                }
+                coral$red_black_tree$node_release(object, node);
                 if (node == object->root) {
                     object->root = NULL;
                 } else if (CORAL_RED_BLACK_TREE_COLOR_BLACK == color) {
@@ -799,7 +1067,10 @@ bool coral$red_black_tree$delete(struct coral$red_black_tree *object,
                 if (node == object->root) {
                     object->root = child;
                 }
-                coral_required_true(coral$red_black_tree$node_destroy(node));
+                if (object->is_counted) {
+                    coral$red_black_tree$count_path(parent, false);
+                }
+                coral$red_black_tree$node_release(object, node);
                 if (CORAL_RED_BLACK_TREE_COLOR_BLACK == color
                         && CORAL_RED_BLACK_TREE_COLOR_BLACK == color_) {
                     double_black = child;
@@ -839,6 +1110,14 @@ bool coral$red_black_tree$delete(struct coral$red_black_tree *object,
                         node, color_));
                 coral_required_true(coral$red_black_tree$node_set_color(
                         next, color));
+                if (object->is_counted) {
+                    /* counts go with the place in the tree */
+                    size_t *count = coral$red_black_tree$node_count(node);
+                    size_t *count_ = coral$red_black_tree$node_count(next);
+                    const size_t swap = *count;
+                    *count = *count_;
+                    *count_ = swap;
+                }
 
                 if (parent_ && node != parent_) {
                     bool (*const set_N)(void *, void *) =
@@ -1017,7 +1296,7 @@ bool coral$red_black_tree$delete(struct coral$red_black_tree *object,
         void *farthest = is_left ? right : left;
         /* case 5: Sibling is BLACK and closest child is RED while farthest
          * child is BLACK.
-         *           P(B)              |             P(B)
+         *           P(?)              |             P(?)
          *          /    \             |            /    \
          *      N((B))   S(B)          |          S(B)   N((B))
          *        / \     / \          |          / \      / \
@@ -1026,7 +1305,7 @@ bool coral$red_black_tree$delete(struct coral$red_black_tree *object,
          *            ... .... ...     |     ... .... ...
          *                   rotate C(R) through S
          *              change S to RED and C(R) to BLACK
-         *           P(B)              |             P(B)
+         *           P(?)              |             P(?)
          *          /    \             |            /    \
          *      N((B))   C(B)          |          C(B)   N((B))
          *        / \     / \          |          / \      / \
@@ -1036,9 +1315,7 @@ bool coral$red_black_tree$delete(struct coral$red_black_tree *object,
          *                     / \     |    / \
          *                   ... ...   |  ... ...
          */
-        if (coral$red_black_tree$node_get_color(parent, &color)
-            && CORAL_RED_BLACK_TREE_COLOR_BLACK == color
-            && coral$red_black_tree$node_get_color(sibling, &color)
+        if (coral$red_black_tree$node_get_color(sibling, &color)
             && CORAL_RED_BLACK_TREE_COLOR_BLACK == color
             && coral$red_black_tree$node_get_color(closest, &color)
             && CORAL_RED_BLACK_TREE_COLOR_RED == color
@@ -1094,3 +1371,118 @@ bool coral$red_black_tree$delete(struct coral$red_black_tree *object,
     }
     return true;
 }
+
+/* Link the middle of nodes under parent and recurse into either half. The
+ * halves never differ by more than one node, so the leaves are all at depth
+ * red or one above it, and colouring just the nodes at depth red gives every
+ * path the same number of black nodes. */
+static void *coral$red_black_tree$build_N(void **nodes, const size_t count,
+                                          void *parent, const size_t depth,
+                                          const size_t red) {
+    if (!count) {
+        return NULL;
+    }
+    const size_t middle = count / 2;
+    void *node = nodes[middle];
+    struct coral$red_black_tree$node *node_;
+    node_ = coral$red_black_tree$node_from(node);
+    node_->parent = (void *) ((size_t) parent
+            | ((size_t) node_->parent & CORAL_RED_BLACK_TREE_NODE_IS_COUNTED)
+            | (depth == red
+               ? CORAL_RED_BLACK_TREE_COLOR_RED
+               : CORAL_RED_BLACK_TREE_COLOR_BLACK));
+    if (coral$red_black_tree$node_is_counted(node)) {
+        *coral$red_black_tree$node_count(node) = count;
+    }
+    node_->left = coral$red_black_tree$build_N(
+            nodes, middle, node, 1 + depth, red);
+    node_->right = coral$red_black_tree$build_N(
+            nodes + middle + 1, count - middle - 1, node, 1 + depth, red);
+    return node;
+}
+
+bool coral$red_black_tree$build(struct coral$red_black_tree *object,
+                                void **nodes, const size_t count) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!nodes) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (object->root) {
+        coral_error = CORAL_ERROR_OBJECT_UNAVAILABLE;
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (object->is_counted
+            != coral$red_black_tree$node_is_counted(nodes[i])
+            || (i && object->compare(nodes[i - 1], nodes[i]) >= 0)) {
+            coral_error = CORAL_ERROR_INVALID_VALUE;
+            return false;
+        }
+    }
+    /* levels that are complete, the nodes below them are red */
+    size_t red = 0;
+    for (size_t i = count + 1; i > 1; i >>= 1) {
+        red += 1;
+    }
+    object->root = coral$red_black_tree$build_N(nodes, count, NULL, 0, red);
+    return true;
+}
+
+bool coral$red_black_tree$pool_alloc(struct coral$red_black_tree *object,
+                                     const size_t size, void **out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    struct coral$red_black_tree$pool *pool = object->pool;
+    if (!pool) {
+        if (!coral$red_black_tree$pool_of(size, object->is_counted, &pool)) {
+            return false;
+        }
+        object->pool = pool;
+    } else if (pool->size != size) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    struct coral$red_black_tree$node *node_;
+    if (!coral$red_black_tree$pool_take(pool, &node_)) {
+        return false;
+    }
+    *out = coral$red_black_tree$node_to(node_);
+    coral_required_true(coral$red_black_tree$node_init(*out));
+    if (object->is_counted) {
+        node_->parent = (void *) CORAL_RED_BLACK_TREE_NODE_IS_COUNTED;
+        *coral$red_black_tree$node_count(*out) = 1;
+    }
+    return true;
+}
+
+bool coral$red_black_tree$pool_free(struct coral$red_black_tree *object,
+                                    void *node) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!node) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    struct coral$red_black_tree$pool *pool = object->pool;
+    if (!pool) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    struct coral$red_black_tree$node *node_;
+    node_ = coral$red_black_tree$node_from(node);
+    node_->left = pool->available;
+    pool->available = node_;
+    return true;
+}
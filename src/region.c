@@ -0,0 +1,231 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <coral.h>
+
+#include "private/allocator.h"
+#include "private/autorelease_pool.h"
+#include "private/region.h"
+#include "test/cmocka.h"
+
+#pragma mark private -
+
+struct $chunk {
+    struct $chunk *next;
+    size_t size;
+};
+
+struct coral_region {
+    struct coral_allocator allocator;
+    const struct coral_allocator *parent;
+    const struct coral_allocator *previous;
+    struct $chunk *chunks;
+    unsigned char *cursor;
+    unsigned char *limit;
+    size_t watermark;
+    /* blocks in use, plus one for as long as the region has not ended */
+    atomic_size_t live;
+};
+
+#define $ALIGNMENT alignof(max_align_t)
+#define $HEADER_SIZE \
+    ((sizeof(struct $chunk) + $ALIGNMENT - 1) & ~($ALIGNMENT - 1))
+#define $REGION_SIZE \
+    ((sizeof(struct coral_region) + $ALIGNMENT - 1) & ~($ALIGNMENT - 1))
+
+static struct $chunk *$chunk_alloc(const struct coral_allocator *parent,
+                                   const size_t size) {
+    coral_required(parent);
+    size_t size_;
+    if (!coral_add_size_t($HEADER_SIZE, size, &size_)) {
+        return NULL;
+    }
+    /* a chunk holds blocks of any subsystem */
+    struct $chunk *chunk = parent->allocate(parent->context,
+                                            CORAL_ALLOCATOR_TAG_OTHER, size_,
+                                            $ALIGNMENT);
+    if (chunk) {
+        chunk->next = NULL;
+        chunk->size = size_;
+    }
+    return chunk;
+}
+
+static void $chunks_free(struct coral_region *region) {
+    coral_required(region);
+    const struct coral_allocator *parent = region->parent;
+    if (!parent->deallocate) {
+        return;
+    }
+    /* the region itself lives in its first chunk which is the last one */
+    struct $chunk *chunk = region->chunks;
+    while (chunk) {
+        struct $chunk *next = chunk->next;
+        parent->deallocate(parent->context, CORAL_ALLOCATOR_TAG_OTHER, chunk,
+                           chunk->size, $ALIGNMENT);
+        chunk = next;
+    }
+}
+
+static void $release(struct coral_region *region) {
+    coral_required(region);
+    if (1 == atomic_fetch_sub_explicit(&region->live, 1,
+                                       memory_order_acq_rel)) {
+        $chunks_free(region);
+    }
+}
+
+static void *$region_alloc(void *context, const size_t tag,
+                           const size_t size, const size_t alignment) {
+    struct coral_region *region = context;
+    coral_required(region);
+    uintptr_t cursor = ((uintptr_t) region->cursor + alignment - 1)
+                       & ~(alignment - 1);
+    if (cursor > (uintptr_t) region->limit
+        || size > (uintptr_t) region->limit - cursor) {
+        /* large blocks get a chunk of their own so that the remainder of
+         * the current chunk is not abandoned */
+        const bool is_large = size > CORAL_REGION_CHUNK_SIZE / 4;
+        struct $chunk *chunk = $chunk_alloc(
+                region->parent,
+                (is_large ? size : CORAL_REGION_CHUNK_SIZE) + alignment);
+        if (!chunk) {
+            return NULL;
+        }
+        cursor = ((uintptr_t) chunk + $HEADER_SIZE + alignment - 1)
+                 & ~(alignment - 1);
+        if (is_large) {
+            chunk->next = region->chunks->next;
+            region->chunks->next = chunk;
+        } else {
+            chunk->next = region->chunks;
+            region->chunks = chunk;
+            region->limit = (unsigned char *) chunk + chunk->size;
+            region->cursor = (unsigned char *) cursor + size;
+        }
+    } else {
+        region->cursor = (unsigned char *) cursor + size;
+    }
+    atomic_fetch_add_explicit(&region->live, 1, memory_order_relaxed);
+    return (void *) cursor;
+}
+
+static void *$region_realloc(void *context, const size_t tag, void *ptr,
+                             const size_t size, const size_t new_size,
+                             const size_t alignment) {
+    struct coral_region *region = context;
+    coral_required(region);
+    unsigned char *block = ptr;
+    /* the most recent block grows or shrinks in place */
+    if (block + size == region->cursor
+        && new_size <= (size_t) (region->limit - block)) {
+        region->cursor = block + new_size;
+        return ptr;
+    }
+    void *result = $region_alloc(context, tag, new_size, alignment);
+    if (result) {
+        memcpy(result, ptr, size < new_size ? size : new_size);
+        $release(region);
+    }
+    return result;
+}
+
+static void $region_free(void *context, const size_t tag, void *ptr,
+                         const size_t size, const size_t alignment) {
+    struct coral_region *region = context;
+    coral_required(region);
+    unsigned char *block = ptr;
+    /* the most recent block is given back to the cursor, which only the
+     * region's own thread may read */
+    if (&region->allocator == coral$allocator$get_thread()
+        && block + size == region->cursor) {
+        region->cursor = block;
+    }
+    $release(region);
+}
+
+#pragma mark public -
+
+bool coral_region_start(struct coral_region **out) {
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    const struct coral_allocator *parent;
+    coral_required_true(coral_allocator_get(&parent));
+    struct $chunk *chunk = $chunk_alloc(parent,
+                                        CORAL_REGION_CHUNK_SIZE
+                                        + $REGION_SIZE);
+    if (!chunk) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    struct coral_region *region = (struct coral_region *)
+            ((unsigned char *) chunk + $HEADER_SIZE);
+    *region = (struct coral_region) {
+            .allocator = {
+                    .allocate = $region_alloc,
+                    .reallocate = $region_realloc,
+                    .deallocate = $region_free,
+                    .context = region
+            },
+            .parent = parent,
+            .previous = coral$allocator$get_thread(),
+            .chunks = chunk,
+            .cursor = (unsigned char *) region + $REGION_SIZE,
+            .limit = (unsigned char *) chunk + chunk->size,
+            .watermark = coral$autorelease_pool$start()
+    };
+    atomic_init(&region->live, 1);
+    coral_required_true(coral_allocator_set_thread(&region->allocator));
+    *out = region;
+    return true;
+}
+
+bool coral_region_end(struct coral_region *region, size_t *out) {
+    if (!region) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (&region->allocator != coral$allocator$get_thread()) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    coral$autorelease_pool$end(region->watermark);
+    coral_required_true(coral_allocator_set_thread(region->previous));
+    const size_t live = atomic_fetch_sub_explicit(&region->live, 1,
+                                                  memory_order_acq_rel);
+    if (1 == live) {
+        $chunks_free(region);
+    }
+    *out = live - 1;
+    return true;
+}
+
+bool coral_region_contains(const struct coral_region *region,
+                           const void *block, bool *out) {
+    if (!region) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!block || !out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    const uintptr_t block_ = (uintptr_t) block;
+    for (const struct $chunk *chunk = region->chunks; chunk;
+         chunk = chunk->next) {
+        const uintptr_t start = (uintptr_t) chunk + $HEADER_SIZE;
+        if (block_ >= start && block_ < (uintptr_t) chunk + chunk->size) {
+            *out = true;
+            return true;
+        }
+    }
+    *out = false;
+    return true;
+}
@@ -35,7 +35,7 @@ static void $on_load() {
     };
     coral_required_true(coral_class_alloc(&$class));
     coral_required_true(coral_class_init($class));
-    coral_required_true(coral_class_retain($class));
+    coral_required_true(coral$object$set_immortal($class));
     /* destroy */
     coral_required_true(coral_class_method_add(
             $class, &$method_names[0],
@@ -48,7 +48,7 @@ static void $on_load() {
     coral_required_true(coral_class_method_add(
             $class, &$method_names[2],
             (coral_invokable_t) $rwlock_is_equal));
-    /* copy */
+    coral_required_true(coral_class_freeze($class));
 
     coral_autorelease_pool_drain();
 }
@@ -0,0 +1,169 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <coral.h>
+
+#include "private/selector.h"
+/* selectors are never freed, their memory is deliberately not tracked by the
+ * tests and test/cmocka.h is therefore not included */
+
+#pragma mark private -
+
+struct $table {
+    struct $table *retired;
+    size_t capacity;
+    atomic_uintptr_t items[];
+};
+
+static atomic_uintptr_t $table;
+static atomic_flag $lock = ATOMIC_FLAG_INIT;
+static size_t $count;
+
+static size_t $hash(const char *data, const size_t size) {
+    coral_required(data);
+    /* FNV-1a */
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char) data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return (size_t) hash;
+}
+
+static const struct coral_selector *$table_find(const struct $table *table,
+                                                const char *data,
+                                                const size_t size,
+                                                const size_t hash) {
+    if (!table) {
+        return NULL;
+    }
+    const size_t mask = table->capacity - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        const struct coral_selector *item = (struct coral_selector *)
+                atomic_load_explicit(&table->items[i], memory_order_acquire);
+        if (!item) {
+            return NULL;
+        }
+        if (item->hash == hash && item->size == size
+            && !memcmp(item->name, data, size)) {
+            return item;
+        }
+    }
+}
+
+static void $table_put(struct $table *table,
+                       const struct coral_selector *selector) {
+    coral_required(table);
+    coral_required(selector);
+    const size_t mask = table->capacity - 1;
+    size_t i = selector->hash & mask;
+    while (atomic_load_explicit(&table->items[i], memory_order_relaxed)) {
+        i = (i + 1) & mask;
+    }
+    atomic_store_explicit(&table->items[i], (uintptr_t) selector,
+                          memory_order_release);
+}
+
+/* Make room for one more selector, the caller must hold the lock */
+static bool $table_reserve(struct $table **table) {
+    coral_required(table);
+    struct $table *current = *table;
+    if (current && 2 * ($count + 1) <= current->capacity) {
+        return true;
+    }
+    const size_t capacity = current ? 2 * current->capacity : 64;
+    struct $table *next = calloc(1, sizeof(*next)
+                                    + capacity * sizeof(atomic_uintptr_t));
+    if (!next) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    next->capacity = capacity;
+    for (size_t i = 0; current && i < current->capacity; i++) {
+        const struct coral_selector *item = (struct coral_selector *)
+                atomic_load_explicit(&current->items[i], memory_order_relaxed);
+        if (item) {
+            $table_put(next, item);
+        }
+    }
+    /* lookups may still be reading the previous table so it is kept */
+    next->retired = current;
+    atomic_store_explicit(&$table, (uintptr_t) next, memory_order_release);
+    *table = next;
+    return true;
+}
+
+bool coral$selector$find(const char *data, const size_t size,
+                         const struct coral_selector **out) {
+    coral_required(data);
+    coral_required(out);
+    const struct $table *table = (struct $table *)
+            atomic_load_explicit(&$table, memory_order_acquire);
+    const struct coral_selector *selector = $table_find(table, data, size,
+                                                        $hash(data, size));
+    if (!selector) {
+        coral_error = CORAL_ERROR_OBJECT_NOT_FOUND;
+        return false;
+    }
+    *out = selector;
+    return true;
+}
+
+bool coral$selector$of(const char *data, const size_t size,
+                       const struct coral_selector **out) {
+    coral_required(data);
+    coral_required_true(size > 0);
+    coral_required(out);
+    const size_t hash = $hash(data, size);
+    const struct coral_selector *selector = $table_find(
+            (struct $table *) atomic_load_explicit(&$table,
+                                                   memory_order_acquire),
+            data, size, hash);
+    if (selector) {
+        *out = selector;
+        return true;
+    }
+    while (atomic_flag_test_and_set_explicit(&$lock, memory_order_acquire));
+    struct $table *table = (struct $table *)
+            atomic_load_explicit(&$table, memory_order_relaxed);
+    /* someone else may have registered it while we were waiting */
+    bool result = true;
+    if (!(selector = $table_find(table, data, size, hash))) {
+        struct coral_selector *selector_ = NULL;
+        if (!$table_reserve(&table)
+            || !(selector_ = malloc(sizeof(*selector_) + size + 1))) {
+            coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+            result = false;
+        } else {
+            char *name = (char *) (selector_ + 1);
+            memcpy(name, data, size);
+            name[size] = '\0';
+            selector_->name = name;
+            selector_->size = size;
+            selector_->id = ++$count;
+            selector_->hash = hash;
+            $table_put(table, selector_);
+            selector = selector_;
+        }
+    }
+    atomic_flag_clear_explicit(&$lock, memory_order_release);
+    if (result) {
+        *out = selector;
+    }
+    return result;
+}
+
+#pragma mark public -
+
+bool coral_selector_of(const char *name, const struct coral_selector **out) {
+    if (!name || !out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    const size_t size = strlen(name);
+    if (!size) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    return coral$selector$of(name, size, out);
+}
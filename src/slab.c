@@ -0,0 +1,371 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <coral.h>
+
+#include "private/coral.h"
+#include "private/slab.h"
+#include "test/cmocka.h"
+
+#pragma mark private
+
+#define $BINS (CORAL_SLAB_MAXIMUM_BLOCK_SIZE / CORAL_SLAB_GRANULARITY)
+
+struct $heap;
+
+struct $slab {
+    struct $slab *prev;
+    struct $slab *next;
+    struct $heap *heap;
+    void *free;
+    atomic_uintptr_t remote;
+    unsigned char *blocks;
+    size_t bin;
+    size_t block_size;
+    size_t capacity;
+    size_t bump;
+    size_t used;
+    bool is_full;
+};
+
+struct $bin {
+    struct $slab *current;
+    struct $slab *available;
+    struct $slab *full;
+};
+
+struct $heap {
+    struct $heap *next;
+    atomic_size_t remote;
+    struct $slab *empty;
+    size_t empty_count;
+    struct $bin bins[$BINS];
+};
+
+static thread_local struct $heap *$heap = NULL;
+static thread_local struct coral$slab$statistics $statistics;
+static atomic_size_t $bytes_mapped;
+static atomic_flag $abandoned_lock = ATOMIC_FLAG_INIT;
+static struct $heap *$abandoned = NULL;
+static pthread_once_t $once = PTHREAD_ONCE_INIT;
+static pthread_key_t $key;
+
+static void *$map(const size_t size, const size_t alignment) {
+    const size_t size_ = size + alignment;
+    unsigned char *map = mmap(NULL, size_, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == map) {
+        return NULL;
+    }
+    if (!alignment) {
+        return map;
+    }
+    unsigned char *result = (unsigned char *)
+            (((uintptr_t) map + alignment - 1) & ~(alignment - 1));
+    if (result != map) {
+        munmap(map, result - map);
+    }
+    const size_t tail = (map + size_) - (result + size);
+    if (tail) {
+        munmap(result + size, tail);
+    }
+    return result;
+}
+
+static void $list_push(struct $slab **head, struct $slab *slab) {
+    coral_required(head);
+    coral_required(slab);
+    slab->prev = NULL;
+    slab->next = *head;
+    if (*head) {
+        (*head)->prev = slab;
+    }
+    *head = slab;
+}
+
+static void $list_remove(struct $slab **head, struct $slab *slab) {
+    coral_required(head);
+    coral_required(slab);
+    if (slab->prev) {
+        slab->prev->next = slab->next;
+    } else {
+        coral_required_true(*head == slab);
+        *head = slab->next;
+    }
+    if (slab->next) {
+        slab->next->prev = slab->prev;
+    }
+    slab->prev = slab->next = NULL;
+}
+
+static struct $slab *$slab_create(struct $heap *heap, const size_t bin) {
+    coral_required(heap);
+    struct $slab *slab = heap->empty;
+    if (slab) {
+        $list_remove(&heap->empty, slab);
+        heap->empty_count -= 1;
+        memset(slab, 0, sizeof(*slab));
+    } else if ((slab = $map(CORAL_SLAB_SIZE, CORAL_SLAB_SIZE))) {
+        $statistics.slabs_mapped += 1;
+        atomic_fetch_add_explicit(&$bytes_mapped, CORAL_SLAB_SIZE,
+                                  memory_order_relaxed);
+    } else {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return NULL;
+    }
+    const size_t offset = (sizeof(*slab) + 63) & ~(size_t) 63;
+    slab->heap = heap;
+    slab->blocks = (unsigned char *) slab + offset;
+    slab->bin = bin;
+    slab->block_size = (1 + bin) * CORAL_SLAB_GRANULARITY;
+    slab->capacity = (CORAL_SLAB_SIZE - offset) / slab->block_size;
+    return slab;
+}
+
+static void $slab_unmap(struct $slab *slab) {
+    coral_required(slab);
+    coral_required_true(!munmap(slab, CORAL_SLAB_SIZE));
+    $statistics.slabs_unmapped += 1;
+    atomic_fetch_sub_explicit(&$bytes_mapped, CORAL_SLAB_SIZE,
+                              memory_order_relaxed);
+}
+
+static void $slab_destroy(struct $heap *heap, struct $slab *slab) {
+    coral_required(heap);
+    coral_required(slab);
+    if (heap->empty_count < CORAL_SLAB_MAXIMUM_EMPTY) {
+        $list_push(&heap->empty, slab);
+        heap->empty_count += 1;
+    } else {
+        $slab_unmap(slab);
+    }
+}
+
+static void *$slab_take(struct $slab *slab) {
+    coral_required(slab);
+    void *block = slab->free;
+    if (block) {
+        slab->free = *(void **) block;
+    } else if (slab->bump < slab->capacity) {
+        block = slab->blocks + slab->bump * slab->block_size;
+        slab->bump += 1;
+    } else {
+        return NULL;
+    }
+    slab->used += 1;
+    return block;
+}
+
+static size_t $slab_collect(struct $slab *slab) {
+    coral_required(slab);
+    void *block = (void *) atomic_exchange_explicit(&slab->remote, 0,
+                                                    memory_order_acquire);
+    size_t count = 0;
+    while (block) {
+        void *next = *(void **) block;
+        *(void **) block = slab->free;
+        slab->free = block;
+        slab->used -= 1;
+        block = next;
+        count += 1;
+    }
+    return count;
+}
+
+static void $heap_collect(struct $heap *heap) {
+    coral_required(heap);
+    for (size_t i = 0; i < $BINS; i++) {
+        struct $bin *bin = &heap->bins[i];
+        for (struct $slab *slab = bin->full, *next; slab; slab = next) {
+            next = slab->next;
+            if (!$slab_collect(slab)) {
+                continue;
+            }
+            $list_remove(&bin->full, slab);
+            slab->is_full = false;
+            if (slab->used) {
+                $list_push(&bin->available, slab);
+            } else {
+                $slab_destroy(heap, slab);
+            }
+        }
+        for (struct $slab *slab = bin->available, *next; slab; slab = next) {
+            next = slab->next;
+            if ($slab_collect(slab) && !slab->used) {
+                $list_remove(&bin->available, slab);
+                $slab_destroy(heap, slab);
+            }
+        }
+    }
+}
+
+static void $on_thread_exit(void *heap) {
+    struct $heap *heap_ = heap;
+    coral_required(heap_);
+    $heap_collect(heap_);
+    for (size_t i = 0; i < $BINS; i++) {
+        struct $bin *bin = &heap_->bins[i];
+        struct $slab *slab = bin->current;
+        if (slab && ($slab_collect(slab), !slab->used)) {
+            bin->current = NULL;
+            $slab_unmap(slab);
+        }
+    }
+    while (heap_->empty) {
+        struct $slab *slab = heap_->empty;
+        $list_remove(&heap_->empty, slab);
+        $slab_unmap(slab);
+    }
+    heap_->empty_count = 0;
+    if ($heap == heap_) {
+        $heap = NULL;
+    }
+    while (atomic_flag_test_and_set_explicit(&$abandoned_lock,
+                                             memory_order_acquire));
+    heap_->next = $abandoned;
+    $abandoned = heap_;
+    atomic_flag_clear_explicit(&$abandoned_lock, memory_order_release);
+}
+
+static void $key_create() {
+    coral_required_true(!pthread_key_create(&$key, $on_thread_exit));
+}
+
+static struct $heap *$heap_get() {
+    if ($heap) {
+        return $heap;
+    }
+    coral_required_true(!pthread_once(&$once, $key_create));
+    while (atomic_flag_test_and_set_explicit(&$abandoned_lock,
+                                             memory_order_acquire));
+    struct $heap *heap = $abandoned;
+    if (heap) {
+        $abandoned = heap->next;
+    }
+    atomic_flag_clear_explicit(&$abandoned_lock, memory_order_release);
+    if (!heap && !(heap = $map(sizeof(*heap), 0))) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return NULL;
+    }
+    heap->next = NULL;
+    coral_required_true(!pthread_setspecific($key, heap));
+    $heap = heap;
+    return heap;
+}
+
+static bool $bin_refill(struct $heap *heap, struct $bin *bin,
+                        const size_t index) {
+    coral_required(heap);
+    coral_required(bin);
+    struct $slab *slab = bin->current;
+    if (slab) {
+        if ($slab_collect(slab)) {
+            return true;
+        }
+        slab->is_full = true;
+        $list_push(&bin->full, slab);
+        bin->current = NULL;
+    }
+    if (!bin->available
+        && atomic_exchange_explicit(&heap->remote, 0, memory_order_acquire)) {
+        $heap_collect(heap);
+    }
+    if ((slab = bin->available)) {
+        $list_remove(&bin->available, slab);
+    } else if (!(slab = $slab_create(heap, index))) {
+        return false;
+    }
+    bin->current = slab;
+    return true;
+}
+
+static void $free_local(struct $heap *heap, struct $slab *slab, void *block) {
+    coral_required(heap);
+    coral_required(slab);
+    coral_required(block);
+    *(void **) block = slab->free;
+    slab->free = block;
+    slab->used -= 1;
+    struct $bin *bin = &heap->bins[slab->bin];
+    if (slab == bin->current) {
+        return;
+    }
+    if (slab->is_full) {
+        $list_remove(&bin->full, slab);
+        slab->is_full = false;
+        $list_push(&bin->available, slab);
+    }
+    if (!slab->used) {
+        $list_remove(&bin->available, slab);
+        $slab_destroy(heap, slab);
+    }
+}
+
+static void $free_remote(struct $slab *slab, void *block) {
+    coral_required(slab);
+    coral_required(block);
+    /* read the heap before publishing the block as the owner may unmap the
+     * slab as soon as it has collected it */
+    struct $heap *heap = slab->heap;
+    uintptr_t head = atomic_load_explicit(&slab->remote, memory_order_relaxed);
+    do {
+        *(void **) block = (void *) head;
+    } while (!atomic_compare_exchange_weak_explicit(&slab->remote, &head,
+                                                    (uintptr_t) block,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+    atomic_fetch_add_explicit(&heap->remote, 1, memory_order_release);
+    $statistics.remote_deallocations += 1;
+}
+
+bool coral$slab$is_eligible(const size_t size) {
+    return size <= CORAL_SLAB_MAXIMUM_BLOCK_SIZE;
+}
+
+bool coral$slab$alloc(const size_t size, void **out) {
+    coral_required(out);
+    if (!size || !coral$slab$is_eligible(size)) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    struct $heap *heap = $heap_get();
+    if (!heap) {
+        return false;
+    }
+    const size_t index = (size - 1) / CORAL_SLAB_GRANULARITY;
+    struct $bin *bin = &heap->bins[index];
+    void *block;
+    if (!bin->current || !(block = $slab_take(bin->current))) {
+        if (!$bin_refill(heap, bin, index)) {
+            return false;
+        }
+        coral_required((block = $slab_take(bin->current)));
+    }
+    memset(block, 0, bin->current->block_size);
+    $statistics.allocations += 1;
+    *out = block;
+    return true;
+}
+
+void coral$slab$free(void *block) {
+    coral_required(block);
+    struct $slab *slab = (struct $slab *)
+            ((uintptr_t) block & ~(CORAL_SLAB_SIZE - 1));
+    $statistics.deallocations += 1;
+    if ($heap && slab->heap == $heap) {
+        $free_local($heap, slab, block);
+    } else {
+        $free_remote(slab, block);
+    }
+}
+
+void coral$slab$get_statistics(struct coral$slab$statistics *out) {
+    coral_required(out);
+    *out = $statistics;
+    out->bytes_mapped = atomic_load_explicit(&$bytes_mapped,
+                                             memory_order_relaxed);
+}
@@ -2,10 +2,12 @@
 #include <coral.h>
 #include <string.h>
 
+#include "private/allocator.h"
 #include "private/string.h"
 #include "private/tree_map.h"
 #include "private/lock.h"
 #include "private/class.h"
+#include "private/object.h"
 #include "test/cmocka.h"
 
 #pragma mark private
@@ -38,7 +40,7 @@ static int $string$compare(const struct coral$string *a,
 }
 
 static void $string$on_destroy(struct coral$string *object) {
-    free(object->data);
+    coral$allocator$free(object->data);
 }
 
 static void $pool$on_destroy(struct $pool$entry *entry) {
@@ -61,7 +63,8 @@ static void $on_load() {
     // TODO: add attributes ...
     // TODO: add method signatures ...
     // TODO: set invokables ...
-    coral_required_true(coral_class_retain($class));
+    coral_required_true(coral$object$set_immortal($class));
+    coral_required_true(coral_class_freeze($class));
     coral_autorelease_pool_drain();
 }
 
@@ -102,9 +105,8 @@ bool coral_string_init(struct coral_string *object,
     // TODO: check if there is an existing string ...
     //  (provide "copy-on-write" result)
     struct coral$string *string = &object->string;
-    string->data = malloc(size);
-    if (!string->data) {
-        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+    if (!coral$allocator$alloc(CORAL_ALLOCATOR_TAG_STRING, size,
+                               (void **) &string->data)) {
         return false;
     }
     memcpy(string->data, data, size);
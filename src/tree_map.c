@@ -3,8 +3,10 @@
 #include <string.h>
 
 #include "private/tree_map.h"
+#include "private/array.h"
 #include "private/coral.h"
 #include "private/class.h"
+#include "private/object.h"
 #include "test/cmocka.h"
 
 #pragma mark private -
@@ -34,7 +36,7 @@ static void $on_load() {
     };
     coral_required_true(coral_class_alloc(&$class));
     coral_required_true(coral_class_init($class));
-    coral_required_true(coral_class_retain($class));
+    coral_required_true(coral$object$set_immortal($class));
     /* destroy */
     coral_required_true(coral_class_method_add(
             $class, &$method_names[0],
@@ -47,6 +49,7 @@ static void $on_load() {
 //    coral_required_true(coral_class_method_add(
 //            $class, &$method_names[2],
 //            (coral_invokable_t) $tree_set_copy));
+    coral_required_true(coral_class_freeze($class));
 
     coral_autorelease_pool_drain();
 }
@@ -64,6 +67,18 @@ bool coral$tree_map$init(struct coral$tree_map *object,
                          const size_t value_size,
                          int (*compare)(const void *first,
                                         const void *second)) {
+    return coral$tree_map$init_with_engine(
+            object, limit, key_size, value_size,
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE, compare);
+}
+
+bool coral$tree_map$init_with_engine(struct coral$tree_map *object,
+                                     struct coral_range_values *limit,
+                                     const size_t key_size,
+                                     const size_t value_size,
+                                     const int engine,
+                                     int (*compare)(const void *first,
+                                                    const void *second)) {
     if (!object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
         return false;
@@ -79,7 +94,8 @@ bool coral$tree_map$init(struct coral$tree_map *object,
     }
     object->key_size = key_size;
     object->value_size = value_size;
-    return coral$tree_set$init(&object->tree_set, limit, size, compare);
+    return coral$tree_set$init_with_engine(&object->tree_set, limit, size,
+                                           engine, compare);
 }
 
 bool coral$tree_map$invalidate(struct coral$tree_map *object,
@@ -145,6 +161,24 @@ bool coral$tree_map$insert(struct coral$tree_map *object, const void *entry) {
     return coral$tree_set$insert(&object->tree_set, entry);
 }
 
+bool coral$tree_map$build(struct coral$tree_map *object,
+                          struct coral$array *entries) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    return coral$tree_set$build(&object->tree_set, entries);
+}
+
+bool coral$tree_map$build_unsorted(struct coral$tree_map *object,
+                                   struct coral$array *entries) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    return coral$tree_set$build_unsorted(&object->tree_set, entries);
+}
+
 bool coral$tree_map$delete(struct coral$tree_map *object, const void *key) {
     if (!object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
@@ -173,8 +207,7 @@ bool coral$tree_map$get(struct coral$tree_map *object, const void *key,
         return false;
     }
     void *node;
-    const bool result = coral$red_black_tree$search(
-            &object->tree_set.tree, NULL, key, &node);
+    const bool result = coral$tree_set$search(&object->tree_set, key, &node);
     if (result) {
         memcpy(out, node, object->tree_set.size);
     }
@@ -191,8 +224,7 @@ bool coral$tree_map$set(struct coral$tree_map *object, const void *entry) {
         return false;
     }
     void *node;
-    const bool result = coral$red_black_tree$search(
-            &object->tree_set.tree, NULL, entry, &node);
+    const bool result = coral$tree_set$search(&object->tree_set, entry, &node);
     if (result) {
         memcpy(node, entry, object->tree_set.size);
     }
@@ -207,6 +239,24 @@ bool coral$tree_map$get_first(struct coral$tree_map *object, void **out) {
     return coral$tree_set$get_first(&object->tree_set, out);
 }
 
+bool coral$tree_map$get_at(struct coral$tree_map *object, const size_t at,
+                           void **out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    return coral$tree_set$get_at(&object->tree_set, at, out);
+}
+
+bool coral$tree_map$rank_of(struct coral$tree_map *object, const void *key,
+                            size_t *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    return coral$tree_set$rank_of(&object->tree_set, key, out);
+}
+
 bool coral$tree_map$get_last(struct coral$tree_map *object, void **out) {
     if (!object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
@@ -277,7 +327,7 @@ static bool $tree_map_is_equal(void *this,
     coral_required(args->other);
     coral_required(args->out);
     struct coral_tree_map *object = data;
-    struct coral_tree_map *other = args->other;
+    struct coral_tree_map *other = coral$object$get_data(args->other);
 
     return false;
 }
@@ -311,6 +361,8 @@ static bool $tree_map_insert(void *this,
         if (!e->value || (e->value && coral_object_retain(e->value))) {
             $object_compare = data->compare;
             if (coral$tree_map$insert(&data->tree_map, e)) {
+                coral$object_post_notification(
+                        this, CORAL_NOTIFICATION_CONTAINER_INCREASED);
                 return true;
             } else if (e->value) {
                 coral_required_true(coral_object_release(e->value));
@@ -321,6 +373,61 @@ static bool $tree_map_insert(void *this,
     return false;
 }
 
+static void $tree_map_release_entries(
+        const struct coral_tree_map_entry *entries, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        $tree_map_destroy$object_destroy(
+                (struct coral_tree_map_entry *) &entries[i]);
+    }
+}
+
+struct $tree_map_build_args {
+    const struct coral_tree_map_entry *entries;
+    size_t count;
+    bool is_sorted;
+};
+
+static bool $tree_map_build(void *this,
+                            struct coral_tree_map *data,
+                            struct $tree_map_build_args *args) {
+    coral_required(data);
+    coral_required(args);
+    coral_required(args->entries);
+    const struct coral_tree_map_entry *entries = args->entries;
+    for (size_t i = 0; i < args->count; i++) {
+        if (!coral_object_retain(entries[i].key)) {
+            $tree_map_release_entries(entries, i);
+            return false;
+        }
+        if (entries[i].value && !coral_object_retain(entries[i].value)) {
+            const size_t error = coral_error;
+            coral_required_true(coral_object_release(entries[i].key));
+            $tree_map_release_entries(entries, i);
+            coral_error = error;
+            return false;
+        }
+    }
+    struct coral$array items = {
+            .count = args->count,
+            .size = sizeof(*entries),
+            .data = (unsigned char *) entries
+    };
+    $object_compare = data->compare;
+    if (!(args->is_sorted
+          ? coral$tree_map$build(&data->tree_map, &items)
+          : coral$tree_map$build_unsorted(&data->tree_map, &items))) {
+        const size_t error = coral_error;
+        $tree_map_release_entries(entries, args->count);
+        coral_error = error;
+        return false;
+    }
+    if (args->count) {
+        coral$object_post_notification(
+                this, CORAL_NOTIFICATION_CONTAINER_INCREASED);
+    }
+    return true;
+}
+
 struct $tree_map_delete_args {
     const void *key;
 };
@@ -339,6 +446,8 @@ static bool $tree_map_delete(void *this,
         if (e.value) {
             coral_required_true(coral_object_release(e.value));
         }
+        coral$object_post_notification(
+                this, CORAL_NOTIFICATION_CONTAINER_DECREASED);
         return true;
     }
     return false;
@@ -411,6 +520,10 @@ static bool $tree_map_set(void *this,
     if (!result && e->value) {
         coral_required_true(coral_object_release(e->value));
     }
+    if (result) {
+        coral$object_post_notification(this,
+                                       CORAL_NOTIFICATION_CONTAINER_CHANGED);
+    }
     return result;
 }
 
@@ -432,6 +545,15 @@ bool coral_tree_map_init(struct coral_tree_map *object,
                          struct coral_range_values *limit,
                          int (*compare)(const void *first,
                                         const void *second)) {
+    return coral_tree_map_init_with_engine(
+            object, limit, CORAL_TREE_SET_ENGINE_RED_BLACK_TREE, compare);
+}
+
+bool coral_tree_map_init_with_engine(struct coral_tree_map *object,
+                                     struct coral_range_values *limit,
+                                     const int engine,
+                                     int (*compare)(const void *first,
+                                                    const void *second)) {
     if (!object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
         return false;
@@ -440,13 +562,22 @@ bool coral_tree_map_init(struct coral_tree_map *object,
         coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
         return false;
     }
+    /* checked up front as the object cannot be taken back once initialized */
+    if (CORAL_TREE_SET_ENGINE_RED_BLACK_TREE != engine
+        && CORAL_TREE_SET_ENGINE_B_TREE != engine
+        && CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE != engine
+        && CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE != engine) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
     bool result = false;
     if (coral_object_init(object, $class)) {
-        if (coral$tree_map$init(
+        if (coral$tree_map$init_with_engine(
                 &object->tree_map,
                 limit,
                 sizeof(((struct coral_tree_map_entry *) 0)->key),
                 sizeof(((struct coral_tree_map_entry *) 0)->value),
+                engine,
                 $tree_map_object_compare)) {
             object->compare = compare;
             result = true;
@@ -549,6 +680,48 @@ bool coral_tree_map_insert(struct coral_tree_map *object,
             &args);
 }
 
+static bool $build_entries(struct coral_tree_map *object,
+                           const struct coral_tree_map_entry *entries,
+                           const size_t count,
+                           const bool is_sorted) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!entries) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!entries[i].key) {
+            coral_error = CORAL_ERROR_INVALID_VALUE;
+            return false;
+        }
+    }
+    struct $tree_map_build_args args = {
+            .entries = entries,
+            .count = count,
+            .is_sorted = is_sorted
+    };
+    return coral_object_invoke(
+            object,
+            false,
+            (coral_invokable_t) $tree_map_build,
+            &args);
+}
+
+bool coral_tree_map_build(struct coral_tree_map *object,
+                          const struct coral_tree_map_entry *entries,
+                          const size_t count) {
+    return $build_entries(object, entries, count, true);
+}
+
+bool coral_tree_map_build_unsorted(struct coral_tree_map *object,
+                                   const struct coral_tree_map_entry *entries,
+                                   const size_t count) {
+    return $build_entries(object, entries, count, false);
+}
+
 bool coral_tree_map_delete(struct coral_tree_map *object, const void *key) {
     if (!object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
@@ -3,8 +3,11 @@
 #include <coral.h>
 
 #include "private/tree_set.h"
+#include "private/allocator.h"
+#include "private/array.h"
 #include "private/coral.h"
 #include "private/class.h"
+#include "private/object.h"
 #include "test/cmocka.h"
 
 #pragma mark private -
@@ -35,7 +38,7 @@ static void $on_load() {
     };
     coral_required_true(coral_class_alloc(&$class));
     coral_required_true(coral_class_init($class));
-    coral_required_true(coral_class_retain($class));
+    coral_required_true(coral$object$set_immortal($class));
     /* destroy */
     coral_required_true(coral_class_method_add(
             $class, &$method_names[0],
@@ -48,6 +51,7 @@ static void $on_load() {
     coral_required_true(coral_class_method_add(
             $class, &$method_names[2],
             (coral_invokable_t) $tree_set_copy));
+    coral_required_true(coral_class_freeze($class));
 
     coral_autorelease_pool_drain();
 }
@@ -59,11 +63,61 @@ static void $on_unload() {
     coral_autorelease_pool_drain();
 }
 
+/* The compact red black tree hands out the index of a node, the tree set hands
+ * out its item. */
+static bool $compact_search(struct coral$compact_red_black_tree *tree,
+                            const void *item, void **out) {
+    uint32_t node;
+    return coral$compact_red_black_tree$search(tree, item, &node)
+           && coral$compact_red_black_tree$get_item(tree, node, out);
+}
+
+static bool $compact_get_first(struct coral$compact_red_black_tree *tree,
+                               void **out) {
+    uint32_t node;
+    return coral$compact_red_black_tree$get_first(tree, &node)
+           && coral$compact_red_black_tree$get_item(tree, node, out);
+}
+
+static bool $compact_get_last(struct coral$compact_red_black_tree *tree,
+                              void **out) {
+    uint32_t node;
+    return coral$compact_red_black_tree$get_last(tree, &node)
+           && coral$compact_red_black_tree$get_item(tree, node, out);
+}
+
+static bool $compact_get_next(struct coral$compact_red_black_tree *tree,
+                              const void *item, void **out) {
+    uint32_t node;
+    return coral$compact_red_black_tree$search(tree, item, &node)
+           && coral$compact_red_black_tree$get_next(tree, node, &node)
+           && coral$compact_red_black_tree$get_item(tree, node, out);
+}
+
+static bool $compact_get_prev(struct coral$compact_red_black_tree *tree,
+                              const void *item, void **out) {
+    uint32_t node;
+    return coral$compact_red_black_tree$search(tree, item, &node)
+           && coral$compact_red_black_tree$get_prev(tree, node, &node)
+           && coral$compact_red_black_tree$get_item(tree, node, out);
+}
+
 bool coral$tree_set$init(struct coral$tree_set *object,
                          struct coral_range_values *limit,
                          const size_t size,
                          int (*compare)(const void *first,
                                         const void *second)) {
+    return coral$tree_set$init_with_engine(
+            object, limit, size, CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            compare);
+}
+
+bool coral$tree_set$init_with_engine(struct coral$tree_set *object,
+                                     struct coral_range_values *limit,
+                                     const size_t size,
+                                     const int engine,
+                                     int (*compare)(const void *first,
+                                                    const void *second)) {
     if (!object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
         return false;
@@ -72,9 +126,27 @@ bool coral$tree_set$init(struct coral$tree_set *object,
         coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
         return false;
     }
+    if (CORAL_TREE_SET_ENGINE_RED_BLACK_TREE != engine
+        && CORAL_TREE_SET_ENGINE_B_TREE != engine
+        && CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE != engine
+        && CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE != engine) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
     object->limit = limit ? *limit : $limit;
     object->size = size;
-    return coral$red_black_tree$init(&object->tree, compare);
+    object->engine = engine;
+    switch (engine) {
+        case CORAL_TREE_SET_ENGINE_B_TREE:
+            return coral$b_tree$init(&object->b_tree, size, compare);
+        case CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE:
+            return coral$red_black_tree$init_counted(&object->tree, compare);
+        case CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE:
+            return coral$compact_red_black_tree$init(
+                    &object->compact_tree, size, compare);
+        default:
+            return coral$red_black_tree$init(&object->tree, compare);
+    }
 }
 
 bool coral$tree_set$invalidate(struct coral$tree_set *object,
@@ -83,8 +155,17 @@ bool coral$tree_set$invalidate(struct coral$tree_set *object,
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
         return false;
     }
-    coral_required_true(coral$red_black_tree$invalidate(
-            &object->tree, on_destroy));
+    if (CORAL_TREE_SET_ENGINE_B_TREE == object->engine) {
+        coral_required_true(coral$b_tree$invalidate(
+                &object->b_tree, on_destroy));
+    } else if (CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+               == object->engine) {
+        coral_required_true(coral$compact_red_black_tree$invalidate(
+                &object->compact_tree, on_destroy));
+    } else {
+        coral_required_true(coral$red_black_tree$invalidate(
+                &object->tree, on_destroy));
+    }
     object->count = 0;
     return true;
 }
@@ -133,6 +214,23 @@ bool coral$tree_set$insert(struct coral$tree_set *object, const void *item) {
         coral_error = CORAL_ERROR_OBJECT_UNAVAILABLE;
         return false;
     }
+    if (CORAL_TREE_SET_ENGINE_B_TREE == object->engine) {
+        if (!coral$b_tree$insert(&object->b_tree, item)) {
+            return false;
+        }
+        atomic_fetch_add(&object->id, 1);
+        object->count += 1;
+        return true;
+    }
+    if (CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE == object->engine) {
+        if (!coral$compact_red_black_tree$insert(&object->compact_tree, item,
+                                                 NULL)) {
+            return false;
+        }
+        atomic_fetch_add(&object->id, 1);
+        object->count += 1;
+        return true;
+    }
     void *insertion_point;
     if (coral$red_black_tree$search(&object->tree, NULL, item,
                                     &insertion_point)) {
@@ -140,14 +238,16 @@ bool coral$tree_set$insert(struct coral$tree_set *object, const void *item) {
         return false;
     }
     void *node;
-    if (!coral$red_black_tree$node_of(object->size, &node)) {
+    if (!coral$red_black_tree$pool_alloc(&object->tree, object->size,
+                                         &node)) {
         return false;
     }
     memcpy(node, item, object->size);
     const bool result = coral$red_black_tree$insert(
             &object->tree, insertion_point, node);
     if (!result) {
-        coral_required_true(coral$red_black_tree$node_destroy(node));
+        coral_required_true(coral$red_black_tree$pool_free(&object->tree,
+                                                           node));
     } else {
         atomic_fetch_add(&object->id, 1);
         object->count += 1;
@@ -155,6 +255,151 @@ bool coral$tree_set$insert(struct coral$tree_set *object, const void *item) {
     return result;
 }
 
+static thread_local int (*$node_compare)(const void *, const void *);
+
+static int $tree_set_node_compare(const void *a, const void *b) {
+    return $node_compare(*(void **) a, *(void **) b);
+}
+
+/* Sort a copy of the items, which belong to the caller, for the engines that
+ * build out of items rather than nodes. */
+static bool $sorted_copy(struct coral$array *items,
+                         int (*compare)(const void *, const void *),
+                         void **out) {
+    size_t size;
+    if (!coral_multiply_size_t(items->count, items->size, &size)) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    unsigned char *sorted;
+    if (!coral$allocator$alloc(CORAL_ALLOCATOR_TAG_TREE_NODE, size,
+                               (void **) &sorted)) {
+        return false;
+    }
+    memcpy(sorted, items->data, size);
+    qsort(sorted, items->count, items->size, compare);
+    for (size_t i = 1; i < items->count; i++) {
+        if (!compare(sorted + (i - 1) * items->size,
+                     sorted + i * items->size)) {
+            coral$allocator$free(sorted);
+            coral_error = CORAL_ERROR_OBJECT_ALREADY_EXISTS;
+            return false;
+        }
+    }
+    *out = sorted;
+    return true;
+}
+
+static bool $build(struct coral$tree_set *object,
+                   struct coral$array *items,
+                   const bool is_sorted) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!items) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (items->size != object->size) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    size_t maximum;
+    coral_required_true(coral_maximum_size_t(
+            object->limit.first,
+            object->limit.last,
+            &maximum));
+    if (object->count || items->count > maximum) {
+        coral_error = CORAL_ERROR_OBJECT_UNAVAILABLE;
+        return false;
+    }
+    if (!items->count) {
+        return true;
+    }
+    if (CORAL_TREE_SET_ENGINE_B_TREE == object->engine
+        || CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE == object->engine) {
+        const bool is_b_tree = CORAL_TREE_SET_ENGINE_B_TREE == object->engine;
+        void *sorted = items->data;
+        if (!is_sorted && !$sorted_copy(items, is_b_tree
+                ? object->b_tree.compare
+                : object->compact_tree.compare, &sorted)) {
+            return false;
+        }
+        const bool result = is_b_tree
+                ? coral$b_tree$build(&object->b_tree, sorted, items->count)
+                : coral$compact_red_black_tree$build(&object->compact_tree,
+                                                     sorted, items->count);
+        if (!is_sorted) {
+            coral$allocator$free(sorted);
+        }
+        if (!result) {
+            return false;
+        }
+        atomic_fetch_add(&object->id, 1);
+        object->count = items->count;
+        return true;
+    }
+    size_t size;
+    if (!coral_multiply_size_t(items->count, sizeof(void *), &size)) {
+        coral_error = CORAL_ERROR_MEMORY_ALLOCATION_FAILED;
+        return false;
+    }
+    void **nodes;
+    if (!coral$allocator$alloc(CORAL_ALLOCATOR_TAG_TREE_NODE, size,
+                               (void **) &nodes)) {
+        return false;
+    }
+    size_t count = 0;
+    bool result = true;
+    while (count < items->count) {
+        if (!coral$red_black_tree$pool_alloc(&object->tree, object->size,
+                                             &nodes[count])) {
+            result = false;
+            break;
+        }
+        memcpy(nodes[count], items->data + count * items->size,
+               object->size);
+        count += 1;
+    }
+    if (result && !is_sorted) {
+        $node_compare = object->tree.compare;
+        qsort(nodes, count, sizeof(void *), $tree_set_node_compare);
+        for (size_t i = 1; result && i < count; i++) {
+            if (!$node_compare(nodes[i - 1], nodes[i])) {
+                coral_error = CORAL_ERROR_OBJECT_ALREADY_EXISTS;
+                result = false;
+            }
+        }
+    }
+    if (result) {
+        result = coral$red_black_tree$build(&object->tree, nodes, count);
+    }
+    if (!result) {
+        const size_t error = coral_error;
+        while (count--) {
+            coral_required_true(coral$red_black_tree$pool_free(
+                    &object->tree, nodes[count]));
+        }
+        coral_error = error;
+    } else {
+        atomic_fetch_add(&object->id, 1);
+        object->count = count;
+    }
+    coral$allocator$free(nodes);
+    return result;
+}
+
+bool coral$tree_set$build(struct coral$tree_set *object,
+                          struct coral$array *items) {
+    return $build(object, items, true);
+}
+
+bool coral$tree_set$build_unsorted(struct coral$tree_set *object,
+                                   struct coral$array *items) {
+    return $build(object, items, false);
+}
+
 bool coral$tree_set$delete(struct coral$tree_set *object, const void *item) {
     if (!object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
@@ -177,13 +422,25 @@ bool coral$tree_set$delete(struct coral$tree_set *object, const void *item) {
         coral_error = CORAL_ERROR_OBJECT_UNAVAILABLE;
         return false;
     }
-    void *node;
-    if (!coral$red_black_tree$search(&object->tree, NULL, item,
-                                     &node)) {
-        return false;
+    if (CORAL_TREE_SET_ENGINE_B_TREE == object->engine) {
+        if (!coral$b_tree$delete(&object->b_tree, item)) {
+            return false;
+        }
+    } else if (CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+               == object->engine) {
+        if (!coral$compact_red_black_tree$delete(&object->compact_tree,
+                                                 item)) {
+            return false;
+        }
+    } else {
+        void *node;
+        if (!coral$red_black_tree$search(&object->tree, NULL, item,
+                                         &node)) {
+            return false;
+        }
+        coral_required_true(coral$red_black_tree$delete(
+                &object->tree, node));
     }
-    coral_required_true(coral$red_black_tree$delete(
-            &object->tree, node));
     atomic_fetch_add(&object->id, 1);
     object->count -= 1;
     return true;
@@ -200,11 +457,31 @@ bool coral$tree_set$contains(struct coral$tree_set *object, const void *item,
         return false;
     }
     void *node;
-    *out = coral$red_black_tree$search(&object->tree, NULL, item,
-                                       &node);
+    *out = coral$tree_set$search(object, item, &node);
     return true;
 }
 
+bool coral$tree_set$search(struct coral$tree_set *object, const void *item,
+                           void **out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!item || !out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    switch (object->engine) {
+        case CORAL_TREE_SET_ENGINE_B_TREE:
+            return coral$b_tree$search(&object->b_tree, item, out);
+        case CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE:
+            return $compact_search(&object->compact_tree, item, out);
+        default:
+            return coral$red_black_tree$search(&object->tree, NULL, item,
+                                               out);
+    }
+}
+
 bool coral$tree_set$get_first(struct coral$tree_set *object, void **out) {
     if (!object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
@@ -215,14 +492,63 @@ bool coral$tree_set$get_first(struct coral$tree_set *object, void **out) {
         return false;
     }
     void *node;
-    const bool result = coral$red_black_tree$get_first(
-            &object->tree, &node);
+    bool result;
+    switch (object->engine) {
+        case CORAL_TREE_SET_ENGINE_B_TREE:
+            result = coral$b_tree$get_first(&object->b_tree, &node);
+            break;
+        case CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE:
+            result = $compact_get_first(&object->compact_tree, &node);
+            break;
+        default:
+            result = coral$red_black_tree$get_first(&object->tree, &node);
+            break;
+    }
+    if (result) {
+        memcpy(out, node, object->size);
+    }
+    return result;
+}
+
+bool coral$tree_set$get_at(struct coral$tree_set *object, const size_t at,
+                           void **out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE != object->engine) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    void *node;
+    const bool result = coral$red_black_tree$get_at(&object->tree, at, &node);
     if (result) {
         memcpy(out, node, object->size);
     }
     return result;
 }
 
+bool coral$tree_set$rank_of(struct coral$tree_set *object, const void *value,
+                            size_t *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!value || !out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    if (CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE != object->engine) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
+    return coral$red_black_tree$rank_of(&object->tree, value, out);
+}
+
 bool coral$tree_set$get_last(struct coral$tree_set *object, void **out) {
     if (!object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
@@ -233,8 +559,18 @@ bool coral$tree_set$get_last(struct coral$tree_set *object, void **out) {
         return false;
     }
     void *node;
-    const bool result = coral$red_black_tree$get_last(
-            &object->tree, &node);
+    bool result;
+    switch (object->engine) {
+        case CORAL_TREE_SET_ENGINE_B_TREE:
+            result = coral$b_tree$get_last(&object->b_tree, &node);
+            break;
+        case CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE:
+            result = $compact_get_last(&object->compact_tree, &node);
+            break;
+        default:
+            result = coral$red_black_tree$get_last(&object->tree, &node);
+            break;
+    }
     if (result) {
         memcpy(out, node, object->size);
     }
@@ -252,8 +588,20 @@ bool coral$tree_set$get_next(struct coral$tree_set *object, const void *value,
         return false;
     }
     void *node;
-    bool result = coral$red_black_tree$search(&object->tree, NULL, value, &node)
-                  && coral$red_black_tree$get_next(node, &node);
+    bool result;
+    switch (object->engine) {
+        case CORAL_TREE_SET_ENGINE_B_TREE:
+            result = coral$b_tree$get_next(&object->b_tree, value, &node);
+            break;
+        case CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE:
+            result = $compact_get_next(&object->compact_tree, value, &node);
+            break;
+        default:
+            result = coral$red_black_tree$search(&object->tree, NULL, value,
+                                                 &node)
+                     && coral$red_black_tree$get_next(node, &node);
+            break;
+    }
     if (result) {
         memcpy(out, node, object->size);
     }
@@ -271,8 +619,20 @@ bool coral$tree_set$get_prev(struct coral$tree_set *object, const void *value,
         return false;
     }
     void *node;
-    bool result = coral$red_black_tree$search(&object->tree, NULL, value, &node)
-                  && coral$red_black_tree$get_prev(node, &node);
+    bool result;
+    switch (object->engine) {
+        case CORAL_TREE_SET_ENGINE_B_TREE:
+            result = coral$b_tree$get_prev(&object->b_tree, value, &node);
+            break;
+        case CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE:
+            result = $compact_get_prev(&object->compact_tree, value, &node);
+            break;
+        default:
+            result = coral$red_black_tree$search(&object->tree, NULL, value,
+                                                 &node)
+                     && coral$red_black_tree$get_prev(node, &node);
+            break;
+    }
     if (result) {
         memcpy(out, node, object->size);
     }
@@ -316,7 +676,7 @@ static bool $tree_set_is_equal(void *this,
     coral_required(args->other);
     coral_required(args->out);
     struct coral_tree_set *object = data;
-    struct coral_tree_set *other = args->other;
+    struct coral_tree_set *other = coral$object$get_data(args->other);
     struct {
         size_t object;
         size_t other;
@@ -362,14 +722,17 @@ static bool $tree_set_copy(void *this,
     struct coral$tree_set *object = &data->tree_set;
     struct coral$tree_set *src = &((struct coral_tree_set *) args->src)->tree_set;
 
-    if (!coral$tree_set$init(object, &src->limit, src->size,
-                             src->tree.compare)) {
+    if (!coral$tree_set$init_with_engine(object, &src->limit, src->size,
+                                         src->engine,
+                                         $tree_set_object_compare)) {
         return false;
     }
     data->compare = ((struct coral_tree_set *) args->src)->compare;
     if (!src->count) {
         return true;
     }
+    /* we are called with the lock of data held so we must insert directly */
+    $object_compare = data->compare;
     void *i;
     if (!coral$tree_set$get_first(src, &i)
         && CORAL_ERROR_OBJECT_NOT_FOUND != coral_error) {
@@ -378,7 +741,12 @@ static bool $tree_set_copy(void *this,
     do {
         void *o;
         if (!coral_object_copy(i, &o)
-            || !coral_tree_set_insert(data, o)) {
+            || !coral_object_retain(o)) {
+            return false;
+        }
+        $object_compare = data->compare;
+        if (!coral$tree_set$insert(object, &o)) {
+            coral_required_true(coral_object_release(o));
             return false;
         }
     } while (coral$tree_set$get_next(src, &i, &i));
@@ -412,6 +780,8 @@ static bool $tree_set_insert(void *this,
     if (coral_object_retain(args->instance)) {
         $object_compare = data->compare;
         if (coral$tree_set$insert(&data->tree_set, &args->instance)) {
+            coral$object_post_notification(
+                    this, CORAL_NOTIFICATION_CONTAINER_INCREASED);
             result = true;
         } else {
             coral_required_true(coral_object_release(args->instance));
@@ -420,6 +790,43 @@ static bool $tree_set_insert(void *this,
     return result;
 }
 
+struct $tree_set_build_args {
+    void **instances;
+    size_t count;
+    bool is_sorted;
+};
+
+static bool $tree_set_build(void *this,
+                            struct coral_tree_set *data,
+                            struct $tree_set_build_args *args) {
+    coral_required(data);
+    coral_required(args);
+    coral_required(args->instances);
+    if (!coral_object_retain_many(args->instances, args->count)) {
+        return false;
+    }
+    struct coral$array items = {
+            .count = args->count,
+            .size = sizeof(void *),
+            .data = (unsigned char *) args->instances
+    };
+    $object_compare = data->compare;
+    if (!(args->is_sorted
+          ? coral$tree_set$build(&data->tree_set, &items)
+          : coral$tree_set$build_unsorted(&data->tree_set, &items))) {
+        const size_t error = coral_error;
+        coral_required_true(coral_object_release_many(args->instances,
+                                                      args->count));
+        coral_error = error;
+        return false;
+    }
+    if (args->count) {
+        coral$object_post_notification(
+                this, CORAL_NOTIFICATION_CONTAINER_INCREASED);
+    }
+    return true;
+}
+
 struct $tree_set_delete_args {
     void *instance;
 };
@@ -434,6 +841,8 @@ static bool $tree_set_delete(void *this,
     const bool result = coral$tree_set$delete(&data->tree_set, &args->instance);
     if (result) {
         coral_required_true(coral_object_release(args->instance));
+        coral$object_post_notification(
+                this, CORAL_NOTIFICATION_CONTAINER_DECREASED);
     }
     return result;
 }
@@ -472,6 +881,42 @@ static bool $tree_set_get_first(void *this,
     return result;
 }
 
+struct $tree_set_get_at_args {
+    size_t at;
+    void **out;
+};
+
+static bool $tree_set_get_at(void *this,
+                             struct coral_tree_set *data,
+                             struct $tree_set_get_at_args *args) {
+    coral_required(data);
+    coral_required(args);
+    coral_required(args->out);
+    const bool result = coral$tree_set$get_at(&data->tree_set, args->at,
+                                              args->out);
+    if (result) {
+        coral_required_true(coral_object_autorelease(*args->out));
+    }
+    return result;
+}
+
+struct $tree_set_rank_of_args {
+    void *instance;
+    size_t *out;
+};
+
+static bool $tree_set_rank_of(void *this,
+                              struct coral_tree_set *data,
+                              struct $tree_set_rank_of_args *args) {
+    coral_required(data);
+    coral_required(args);
+    coral_required(args->out);
+    coral_required(args->instance);
+    $object_compare = data->compare;
+    return coral$tree_set$rank_of(&data->tree_set, &args->instance,
+                                  args->out);
+}
+
 struct $tree_set_get_last_args {
     void **out;
 };
@@ -551,6 +996,15 @@ bool coral_tree_set_init(struct coral_tree_set *object,
                          struct coral_range_values *limit,
                          int (*compare)(const void *first,
                                         const void *second)) {
+    return coral_tree_set_init_with_engine(
+            object, limit, CORAL_TREE_SET_ENGINE_RED_BLACK_TREE, compare);
+}
+
+bool coral_tree_set_init_with_engine(struct coral_tree_set *object,
+                                     struct coral_range_values *limit,
+                                     const int engine,
+                                     int (*compare)(const void *first,
+                                                    const void *second)) {
     if (!object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
         return false;
@@ -559,10 +1013,19 @@ bool coral_tree_set_init(struct coral_tree_set *object,
         coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
         return false;
     }
+    /* checked up front as the object cannot be taken back once initialized */
+    if (CORAL_TREE_SET_ENGINE_RED_BLACK_TREE != engine
+        && CORAL_TREE_SET_ENGINE_B_TREE != engine
+        && CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE != engine
+        && CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE != engine) {
+        coral_error = CORAL_ERROR_INVALID_VALUE;
+        return false;
+    }
     bool result = false;
     if (coral_object_init(object, $class)) {
-        if (coral$tree_set$init(&object->tree_set, limit, sizeof(void *),
-                                $tree_set_object_compare)) {
+        if (coral$tree_set$init_with_engine(&object->tree_set, limit,
+                                            sizeof(void *), engine,
+                                            $tree_set_object_compare)) {
             object->compare = compare;
             result = true;
         }
@@ -659,6 +1122,45 @@ bool coral_tree_set_insert(struct coral_tree_set *object, void *instance) {
             &args);
 }
 
+static bool $build_instances(struct coral_tree_set *object,
+                             void **instances, const size_t count,
+                             const bool is_sorted) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!instances) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!instances[i]) {
+            coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+            return false;
+        }
+    }
+    struct $tree_set_build_args args = {
+            .instances = instances,
+            .count = count,
+            .is_sorted = is_sorted
+    };
+    return coral_object_invoke(
+            object,
+            false,
+            (coral_invokable_t) $tree_set_build,
+            &args);
+}
+
+bool coral_tree_set_build(struct coral_tree_set *object, void **instances,
+                          const size_t count) {
+    return $build_instances(object, instances, count, true);
+}
+
+bool coral_tree_set_build_unsorted(struct coral_tree_set *object,
+                                   void **instances, const size_t count) {
+    return $build_instances(object, instances, count, false);
+}
+
 bool coral_tree_set_delete(struct coral_tree_set *object, void *instance) {
     if (!object) {
         coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
@@ -737,6 +1239,48 @@ bool coral_tree_set_get_last(struct coral_tree_set *object, void **out) {
             &args);
 }
 
+bool coral_tree_set_get_at(struct coral_tree_set *object, const size_t at,
+                           void **out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    struct $tree_set_get_at_args args = {
+            .at = at,
+            .out = out
+    };
+    return coral_object_invoke(
+            object,
+            true,
+            (coral_invokable_t) $tree_set_get_at,
+            &args);
+}
+
+bool coral_tree_set_rank_of(struct coral_tree_set *object, void *instance,
+                            size_t *out) {
+    if (!object) {
+        coral_error = CORAL_ERROR_OBJECT_PTR_IS_NULL;
+        return false;
+    }
+    if (!instance || !out) {
+        coral_error = CORAL_ERROR_ARGUMENT_PTR_IS_NULL;
+        return false;
+    }
+    struct $tree_set_rank_of_args args = {
+            .instance = instance,
+            .out = out
+    };
+    return coral_object_invoke(
+            object,
+            true,
+            (coral_invokable_t) $tree_set_rank_of,
+            &args);
+}
+
 bool coral_tree_set_get_next(struct coral_tree_set *object, void *instance,
                              void **out) {
     if (!object) {
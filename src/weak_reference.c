@@ -3,6 +3,7 @@
 
 #include "private/weak_reference.h"
 #include "private/class.h"
+#include "private/object.h"
 #include "test/cmocka.h"
 
 #pragma mark private -
@@ -37,7 +38,7 @@ static void $on_load() {
     };
     coral_required_true(coral_class_alloc(&$class));
     coral_required_true(coral_class_init($class));
-    coral_required_true(coral_class_retain($class));
+    coral_required_true(coral$object$set_immortal($class));
     /* destroy */
     coral_required_true(coral_class_method_add(
             $class, &$method_names[0],
@@ -54,6 +55,7 @@ static void $on_load() {
     coral_required_true(coral_class_method_add(
             $class, &$method_names[3],
             (coral_invokable_t) $weak_reference_copy));
+    coral_required_true(coral_class_freeze($class));
 
     coral_autorelease_pool_drain();
 }
@@ -172,7 +174,7 @@ static bool $weak_reference_is_equal(void *this,
         }
     }
     struct coral_weak_reference *object = data;
-    struct coral_weak_reference *other = args->other;
+    struct coral_weak_reference *other = coral$object$get_data(args->other);
     args->other = other->weak_reference.object;
     bool result = coral_object_dispatch(object->weak_reference.object,
                                         true,
@@ -0,0 +1,300 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <stdalign.h>
+#include <coral.h>
+
+#include "private/allocator.h"
+
+struct $counter {
+    size_t allocations;
+    size_t reallocations;
+    size_t deallocations;
+    /* blocks in use per tag */
+    size_t live[1 + CORAL_ALLOCATOR_TAG_STRING];
+};
+
+static void *$counting_alloc(void *context, const size_t tag,
+                             const size_t size, const size_t alignment) {
+    struct $counter *counter = context;
+    counter->allocations++;
+    counter->live[tag]++;
+    return malloc(size);
+}
+
+static void *$counting_realloc(void *context, const size_t tag, void *ptr,
+                               const size_t size, const size_t new_size,
+                               const size_t alignment) {
+    struct $counter *counter = context;
+    counter->reallocations++;
+    return realloc(ptr, new_size);
+}
+
+static void $counting_free(void *context, const size_t tag, void *ptr,
+                           const size_t size, const size_t alignment) {
+    struct $counter *counter = context;
+    counter->deallocations++;
+    assert_true(counter->live[tag]);
+    counter->live[tag]--;
+    free(ptr);
+}
+
+static void check_set_global_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_allocator allocator = {};
+    assert_false(coral_allocator_set_global(&allocator));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_set_thread_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_allocator allocator = {};
+    assert_false(coral_allocator_set_thread(&allocator));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_error_on_argument_ptr_is_null(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_allocator_get(NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_allocator *default_;
+    assert_true(coral_allocator_get(&default_));
+    assert_non_null(default_);
+    assert_true(coral$allocator$is_default());
+    const struct coral_allocator global = {
+            .allocate = $counting_alloc
+    };
+    const struct coral_allocator thread = {
+            .allocate = $counting_alloc
+    };
+    const struct coral_allocator *out;
+    assert_true(coral_allocator_set_global(&global));
+    assert_true(coral_allocator_get(&out));
+    assert_ptr_equal(&global, out);
+    assert_true(coral_allocator_set_thread(&thread));
+    assert_true(coral_allocator_get(&out));
+    assert_ptr_equal(&thread, out);
+    assert_false(coral$allocator$is_default());
+    assert_true(coral_allocator_set_thread(NULL));
+    assert_true(coral_allocator_get(&out));
+    assert_ptr_equal(&global, out);
+    assert_true(coral_allocator_set_global(NULL));
+    assert_true(coral_allocator_get(&out));
+    assert_ptr_equal(default_, out);
+    assert_true(coral$allocator$is_default());
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_alloc_realloc_free(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct $counter counter = {};
+    const struct coral_allocator allocator = {
+            .allocate = $counting_alloc,
+            .reallocate = $counting_realloc,
+            .deallocate = $counting_free,
+            .context = &counter
+    };
+    assert_true(coral_allocator_set_thread(&allocator));
+    unsigned char *block;
+    assert_true(coral$allocator$calloc(CORAL_ALLOCATOR_TAG_OTHER, 4, 8,
+                                       (void **) &block));
+    assert_int_equal(0, (uintptr_t) block % alignof(max_align_t));
+    for (size_t i = 0; i < 32; i++) {
+        assert_int_equal(0, block[i]);
+    }
+    memset(block, 0xff, 32);
+    assert_true(coral$allocator$realloc(CORAL_ALLOCATOR_TAG_OTHER, block, 4096,
+                                        (void **) &block));
+    for (size_t i = 0; i < 32; i++) {
+        assert_int_equal(0xff, block[i]);
+    }
+    assert_true(coral_allocator_set_thread(NULL));
+    /* the block goes back to the allocator it came from */
+    coral$allocator$free(block);
+    assert_int_equal(1, counter.allocations);
+    assert_int_equal(1, counter.reallocations);
+    assert_int_equal(1, counter.deallocations);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_realloc_without_reallocate(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct $counter counter = {};
+    const struct coral_allocator allocator = {
+            .allocate = $counting_alloc,
+            .deallocate = $counting_free,
+            .context = &counter
+    };
+    assert_true(coral_allocator_set_thread(&allocator));
+    unsigned char *block;
+    assert_true(coral$allocator$alloc(CORAL_ALLOCATOR_TAG_OTHER, 16,
+                                      (void **) &block));
+    memset(block, 0xab, 16);
+    assert_true(coral$allocator$realloc(CORAL_ALLOCATOR_TAG_OTHER, block, 1024,
+                                        (void **) &block));
+    for (size_t i = 0; i < 16; i++) {
+        assert_int_equal(0xab, block[i]);
+    }
+    coral$allocator$free(block);
+    assert_true(coral_allocator_set_thread(NULL));
+    assert_int_equal(2, counter.allocations);
+    assert_int_equal(0, counter.reallocations);
+    assert_int_equal(2, counter.deallocations);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+struct $bump {
+    unsigned char *data;
+    size_t size;
+    size_t used;
+};
+
+static void *$bump_alloc(void *context, const size_t tag,
+                         const size_t size, const size_t alignment) {
+    struct $bump *bump = context;
+    const size_t used = (bump->used + alignment - 1) & ~(alignment - 1);
+    if (used + size > bump->size) {
+        return NULL;
+    }
+    bump->used = used + size;
+    return bump->data + used;
+}
+
+static void check_free_without_deallocate(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    alignas(max_align_t) unsigned char data[256];
+    struct $bump bump = {
+            .data = data,
+            .size = sizeof(data)
+    };
+    const struct coral_allocator allocator = {
+            .allocate = $bump_alloc,
+            .context = &bump
+    };
+    assert_true(coral_allocator_set_thread(&allocator));
+    void *block;
+    assert_true(coral$allocator$alloc(CORAL_ALLOCATOR_TAG_OTHER, 64, &block));
+    coral$allocator$free(block);
+    assert_false(coral$allocator$alloc(CORAL_ALLOCATOR_TAG_OTHER, sizeof(data),
+                                       &block));
+    assert_int_equal(CORAL_ERROR_MEMORY_ALLOCATION_FAILED, coral_error);
+    assert_true(coral_allocator_set_thread(NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_objects_use_allocator(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct $counter counter = {};
+    const struct coral_allocator allocator = {
+            .allocate = $counting_alloc,
+            .reallocate = $counting_realloc,
+            .deallocate = $counting_free,
+            .context = &counter
+    };
+    assert_true(coral_allocator_set_thread(&allocator));
+    struct coral_array *array;
+    assert_true(coral_array_alloc(&array));
+    assert_true(coral_array_init(array, NULL, 16));
+    struct coral_integer *integer;
+    assert_true(coral_integer_alloc(&integer));
+    assert_true(coral_integer_init(integer));
+    assert_true(coral_allocator_set_thread(NULL));
+    /* object and data of the array as well as the object of the integer */
+    assert_true(counter.allocations >= 3);
+    /* both were autoreleased when they were allocated */
+    coral_autorelease_pool_drain();
+    assert_int_equal(counter.allocations, counter.deallocations);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_realloc_with_other_tag(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct $counter counter = {};
+    const struct coral_allocator allocator = {
+            .allocate = $counting_alloc,
+            .reallocate = $counting_realloc,
+            .deallocate = $counting_free,
+            .context = &counter
+    };
+    assert_true(coral_allocator_set_thread(&allocator));
+    unsigned char *block;
+    assert_true(coral$allocator$alloc(CORAL_ALLOCATOR_TAG_ARRAY, 16,
+                                      (void **) &block));
+    memset(block, 0xab, 16);
+    /* the block moves over to the new tag instead of being resized */
+    assert_true(coral$allocator$realloc(CORAL_ALLOCATOR_TAG_STRING, block, 32,
+                                        (void **) &block));
+    for (size_t i = 0; i < 16; i++) {
+        assert_int_equal(0xab, block[i]);
+    }
+    assert_int_equal(0, counter.live[CORAL_ALLOCATOR_TAG_ARRAY]);
+    assert_int_equal(1, counter.live[CORAL_ALLOCATOR_TAG_STRING]);
+    coral$allocator$free(block);
+    assert_true(coral_allocator_set_thread(NULL));
+    assert_int_equal(0, counter.reallocations);
+    assert_int_equal(0, counter.live[CORAL_ALLOCATOR_TAG_STRING]);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_blocks_are_tagged(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct $counter counter = {};
+    const struct coral_allocator allocator = {
+            .allocate = $counting_alloc,
+            .reallocate = $counting_realloc,
+            .deallocate = $counting_free,
+            .context = &counter
+    };
+    struct coral_class *class;
+    assert_true(coral_object_class(&class));
+    assert_true(coral_allocator_set_thread(&allocator));
+    struct coral_array *array;
+    assert_true(coral_array_alloc(&array));
+    assert_true(coral_array_init(array, NULL, 16));
+    struct coral_integer *integer;
+    assert_true(coral_integer_of_char_ptr(
+            &integer, "1234567890123456789012345678901234567890"));
+    struct coral_tree_set *set;
+    assert_true(coral_tree_set_alloc(&set));
+    assert_true(coral_tree_set_init(set, NULL, coral_compare_void_ptr));
+    void *object;
+    assert_true(coral_object_alloc(0, &object));
+    assert_true(coral_object_init(object, class));
+    assert_true(coral_tree_set_insert(set, object));
+    assert_true(coral_allocator_set_thread(NULL));
+    assert_true(counter.live[CORAL_ALLOCATOR_TAG_OBJECT] >= 4);
+    assert_true(counter.live[CORAL_ALLOCATOR_TAG_ARRAY] >= 1);
+    assert_true(counter.live[CORAL_ALLOCATOR_TAG_TREE_NODE] >= 1);
+    coral_autorelease_pool_drain();
+    /* every block was returned with the tag it was allocated with */
+    for (size_t i = 0; i <= CORAL_ALLOCATOR_TAG_STRING; i++) {
+        assert_int_equal(0, counter.live[i]);
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_set_global_error_on_invalid_value),
+            cmocka_unit_test(check_set_thread_error_on_invalid_value),
+            cmocka_unit_test(check_get_error_on_argument_ptr_is_null),
+            cmocka_unit_test(check_get),
+            cmocka_unit_test(check_alloc_realloc_free),
+            cmocka_unit_test(check_realloc_without_reallocate),
+            cmocka_unit_test(check_free_without_deallocate),
+            cmocka_unit_test(check_realloc_with_other_tag),
+            cmocka_unit_test(check_objects_use_allocator),
+            cmocka_unit_test(check_blocks_are_tagged),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -7,6 +7,7 @@
 
 #include "private/array.h"
 #include "private/coral.h"
+#include "private/object.h"
 #include "test/cmocka.h"
 
 static void check_invalidate_error_on_null_object_ptr(void **state) {
@@ -1411,6 +1412,63 @@ static void check_object_add(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void check_object_set_keeps_instance_on_error(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_array *object;
+    assert_true(coral_array_alloc(&object));
+    assert_true(coral_array_init(object, NULL, 1));
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *i, *j;
+    assert_true(coral_object_alloc(0, &i));
+    assert_true(coral_object_init(i, class));
+    assert_true(coral_object_alloc(0, &j));
+    assert_true(coral_array_set(object, 0, i));
+    assert_false(coral_array_set(object, 0, j));
+    assert_int_equal(CORAL_ERROR_OBJECT_IS_UNINITIALIZED, coral_error);
+    /* the failed set must not have released the instance it would replace */
+    size_t count;
+    assert_true(coral$object$get_ref_count(coral$object_from(i), &count));
+    assert_int_equal(2, count);
+    void *out;
+    assert_true(coral_array_get(object, 0, &out));
+    assert_ptr_equal(i, out);
+    assert_true(coral_object_destroy(j));
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void $on_event(void *observer, void *object, const char *event) {
+    const char **events = observer;
+    while (*events) {
+        events++;
+    }
+    *events = event;
+}
+
+static void check_object_notifications(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_array *object;
+    assert_true(coral_array_alloc(&object));
+    assert_true(coral_array_init(object, NULL, 0));
+    const char *events[5] = {};
+    assert_true(coral$object_add_observer(object, events, NULL, $on_event));
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *i;
+    assert_true(coral_object_alloc(0, &i));
+    assert_true(coral_object_init(i, class));
+    assert_true(coral_array_add(object, i));
+    assert_true(coral_array_set(object, 0, NULL));
+    assert_true(coral_array_remove(object));
+    coral_autorelease_pool_drain();
+    assert_ptr_equal(CORAL_NOTIFICATION_CONTAINER_INCREASED, events[0]);
+    assert_ptr_equal(CORAL_NOTIFICATION_CONTAINER_CHANGED, events[1]);
+    assert_ptr_equal(CORAL_NOTIFICATION_CONTAINER_DECREASED, events[2]);
+    assert_ptr_equal(CORAL_NOTIFICATION_OBJECT_DESTROYED, events[3]);
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_object_remove_error_on_null_object_ptr(void **state) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral_array_remove(NULL));
@@ -1902,6 +1960,8 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_object_add_error_on_null_object_ptr),
             cmocka_unit_test(check_object_add_error_on_object_uninitialized),
             cmocka_unit_test(check_object_add),
+            cmocka_unit_test(check_object_set_keeps_instance_on_error),
+            cmocka_unit_test(check_object_notifications),
             cmocka_unit_test(check_object_remove_error_on_null_object_ptr),
             cmocka_unit_test(check_object_remove_error_on_object_uninitialized),
             cmocka_unit_test(check_object_remove_error_on_object_not_found),
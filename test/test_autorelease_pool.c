@@ -6,108 +6,308 @@
 
 #include "private/coral.h"
 #include "private/autorelease_pool.h"
+#include "private/object.h"
+
+static void $assert_state(const size_t depth, const size_t count) {
+    struct coral_autorelease_pool_statistics statistics;
+    assert_true(coral_autorelease_pool_get_statistics(&statistics));
+    assert_int_equal(depth, statistics.depth);
+    assert_int_equal(count, statistics.pending);
+}
+
+static size_t $coalesced() {
+    struct coral_autorelease_pool_statistics statistics;
+    assert_true(coral_autorelease_pool_get_statistics(&statistics));
+    return statistics.coalesced;
+}
 
 static void check_start(void **state) {
     coral_error = CORAL_ERROR_NONE;
-    struct coral$autorelease_pool$entry *stack;
-    coral$autorelease_pool$get_stack(&stack);
-    assert_null(stack);
-    struct coral$autorelease_pool$entry *items;
-    coral$autorelease_pool$get_items(&items);
-    assert_null(items);
-    coral$autorelease_pool$start();
-    coral$autorelease_pool$get_stack(&stack);
-    assert_non_null(stack);
-    coral$autorelease_pool$get_items(&items);
-    assert_non_null(items);
-    assert_ptr_equal(stack->object, items);
-    assert_null(stack->next);
-    assert_null(items->object);
-    assert_null(items->next);
+    $assert_state(0, 0);
+    assert_int_equal(0, coral$autorelease_pool$start());
+    $assert_state(1, 0);
+    struct coral_integer *i;
+    assert_true(coral_integer_of_size_t(&i, 0));
+    $assert_state(1, 1);
+    assert_int_equal(0, coral$autorelease_pool$start());
+    $assert_state(2, 1);
+    assert_int_equal(1, coral$autorelease_pool$start());
+    $assert_state(3, 1);
     coral_autorelease_pool_drain();
+    $assert_state(0, 0);
     coral_error = CORAL_ERROR_NONE;
 }
 
 static void check_end(void **state) {
     coral_error = CORAL_ERROR_NONE;
-    coral$autorelease_pool$start();
-    struct coral$autorelease_pool$entry *stack;
-    struct coral$autorelease_pool$entry *items;
-    coral$autorelease_pool$get_stack(&stack);
-    assert_non_null(stack);
-    coral$autorelease_pool$get_items(&items);
-    assert_non_null(items);
-    assert_ptr_equal(stack->object, items);
-    assert_null(stack->next);
-    assert_null(items->object);
-    assert_null(items->next);
-    coral$autorelease_pool$end();
-    coral$autorelease_pool$get_stack(&stack);
-    assert_null(stack);
-    coral$autorelease_pool$get_items(&items);
-    assert_null(items);
+    const size_t watermark = coral$autorelease_pool$start();
+    $assert_state(1, 0);
+    coral$autorelease_pool$end(watermark);
+    $assert_state(0, 0);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_end_after_drain(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_integer *i;
+    assert_true(coral_integer_of_size_t(&i, 0));
+    const size_t outer = coral$autorelease_pool$start();
+    assert_true(coral_integer_of_size_t(&i, 1));
+    const size_t inner = coral$autorelease_pool$start();
+    coral_autorelease_pool_drain();
+    $assert_state(0, 0);
+    coral$autorelease_pool$end(inner);
+    $assert_state(0, 0);
+    coral$autorelease_pool$end(outer);
+    $assert_state(0, 0);
     coral_error = CORAL_ERROR_NONE;
 }
 
 static void check_add(void **state) {
     coral_error = CORAL_ERROR_NONE;
-    coral$autorelease_pool$start();
+    const size_t watermark = coral$autorelease_pool$start();
     struct coral_integer *i;
     assert_true(coral_integer_of_size_t(&i, 0));
-    struct coral$autorelease_pool$entry *stack;
-    coral$autorelease_pool$get_stack(&stack);
-    assert_non_null(stack);
-    struct coral$autorelease_pool$entry *items;
-    coral$autorelease_pool$get_items(&items);
-    assert_non_null(items);
-    assert_ptr_equal(stack->object, items->next);
-    assert_null(stack->next);
-    assert_ptr_equal(i, items->object);
-    coral$autorelease_pool$end();
-    coral$autorelease_pool$get_stack(&stack);
-    assert_null(stack);
-    coral$autorelease_pool$get_items(&items);
-    assert_null(items);
+    $assert_state(1, 1);
+    coral$autorelease_pool$end(watermark);
+    $assert_state(0, 0);
     coral_autorelease_pool_drain();
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void check_add_to_enclosing_pool(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_integer *i;
+    const size_t outer = coral$autorelease_pool$start();
+    assert_true(coral_integer_of_size_t(&i, 0));
+    assert_true(coral_integer_retain(i));
+    const size_t inner = coral$autorelease_pool$start();
+    assert_true(coral_integer_retain(i));
+    coral$autorelease_pool$add(i);
+    $assert_state(2, 2);
+    coral$autorelease_pool$end(inner);
+    $assert_state(1, 1);
+    coral$autorelease_pool$end(outer);
+    $assert_state(0, 0);
+    assert_true(coral_integer_release(i));
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_add_previous(void **state) {
     coral_error = CORAL_ERROR_NONE;
-    coral$autorelease_pool$start();
+    const size_t watermark = coral$autorelease_pool$start();
+    struct coral_integer *i;
+    assert_true(coral_integer_of_size_t(&i, 0));
+    assert_true(coral_integer_retain(i));
+    coral$autorelease_pool$add_previous(i);
+    $assert_state(1, 2);
+    coral$autorelease_pool$end(watermark);
+    $assert_state(0, 1);
+    coral_autorelease_pool_drain();
+    $assert_state(0, 0);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_autorelease_into_current_pool(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const size_t watermark = coral$autorelease_pool$start();
     struct coral_integer *i;
     assert_true(coral_integer_of_size_t(&i, 0));
     assert_true(coral_integer_autorelease(i));
-    struct coral$autorelease_pool$entry *stack;
-    coral$autorelease_pool$get_stack(&stack);
-    assert_non_null(stack);
-    struct coral$autorelease_pool$entry *items;
-    coral$autorelease_pool$get_items(&items);
-    assert_non_null(items);
-    coral$autorelease_pool$end();
-    coral$autorelease_pool$get_stack(&stack);
-    assert_null(stack);
-    coral$autorelease_pool$get_items(&items);
-    assert_non_null(items);
-    assert_ptr_equal(i, items->object);
-    assert_null(items->next);
+    $assert_state(1, 2);
+    coral$autorelease_pool$end(watermark);
+    $assert_state(0, 0);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_add_previous_without_pool(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_integer *i;
+    assert_true(coral_integer_of_size_t(&i, 0));
+    assert_true(coral_integer_retain(i));
+    coral$autorelease_pool$add_previous(i);
+    $assert_state(0, 2);
+    coral_autorelease_pool_drain();
+    $assert_state(0, 0);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_add_previous_across_chunks(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const size_t count = 3000;
+    struct coral_integer *i;
+    assert_true(coral_integer_of_size_t(&i, 0));
+    assert_true(coral_integer_retain(i));
+    const size_t outer = coral$autorelease_pool$start();
+    const size_t inner = coral$autorelease_pool$start();
+    for (size_t j = 0; j < count; j++) {
+        assert_true(coral_integer_retain(i));
+        coral$autorelease_pool$add(i);
+    }
+    /* shifts all entries of the inner pool by one slot */
+    assert_true(coral_integer_retain(i));
+    coral$autorelease_pool$add_previous(i);
+    $assert_state(2, 2 + count);
+    coral$autorelease_pool$end(inner);
+    $assert_state(1, 2);
+    coral$autorelease_pool$end(outer);
+    $assert_state(0, 1);
+    coral_autorelease_pool_drain();
+    $assert_state(0, 0);
+    assert_true(coral_integer_release(i));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_chunks_are_reused(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_integer *i;
+    assert_true(coral_integer_of_size_t(&i, 0));
+    assert_true(coral_integer_retain(i));
+    coral_autorelease_pool_drain();
+    size_t chunks, before = 0;
+    for (size_t round = 0; round < 10; round++) {
+        const size_t watermark = coral$autorelease_pool$start();
+        for (size_t j = 0; j < 2000; j++) {
+            assert_true(coral_integer_retain(i));
+            coral$autorelease_pool$add(i);
+        }
+        coral$autorelease_pool$end(watermark);
+        coral$autorelease_pool$get_chunks(&chunks);
+        assert_true(chunks > 1);
+        if (round) {
+            assert_int_equal(before, chunks);
+        }
+        before = chunks;
+    }
+    assert_true(coral_integer_release(i));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_coalescing(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    coral_autorelease_pool_set_coalescing(true);
+    struct coral_integer *i, *j;
+    assert_true(coral_integer_of_size_t(&i, 0));
+    assert_true(coral_integer_retain(i));
+    const size_t before = $coalesced();
+    const size_t watermark = coral$autorelease_pool$start();
+    /* more than a single batch of tallies */
+    for (size_t k = 0; k < 3000; k++) {
+        assert_true(coral_integer_retain(i));
+        coral$autorelease_pool$add(i);
+    }
+    assert_true(coral_integer_of_size_t(&j, 1));
+    $assert_state(1, 3002);
+    coral$autorelease_pool$end(watermark);
+    $assert_state(0, 1);
+    const size_t after = $coalesced();
+    assert_int_equal(2997, after - before);
+    size_t ref_count;
+    assert_true(coral$object$get_ref_count(coral$object_from(i), &ref_count));
+    assert_int_equal(2, ref_count);
+    assert_true(coral_integer_release(i));
+    coral_autorelease_pool_drain();
+    assert_int_equal(after, $coalesced());
+    coral_autorelease_pool_set_coalescing(false);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_coalescing_on_drain(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    coral_autorelease_pool_set_coalescing(true);
+    struct coral_integer *i;
+    assert_true(coral_integer_of_size_t(&i, 0));
+    assert_true(coral_integer_autorelease(i));
+    assert_true(coral_integer_autorelease(i));
+    const size_t before = $coalesced();
+    coral_autorelease_pool_drain();
+    assert_int_equal(2, $coalesced() - before);
+    $assert_state(0, 0);
+    coral_autorelease_pool_set_coalescing(false);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_statistics_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_autorelease_pool_get_statistics(NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_statistics(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_autorelease_pool_statistics before, after;
+    assert_true(coral_autorelease_pool_get_statistics(&before));
+    coral_autorelease_pool_reset_high_water_mark();
+    struct coral_integer *i;
+    const size_t watermark = coral$autorelease_pool$start();
+    for (size_t j = 0; j < 5; j++) {
+        assert_true(coral_integer_of_size_t(&i, j));
+    }
+    assert_true(coral_autorelease_pool_get_statistics(&after));
+    assert_int_equal(1, after.depth);
+    assert_int_equal(5, after.pending);
+    assert_int_equal(5, after.high_water_mark);
+    assert_int_equal(before.drained, after.drained);
+    coral$autorelease_pool$end(watermark);
+    assert_true(coral_autorelease_pool_get_statistics(&after));
+    assert_int_equal(0, after.depth);
+    assert_int_equal(0, after.pending);
+    assert_int_equal(5, after.high_water_mark);
+    assert_int_equal(5 + before.drained, after.drained);
+    coral_autorelease_pool_reset_high_water_mark();
+    assert_true(coral_autorelease_pool_get_statistics(&after));
+    assert_int_equal(0, after.high_water_mark);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_class_counts_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_autorelease_pool_get_class_counts(NULL, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+struct $class_count {
+    struct coral_class *class;
+    size_t count;
+};
+
+static void $on_class(struct coral_class *class, size_t count,
+                      struct $class_count *args) {
+    /* the classes themselves are pending in the class of classes */
+    for (; args->class && args->class != class; args++);
+    args->count += count;
+}
+
+static void check_get_class_counts(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct $class_count counts[41] = {};
+    for (size_t c = 0; c < 40; c++) {
+        assert_true(coral_class_alloc(&counts[c].class));
+        assert_true(coral_class_init(counts[c].class));
+        for (size_t j = 0; j <= c; j++) {
+            void *object;
+            assert_true(coral_object_alloc(0, &object));
+            assert_true(coral_object_init(object, counts[c].class));
+        }
+    }
+    assert_true(coral_autorelease_pool_get_class_counts(
+            (void (*)(struct coral_class *, size_t, void *)) $on_class,
+            counts));
+    for (size_t c = 0; c < 40; c++) {
+        assert_int_equal(1 + c, counts[c].count);
+    }
+    assert_int_equal(40, counts[40].count);
     coral_autorelease_pool_drain();
     coral_error = CORAL_ERROR_NONE;
 }
 
 static void check_drain_with_nothing_to_do() {
     coral_error = CORAL_ERROR_NONE;
-    struct coral$autorelease_pool$entry *stack;
-    coral$autorelease_pool$get_stack(&stack);
-    assert_null(stack);
-    struct coral$autorelease_pool$entry *items;
-    coral$autorelease_pool$get_items(&items);
-    assert_null(items);
+    $assert_state(0, 0);
     coral_autorelease_pool_drain();
-    coral$autorelease_pool$get_stack(&stack);
-    assert_null(stack);
-    coral$autorelease_pool$get_items(&items);
-    assert_null(items);
+    $assert_state(0, 0);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -115,17 +315,10 @@ static void check_drain() {
     coral_error = CORAL_ERROR_NONE;
     struct coral_integer *i;
     assert_true(coral_integer_of_size_t(&i, 10));
-    struct coral$autorelease_pool$entry *stack;
-    coral$autorelease_pool$get_stack(&stack);
-    assert_null(stack);
-    struct coral$autorelease_pool$entry *items;
-    coral$autorelease_pool$get_items(&items);
-    assert_non_null(items);
+    coral$autorelease_pool$start();
+    $assert_state(1, 1);
     coral_autorelease_pool_drain();
-    coral$autorelease_pool$get_stack(&stack);
-    assert_null(stack);
-    coral$autorelease_pool$get_items(&items);
-    assert_null(items);
+    $assert_state(0, 0);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -133,8 +326,20 @@ int main(int argc, char *argv[]) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(check_start),
             cmocka_unit_test(check_end),
+            cmocka_unit_test(check_end_after_drain),
             cmocka_unit_test(check_add),
+            cmocka_unit_test(check_add_to_enclosing_pool),
             cmocka_unit_test(check_add_previous),
+            cmocka_unit_test(check_add_previous_without_pool),
+            cmocka_unit_test(check_autorelease_into_current_pool),
+            cmocka_unit_test(check_add_previous_across_chunks),
+            cmocka_unit_test(check_chunks_are_reused),
+            cmocka_unit_test(check_coalescing),
+            cmocka_unit_test(check_coalescing_on_drain),
+            cmocka_unit_test(check_get_statistics_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_statistics),
+            cmocka_unit_test(check_get_class_counts_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_class_counts),
             cmocka_unit_test(check_drain_with_nothing_to_do),
             cmocka_unit_test(check_drain),
     };
@@ -0,0 +1,679 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <coral.h>
+
+#include "private/b_tree.h"
+#include "test/cmocka.h"
+
+/* wide items keep the order low, so that a few thousand items make for a
+ * tree of several levels */
+#define SIZE    256
+
+static bool insert(struct coral$b_tree *object, const size_t key) {
+    unsigned char item[SIZE] = {};
+    memcpy(item, &key, sizeof(key));
+    return coral$b_tree$insert(object, item);
+}
+
+static unsigned char *keys_of(struct coral$b_tree *object,
+                              struct coral$b_tree$inner *node) {
+    return (unsigned char *) &node->children[1 + object->inner_order];
+}
+
+static size_t item_at(const unsigned char *items, const size_t i) {
+    size_t item;
+    memcpy(&item, items + i * SIZE, sizeof(item));
+    return item;
+}
+
+/* Items of the subtree at node must lie within [lower, upper), returns the
+ * count of items it holds while collecting its leaves in order. */
+static size_t check_subtree(struct coral$b_tree *object, void *node,
+                            const size_t height, const bool is_root,
+                            const size_t lower, const size_t upper,
+                            struct coral$b_tree$leaf **leaves) {
+    if (1 == height) {
+        struct coral$b_tree$leaf *leaf = node;
+        assert_true(leaf->count <= object->leaf_order);
+        if (!is_root) {
+            assert_true(leaf->count >= object->leaf_order / 2);
+        }
+        for (size_t i = 0; i < leaf->count; i++) {
+            const size_t item = item_at(leaf->items, i);
+            assert_true(lower <= item);
+            assert_true(item < upper);
+            if (i) {
+                assert_true(item_at(leaf->items, i - 1) < item);
+            }
+        }
+        assert_ptr_equal(*leaves ? *leaves : NULL, leaf->prev);
+        if (*leaves) {
+            assert_ptr_equal(leaf, (*leaves)->next);
+        } else {
+            assert_ptr_equal(leaf, object->first);
+        }
+        *leaves = leaf;
+        return leaf->count;
+    }
+    struct coral$b_tree$inner *inner = node;
+    assert_true(inner->count <= object->inner_order);
+    assert_true(inner->count >= (is_root ? 2 : object->inner_order / 2));
+    const unsigned char *keys = keys_of(object, inner);
+    size_t count = 0;
+    for (size_t i = 0; i < inner->count; i++) {
+        const size_t low = i ? item_at(keys, i - 1) : lower;
+        const size_t high = 1 + i < inner->count ? item_at(keys, i) : upper;
+        assert_true(low < high);
+        count += check_subtree(object, inner->children[i], height - 1, false,
+                               low, high, leaves);
+    }
+    return count;
+}
+
+static void check_tree(struct coral$b_tree *object) {
+    if (!object->root) {
+        assert_int_equal(0, object->height);
+        assert_int_equal(0, object->count);
+        assert_null(object->first);
+        assert_null(object->last);
+        return;
+    }
+    struct coral$b_tree$leaf *leaves = NULL;
+    assert_int_equal(object->count,
+                     check_subtree(object, object->root, object->height, true,
+                                   0, SIZE_MAX, &leaves));
+    assert_ptr_equal(object->last, leaves);
+    assert_null(leaves->next);
+}
+
+static void check_init_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$init(NULL, sizeof(size_t),
+                                   coral_compare_size_t));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$init((void *) 1, sizeof(size_t), NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$init((void *) 1, 0, coral_compare_size_t));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_error_on_memory_allocation_failed(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_false(coral$b_tree$init(&object, SIZE_MAX / 2,
+                                   coral_compare_size_t));
+    assert_int_equal(CORAL_ERROR_MEMORY_ALLOCATION_FAILED, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, sizeof(size_t),
+                                  coral_compare_size_t));
+    assert_null(object.root);
+    assert_int_equal(0, object.count);
+    assert_int_equal(0, object.height);
+    assert_int_equal(sizeof(size_t), object.size);
+    /* a full node, and the spare item, fit within the node size */
+    assert_true(sizeof(struct coral$b_tree$leaf)
+                + (1 + object.leaf_order) * sizeof(size_t)
+                <= CORAL_B_TREE_NODE_SIZE);
+    assert_true(object.leaf_order > object.inner_order);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_with_large_item(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, CORAL_B_TREE_NODE_SIZE,
+                                  coral_compare_size_t));
+    assert_int_equal(CORAL_B_TREE_ORDER_MINIMUM, object.leaf_order);
+    assert_int_equal(CORAL_B_TREE_ORDER_MINIMUM, object.inner_order);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_invalidate_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$invalidate(NULL, NULL));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static size_t $destroyed;
+
+static void $on_destroy(void *item) {
+    size_t item_;
+    memcpy(&item_, item, sizeof(item_));
+    /* in order */
+    assert_int_equal($destroyed, item_);
+    $destroyed += 1;
+}
+
+static void check_invalidate(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, SIZE,
+                                  coral_compare_size_t));
+    const size_t count = 5000;
+    for (size_t i = 0; i < count; i++) {
+        const size_t item = count - 1 - i;
+        assert_true(insert(&object, item));
+    }
+    $destroyed = 0;
+    assert_true(coral$b_tree$invalidate(&object, $on_destroy));
+    assert_int_equal(count, $destroyed);
+    assert_null(object.root);
+    assert_null(object.compare);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_count_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_count(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_count_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_count((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_count(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, SIZE,
+                                  coral_compare_size_t));
+    size_t out;
+    assert_true(coral$b_tree$get_count(&object, &out));
+    assert_int_equal(0, out);
+    for (size_t i = 0; i < 100; i++) {
+        assert_true(insert(&object, i));
+    }
+    assert_true(coral$b_tree$get_count(&object, &out));
+    assert_int_equal(100, out);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_search_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$search(NULL, (void *) 1, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_search_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$search((void *) 1, NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$search((void *) 1, (void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_search_error_on_object_not_found(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, SIZE,
+                                  coral_compare_size_t));
+    size_t item = 1;
+    void *out;
+    assert_false(coral$b_tree$search(&object, &item, &out));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_true(insert(&object, item));
+    item = 2;
+    assert_false(coral$b_tree$search(&object, &item, &out));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_search(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, SIZE,
+                                  coral_compare_size_t));
+    const size_t count = 5000;
+    for (size_t i = 0; i < count; i++) {
+        const size_t item = 2 * ((i * 7919) % count);
+        assert_true(insert(&object, item));
+    }
+    assert_true(object.height > 2);
+    for (size_t i = 0; i < 2 * count; i++) {
+        void *out;
+        if (i % 2) {
+            assert_false(coral$b_tree$search(&object, &i, &out));
+            assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+            coral_error = CORAL_ERROR_NONE;
+        } else {
+            assert_true(coral$b_tree$search(&object, &i, &out));
+            assert_int_equal(i, item_at(out, 0));
+        }
+    }
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_insert_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$insert(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_insert_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$insert((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_insert_error_on_object_already_exists(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, SIZE,
+                                  coral_compare_size_t));
+    for (size_t i = 0; i < 1000; i++) {
+        assert_true(insert(&object, i));
+    }
+    for (size_t i = 0; i < 1000; i += 37) {
+        assert_false(insert(&object, i));
+        assert_int_equal(CORAL_ERROR_OBJECT_ALREADY_EXISTS, coral_error);
+        coral_error = CORAL_ERROR_NONE;
+    }
+    assert_int_equal(1000, object.count);
+    check_tree(&object);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_insert(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, SIZE,
+                                  coral_compare_size_t));
+    size_t item = 1;
+    assert_true(insert(&object, item));
+    assert_int_equal(1, object.height);
+    assert_ptr_equal(object.root, object.first);
+    assert_ptr_equal(object.root, object.last);
+    check_tree(&object);
+    /* ascending, descending and scattered order each split differently */
+    for (size_t i = 2; i < 3000; i++) {
+        assert_true(insert(&object, i));
+        if (!(i % 97)) {
+            check_tree(&object);
+        }
+    }
+    for (size_t i = 0; i < 3000; i++) {
+        item = 9999 - i;
+        assert_true(insert(&object, item));
+    }
+    for (size_t i = 0; i < 4000; i++) {
+        item = 3000 + (i * 7919) % 4000;
+        assert_true(insert(&object, item));
+    }
+    check_tree(&object);
+    assert_int_equal(9999, object.count);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$build(NULL, (void *) 1, 0));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$build((void *) 1, NULL, 0));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_object_unavailable(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, sizeof(size_t),
+                                  coral_compare_size_t));
+    const size_t items[] = {1, 2, 3};
+    assert_true(coral$b_tree$insert(&object, &items[0]));
+    assert_false(coral$b_tree$build(&object, items, 3));
+    assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, sizeof(size_t),
+                                  coral_compare_size_t));
+    const size_t items[] = {1, 3, 2, 4};
+    assert_false(coral$b_tree$build(&object, items, 4));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    check_tree(&object);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const size_t count = 5000;
+    unsigned char *items = calloc(count, SIZE);
+    assert_non_null(items);
+    for (size_t i = 0; i < count; i++) {
+        const size_t item = 2 * i;
+        memcpy(items + i * SIZE, &item, sizeof(item));
+    }
+    /* the order is 6 for wide items: a full lone leaf, one item too many
+     * for it, a full lone inner node, one leaf too many for it, then several
+     * levels */
+    const size_t counts[] = {0, 1, 6, 7, 36, 37, 1000, 5000};
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        struct coral$b_tree object;
+        assert_true(coral$b_tree$init(&object, SIZE, coral_compare_size_t));
+        assert_true(coral$b_tree$build(&object, items, counts[c]));
+        assert_int_equal(counts[c], object.count);
+        check_tree(&object);
+        assert_true(coral$b_tree$invalidate(&object, NULL));
+    }
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, SIZE, coral_compare_size_t));
+    assert_true(coral$b_tree$build(&object, items, count));
+    assert_int_equal(6, object.leaf_order);
+    assert_int_equal(6, object.inner_order);
+    assert_true(object.height > 2);
+    for (size_t i = 0; i < count; i++) {
+        const size_t item = 2 * i;
+        void *out;
+        assert_true(coral$b_tree$search(&object, &item, &out));
+        assert_int_equal(item, item_at(out, 0));
+    }
+    /* the tree takes inserts and deletes as usual afterwards */
+    for (size_t i = 1; i < 2 * count; i += 2) {
+        assert_true(insert(&object, i));
+    }
+    check_tree(&object);
+    for (size_t i = 0; i < 2 * count; i += 3) {
+        assert_true(coral$b_tree$delete(&object, &i));
+    }
+    check_tree(&object);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    free(items);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_delete_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$delete(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_delete_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$delete((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_delete_error_on_object_not_found(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, SIZE,
+                                  coral_compare_size_t));
+    size_t item = 1;
+    assert_false(coral$b_tree$delete(&object, &item));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_true(insert(&object, item));
+    item = 2;
+    assert_false(coral$b_tree$delete(&object, &item));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_delete(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, SIZE,
+                                  coral_compare_size_t));
+    const size_t count = 5000;
+    for (size_t i = 0; i < count; i++) {
+        const size_t item = (i * 7919) % count;
+        assert_true(insert(&object, item));
+    }
+    /* churn through borrowing and merging on every level */
+    for (size_t i = 0; i < 10 * count; i++) {
+        const size_t item = (i * 104729) % (2 * count);
+        void *out;
+        if (coral$b_tree$search(&object, &item, &out)) {
+            assert_true(coral$b_tree$delete(&object, &item));
+        } else {
+            coral_error = CORAL_ERROR_NONE;
+            assert_true(insert(&object, item));
+        }
+        if (!(i % 1000)) {
+            check_tree(&object);
+        }
+    }
+    check_tree(&object);
+    /* from the front, the back and the middle until the tree is gone */
+    while (object.count) {
+        void *out;
+        assert_true(object.count % 3
+                    ? coral$b_tree$get_first(&object, &out)
+                    : coral$b_tree$get_last(&object, &out));
+        size_t item = item_at(out, 0);
+        assert_true(coral$b_tree$delete(&object, &item));
+        if (object.count > 2 && !(object.count % 5)) {
+            struct coral$b_tree$leaf *leaf = object.first;
+            item = item_at(leaf->items, leaf->count / 2);
+            assert_true(coral$b_tree$delete(&object, &item));
+        }
+        if (!(object.count % 100)) {
+            check_tree(&object);
+        }
+    }
+    check_tree(&object);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_first_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_first(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_first_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_first((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_last_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_last(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_last_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_last((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_first_and_last_error_on_object_not_found(void **s) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, SIZE,
+                                  coral_compare_size_t));
+    void *out;
+    assert_false(coral$b_tree$get_first(&object, &out));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_last(&object, &out));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_next_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_next(NULL, (void *) 1, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_next_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_next((void *) 1, NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_next((void *) 1, (void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_prev_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_prev(NULL, (void *) 1, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_prev_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_prev((void *) 1, NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$b_tree$get_prev((void *) 1, (void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_next_and_prev_error_on_object_not_found(void **s) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, SIZE,
+                                  coral_compare_size_t));
+    size_t item = 1;
+    void *out;
+    assert_false(coral$b_tree$get_next(&object, &item, &out));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_true(insert(&object, item));
+    item = 2;
+    assert_false(coral$b_tree$get_prev(&object, &item, &out));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_next_and_prev(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$b_tree object;
+    assert_true(coral$b_tree$init(&object, SIZE,
+                                  coral_compare_size_t));
+    const size_t count = 2000;
+    for (size_t i = 0; i < count; i++) {
+        const size_t item = (i * 7919) % count;
+        assert_true(insert(&object, item));
+    }
+    void *out;
+    assert_true(coral$b_tree$get_first(&object, &out));
+    for (size_t i = 0; i < count - 1; i++) {
+        assert_int_equal(i, item_at(out, 0));
+        assert_true(coral$b_tree$get_next(&object, out, &out));
+    }
+    assert_int_equal(count - 1, item_at(out, 0));
+    assert_false(coral$b_tree$get_next(&object, out, &out));
+    assert_int_equal(CORAL_ERROR_END_OF_SEQUENCE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_true(coral$b_tree$get_last(&object, &out));
+    for (size_t i = count - 1; i > 0; i--) {
+        assert_int_equal(i, item_at(out, 0));
+        assert_true(coral$b_tree$get_prev(&object, out, &out));
+    }
+    assert_int_equal(0, item_at(out, 0));
+    assert_false(coral$b_tree$get_prev(&object, out, &out));
+    assert_int_equal(CORAL_ERROR_END_OF_SEQUENCE, coral_error);
+    assert_true(coral$b_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_init_error_on_null_object_ptr),
+            cmocka_unit_test(check_init_error_on_null_argument_ptr),
+            cmocka_unit_test(check_init_error_on_invalid_value),
+            cmocka_unit_test(check_init_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_init_with_large_item),
+            cmocka_unit_test(check_invalidate_error_on_null_object_ptr),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_get_count_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_count_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_count),
+            cmocka_unit_test(check_search_error_on_null_object_ptr),
+            cmocka_unit_test(check_search_error_on_null_argument_ptr),
+            cmocka_unit_test(check_search_error_on_object_not_found),
+            cmocka_unit_test(check_search),
+            cmocka_unit_test(check_insert_error_on_null_object_ptr),
+            cmocka_unit_test(check_insert_error_on_null_argument_ptr),
+            cmocka_unit_test(check_insert_error_on_object_already_exists),
+            cmocka_unit_test(check_insert),
+            cmocka_unit_test(check_build_error_on_null_object_ptr),
+            cmocka_unit_test(check_build_error_on_null_argument_ptr),
+            cmocka_unit_test(check_build_error_on_object_unavailable),
+            cmocka_unit_test(check_build_error_on_invalid_value),
+            cmocka_unit_test(check_build),
+            cmocka_unit_test(check_delete_error_on_null_object_ptr),
+            cmocka_unit_test(check_delete_error_on_null_argument_ptr),
+            cmocka_unit_test(check_delete_error_on_object_not_found),
+            cmocka_unit_test(check_delete),
+            cmocka_unit_test(check_get_first_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_first_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_last_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_last_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_first_and_last_error_on_object_not_found),
+            cmocka_unit_test(check_get_next_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_next_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_prev_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_prev_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_next_and_prev_error_on_object_not_found),
+            cmocka_unit_test(check_get_next_and_prev),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
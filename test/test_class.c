@@ -2,6 +2,7 @@
 #include <stddef.h>
 #include <setjmp.h>
 #include <cmocka.h>
+#include <stdio.h>
 #include <string.h>
 #include <coral.h>
 
@@ -412,6 +413,243 @@ static void check_object_method_get(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void
+check_object_method_get_selector_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_class_method_get_selector(NULL, (void *) 1,
+                                                 (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void
+check_object_method_get_selector_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_class_method_get_selector((void *) 1, NULL,
+                                                 (void *) 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_class_method_get_selector((void *) 1, (void *) 1,
+                                                 NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void
+check_object_method_get_selector_error_on_method_not_found(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_true(coral_selector_of("barney", &selector));
+    struct coral_class *object;
+    assert_true(coral_class_alloc(&object));
+    assert_true(coral_class_init(object));
+    coral_invokable_t func = NULL;
+    assert_false(coral_class_method_get_selector(object, selector, &func));
+    assert_int_equal(CORAL_ERROR_METHOD_NOT_FOUND, coral_error);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_method_get_selector(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    char names[32][8];
+    struct coral_class *object;
+    assert_true(coral_class_alloc(&object));
+    assert_true(coral_class_init(object));
+    for (size_t i = 0; i < 32; i++) {
+        snprintf(names[i], sizeof(names[i]), "m%zu", i);
+        struct coral_class_method_name name = {
+                .data = names[i],
+                .size = strlen(names[i])
+        };
+        assert_true(coral_class_method_add(object, &name,
+                                           (void *) (1 + i)));
+    }
+    /* removing methods must not lose the ones that collided with them */
+    for (size_t i = 0; i < 32; i += 3) {
+        struct coral_class_method_name name = {
+                .data = names[i],
+                .size = strlen(names[i])
+        };
+        assert_true(coral_class_method_remove(object, &name));
+    }
+    for (size_t i = 0; i < 32; i++) {
+        const struct coral_selector *selector;
+        assert_true(coral_selector_of(names[i], &selector));
+        coral_invokable_t func = NULL;
+        if (i % 3) {
+            assert_true(coral_class_method_get_selector(object, selector,
+                                                        &func));
+            assert_ptr_equal(1 + i, func);
+        } else {
+            assert_false(coral_class_method_get_selector(object, selector,
+                                                         &func));
+            assert_int_equal(CORAL_ERROR_METHOD_NOT_FOUND, coral_error);
+        }
+    }
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_freeze_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_class_freeze(NULL));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_freeze_error_on_object_uninitialized(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *object;
+    assert_true(coral_class_alloc(&object));
+    assert_false(coral_class_freeze(object));
+    assert_int_equal(CORAL_ERROR_OBJECT_IS_UNINITIALIZED, coral_error);
+    assert_true(coral_class_destroy(object));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_freeze(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    char names[24][8];
+    struct coral_class *object;
+    assert_true(coral_class_alloc(&object));
+    assert_true(coral_class_init(object));
+    for (size_t i = 0; i < 24; i++) {
+        snprintf(names[i], sizeof(names[i]), "f%zu", i);
+        struct coral_class_method_name name = {
+                .data = names[i],
+                .size = strlen(names[i])
+        };
+        assert_true(coral_class_method_add(object, &name,
+                                           (void *) (1 + i)));
+    }
+    bool frozen = true;
+    assert_true(coral_class_is_frozen(object, &frozen));
+    assert_false(frozen);
+    assert_true(coral_class_freeze(object));
+    assert_true(coral_class_freeze(object));
+    assert_true(coral_class_is_frozen(object, &frozen));
+    assert_true(frozen);
+    for (size_t i = 0; i < 24; i++) {
+        struct coral_class_method_name name = {
+                .data = names[i],
+                .size = strlen(names[i])
+        };
+        const struct coral_selector *selector;
+        assert_true(coral_selector_of(names[i], &selector));
+        coral_invokable_t func = NULL;
+        assert_true(coral_class_method_get_selector(object, selector, &func));
+        assert_ptr_equal(1 + i, func);
+        func = NULL;
+        assert_true(coral_class_method_get(object, &name, &func));
+        assert_ptr_equal(1 + i, func);
+    }
+    const struct coral_selector *selector;
+    assert_true(coral_selector_of("barney", &selector));
+    coral_invokable_t func = NULL;
+    assert_false(coral_class_method_get_selector(object, selector, &func));
+    assert_int_equal(CORAL_ERROR_METHOD_NOT_FOUND, coral_error);
+    struct coral_class_method_name name = {
+            .data = "wilma",
+            .size = strlen("wilma")
+    };
+    assert_false(coral_class_method_get(object, &name, &func));
+    assert_int_equal(CORAL_ERROR_METHOD_NOT_FOUND, coral_error);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_freeze_with_spread_ids(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class_method_name names[2] = {
+            {.data = "spread_0", .size = strlen("spread_0")}
+    };
+    const struct coral_selector *selectors[2];
+    assert_true(coral_selector_of(names[0].data, &selectors[0]));
+    /* look for an id that shares the low bits of the first one with the
+     * largest mask a perfect table may use for two methods */
+    char buffer[2][16];
+    for (size_t i = 0;; i++) {
+        snprintf(buffer[i % 2], sizeof(buffer[i % 2]), "spread_%zu", 1 + i);
+        assert_true(coral_selector_of(buffer[i % 2], &selectors[1]));
+        if (!((selectors[1]->id - selectors[0]->id) % 8)) {
+            names[1].data = buffer[i % 2];
+            names[1].size = strlen(buffer[i % 2]);
+            break;
+        }
+    }
+    struct coral_class *object;
+    assert_true(coral_class_alloc(&object));
+    assert_true(coral_class_init(object));
+    for (size_t i = 0; i < 2; i++) {
+        assert_true(coral_class_method_add(object, &names[i],
+                                           (void *) (1 + i)));
+    }
+    assert_true(coral_class_freeze(object));
+    bool frozen = false;
+    assert_true(coral_class_is_frozen(object, &frozen));
+    assert_true(frozen);
+    for (size_t i = 0; i < 2; i++) {
+        coral_invokable_t func = NULL;
+        assert_true(coral_class_method_get_selector(object, selectors[i],
+                                                    &func));
+        assert_ptr_equal(1 + i, func);
+        func = NULL;
+        assert_true(coral_class_method_get(object, &names[i], &func));
+        assert_ptr_equal(1 + i, func);
+    }
+    const struct coral_selector *selector;
+    assert_true(coral_selector_of("barney", &selector));
+    coral_invokable_t func = NULL;
+    assert_false(coral_class_method_get_selector(object, selector, &func));
+    assert_int_equal(CORAL_ERROR_METHOD_NOT_FOUND, coral_error);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_freeze_rejects_changes(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class_method_name name = {
+            .data = "fred",
+            .size = strlen("fred")
+    };
+    struct coral_class *object;
+    assert_true(coral_class_alloc(&object));
+    assert_true(coral_class_init(object));
+    assert_true(coral_class_method_add(object, &name, (void *) 10));
+    assert_true(coral_class_freeze(object));
+    assert_false(coral_class_method_add(object, &name, (void *) 11));
+    assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+    name.data = "barney";
+    name.size = strlen("barney");
+    assert_false(coral_class_method_add(object, &name, (void *) 11));
+    assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+    name.data = "fred";
+    name.size = strlen("fred");
+    assert_false(coral_class_method_remove(object, &name));
+    assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+    coral_invokable_t func = NULL;
+    assert_true(coral_class_method_get(object, &name, &func));
+    assert_ptr_equal(10, func);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_builtin_classes_are_frozen(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *classes[3];
+    assert_true(coral_array_class(&classes[0]));
+    assert_true(coral_integer_class(&classes[1]));
+    assert_true(coral_tree_map_class(&classes[2]));
+    for (size_t i = 0; i < 3; i++) {
+        bool frozen = false;
+        assert_true(coral_class_is_frozen(classes[i], &frozen));
+        assert_true(frozen);
+    }
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
 int main(int argc, char *argv[]) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(check_object_destroy_error_on_null_object_ptr),
@@ -449,6 +687,16 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_object_method_get_error_on_object_uninitialized),
             cmocka_unit_test(check_object_method_get_error_on_method_not_found),
             cmocka_unit_test(check_object_method_get),
+            cmocka_unit_test(check_object_method_get_selector_error_on_null_object_ptr),
+            cmocka_unit_test(check_object_method_get_selector_error_on_null_argument_ptr),
+            cmocka_unit_test(check_object_method_get_selector_error_on_method_not_found),
+            cmocka_unit_test(check_object_method_get_selector),
+            cmocka_unit_test(check_object_freeze_error_on_null_object_ptr),
+            cmocka_unit_test(check_object_freeze_error_on_object_uninitialized),
+            cmocka_unit_test(check_object_freeze),
+            cmocka_unit_test(check_object_freeze_with_spread_ids),
+            cmocka_unit_test(check_object_freeze_rejects_changes),
+            cmocka_unit_test(check_object_builtin_classes_are_frozen),
     };
     //cmocka_set_message_output(CM_OUTPUT_XML);
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,733 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <coral.h>
+
+#include "private/compact_red_black_tree.h"
+#include "test/cmocka.h"
+
+#define NIL     CORAL_COMPACT_RED_BLACK_TREE_NIL
+#define RED     ((uint32_t) 1 << 31)
+
+static struct coral$compact_red_black_tree$node *
+node_of(struct coral$compact_red_black_tree *object, const uint32_t i) {
+    return (struct coral$compact_red_black_tree$node *)
+            (object->nodes + (size_t) i * object->stride);
+}
+
+static size_t item_of(struct coral$compact_red_black_tree *object,
+                      const uint32_t i) {
+    size_t item;
+    memcpy(&item, (unsigned char *) node_of(object, i) + object->offset,
+           sizeof(item));
+    return item;
+}
+
+/* returns the black height of the subtree at i */
+static size_t check_subtree(struct coral$compact_red_black_tree *object,
+                            const uint32_t i, const uint32_t parent) {
+    if (NIL == i) {
+        return 1;
+    }
+    struct coral$compact_red_black_tree$node *node = node_of(object, i);
+    assert_int_equal(parent, node->parent & ~RED);
+    const bool is_red = node->parent & RED;
+    if (NIL != node->left) {
+        assert_true(item_of(object, node->left) < item_of(object, i));
+        assert_false(is_red && node_of(object, node->left)->parent & RED);
+    }
+    if (NIL != node->right) {
+        assert_true(item_of(object, node->right) > item_of(object, i));
+        assert_false(is_red && node_of(object, node->right)->parent & RED);
+    }
+    const size_t left = check_subtree(object, node->left, i);
+    const size_t right = check_subtree(object, node->right, i);
+    assert_int_equal(left, right);
+    return left + !is_red;
+}
+
+static void check_tree(struct coral$compact_red_black_tree *object) {
+    if (NIL != object->root) {
+        assert_false(node_of(object, object->root)->parent & RED);
+    }
+    check_subtree(object, object->root, NIL);
+    struct coral$compact_red_black_tree$node *nil = node_of(object, NIL);
+    assert_int_equal(0, nil->parent);
+    assert_int_equal(NIL, nil->left);
+    assert_int_equal(NIL, nil->right);
+}
+
+static void check_init_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$init(
+            NULL, sizeof(size_t), coral_compare_size_t));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$init(
+            (void *) 1, sizeof(size_t), NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$init(
+            (void *) 1, 0, coral_compare_size_t));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    /* links padded up to the alignment of the item, then the item */
+    assert_int_equal(16, object.offset);
+    assert_int_equal(16 + sizeof(size_t), object.stride);
+    assert_int_equal(NIL, object.root);
+    assert_int_equal(1, object.used);
+    assert_int_equal(0, object.count);
+    check_tree(&object);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_aligns_item(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const size_t sizes[][3] = {
+            /* size, offset, stride */
+            {1,  12, 16},
+            {4,  12, 16},
+            {12, 12, 24},
+            {16, 16, 32},
+            {24, 16, 40},
+            {64, 16, 80}
+    };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        struct coral$compact_red_black_tree object;
+        assert_true(coral$compact_red_black_tree$init(
+                &object, sizes[i][0], coral_compare_size_t));
+        assert_int_equal(sizes[i][1], object.offset);
+        assert_int_equal(sizes[i][2], object.stride);
+        assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_invalidate_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$invalidate(NULL, NULL));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static size_t $destroyed;
+
+static void $on_destroy(void *item) {
+    size_t item_;
+    memcpy(&item_, item, sizeof(item_));
+    /* in order */
+    assert_int_equal($destroyed, item_);
+    $destroyed += 1;
+}
+
+static void check_invalidate(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    for (size_t i = 0; i < 100; i++) {
+        const size_t item = 99 - i;
+        assert_true(coral$compact_red_black_tree$insert(&object, &item,
+                                                        NULL));
+    }
+    $destroyed = 0;
+    assert_true(coral$compact_red_black_tree$invalidate(&object, $on_destroy));
+    assert_int_equal(100, $destroyed);
+    assert_null(object.nodes);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_count_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_count(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_count_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_count((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_footprint_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_footprint(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_footprint_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_footprint((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_count_and_footprint(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    size_t count, footprint;
+    assert_true(coral$compact_red_black_tree$get_count(&object, &count));
+    assert_int_equal(0, count);
+    assert_true(coral$compact_red_black_tree$get_footprint(&object,
+                                                           &footprint));
+    assert_int_equal(CORAL_COMPACT_RED_BLACK_TREE_CAPACITY_MINIMUM
+                     * object.stride, footprint);
+    for (size_t i = 0; i < CORAL_COMPACT_RED_BLACK_TREE_CAPACITY_MINIMUM; i++) {
+        assert_true(coral$compact_red_black_tree$insert(&object, &i, NULL));
+    }
+    assert_true(coral$compact_red_black_tree$get_count(&object, &count));
+    assert_int_equal(CORAL_COMPACT_RED_BLACK_TREE_CAPACITY_MINIMUM, count);
+    /* the sentinel took one node so the arena had to grow by half */
+    assert_true(coral$compact_red_black_tree$get_footprint(&object,
+                                                           &footprint));
+    assert_int_equal(3 * CORAL_COMPACT_RED_BLACK_TREE_CAPACITY_MINIMUM / 2
+                     * object.stride, footprint);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_set_capacity_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$set_capacity(NULL, 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_set_capacity_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    for (size_t i = 0; i < 3; i++) {
+        assert_true(coral$compact_red_black_tree$insert(&object, &i, NULL));
+    }
+    const size_t item = 1;
+    assert_true(coral$compact_red_black_tree$delete(&object, &item));
+    /* the deleted node still takes up its place */
+    assert_false(coral$compact_red_black_tree$set_capacity(&object, 2));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$set_capacity(
+            &object, CORAL_COMPACT_RED_BLACK_TREE_CAPACITY_MAXIMUM));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_set_capacity(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    assert_true(coral$compact_red_black_tree$set_capacity(&object, 100));
+    size_t footprint;
+    assert_true(coral$compact_red_black_tree$get_footprint(&object,
+                                                           &footprint));
+    assert_int_equal(101 * object.stride, footprint);
+    for (size_t i = 0; i < 100; i++) {
+        assert_true(coral$compact_red_black_tree$insert(&object, &i, NULL));
+    }
+    assert_int_equal(101, object.capacity);
+    check_tree(&object);
+    assert_true(coral$compact_red_black_tree$set_capacity(&object, 100));
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_item_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_item(NULL, 1, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_item_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_item((void *) 1, 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_item_error_on_index_out_of_bounds(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    void *item;
+    assert_false(coral$compact_red_black_tree$get_item(&object, NIL, &item));
+    assert_int_equal(CORAL_ERROR_INDEX_OUT_OF_BOUNDS, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_item(&object, 1, &item));
+    assert_int_equal(CORAL_ERROR_INDEX_OUT_OF_BOUNDS, coral_error);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_item(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    const size_t item = 42;
+    uint32_t node;
+    assert_true(coral$compact_red_black_tree$insert(&object, &item, &node));
+    void *out;
+    assert_true(coral$compact_red_black_tree$get_item(&object, node, &out));
+    assert_memory_equal(&item, out, sizeof(item));
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_search_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$search(
+            NULL, (void *) 1, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_search_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$search(
+            (void *) 1, NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$search(
+            (void *) 1, (void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_search(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    size_t item = 10;
+    uint32_t out = 1;
+    assert_false(coral$compact_red_black_tree$search(&object, &item, &out));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    assert_int_equal(NIL, out);
+    coral_error = CORAL_ERROR_NONE;
+    uint32_t node;
+    assert_true(coral$compact_red_black_tree$insert(&object, &item, &node));
+    assert_true(coral$compact_red_black_tree$search(&object, &item, &out));
+    assert_int_equal(node, out);
+    item = 11;
+    assert_false(coral$compact_red_black_tree$search(&object, &item, &out));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    /* insertion point */
+    assert_int_equal(node, out);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_insert_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$insert(NULL, (void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_insert_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$insert((void *) 1, NULL, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_insert_error_on_object_already_exists(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    const size_t item = 7;
+    assert_true(coral$compact_red_black_tree$insert(&object, &item, NULL));
+    assert_false(coral$compact_red_black_tree$insert(&object, &item, NULL));
+    assert_int_equal(CORAL_ERROR_OBJECT_ALREADY_EXISTS, coral_error);
+    assert_int_equal(1, object.count);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_insert(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    /* ascending, descending and shuffled */
+    for (size_t i = 0; i < 1000; i++) {
+        assert_true(coral$compact_red_black_tree$insert(&object, &i, NULL));
+        const size_t item = 3000 - i;
+        assert_true(coral$compact_red_black_tree$insert(&object, &item,
+                                                        NULL));
+    }
+    for (size_t i = 0; i < 1000; i++) {
+        const size_t item = 1000 + (i * 7919) % 1000;
+        assert_true(coral$compact_red_black_tree$insert(&object, &item,
+                                                        NULL));
+    }
+    check_tree(&object);
+    assert_int_equal(3000, object.count);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$build(NULL, (void *) 1, 0));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$build((void *) 1, NULL, 0));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_object_unavailable(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    const size_t items[] = {1, 2, 3};
+    assert_true(coral$compact_red_black_tree$insert(&object, &items[0],
+                                                    NULL));
+    assert_false(coral$compact_red_black_tree$build(&object, items, 3));
+    assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    const size_t items[] = {1, 3, 3, 4};
+    assert_false(coral$compact_red_black_tree$build(&object, items, 4));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_int_equal(0, object.count);
+    assert_int_equal(NIL, object.root);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    size_t items[1000];
+    for (size_t i = 0; i < 1000; i++) {
+        items[i] = 2 * i;
+    }
+    /* every shape from the empty tree up to a few complete levels */
+    for (size_t count = 0; count <= 70; count++) {
+        struct coral$compact_red_black_tree object;
+        assert_true(coral$compact_red_black_tree$init(
+                &object, sizeof(size_t), coral_compare_size_t));
+        assert_true(coral$compact_red_black_tree$build(&object, items, count));
+        assert_int_equal(count, object.count);
+        check_tree(&object);
+        assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    }
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    /* deleted nodes are dropped with the rest */
+    for (size_t i = 0; i < 3; i++) {
+        assert_true(coral$compact_red_black_tree$insert(&object, &i, NULL));
+    }
+    for (size_t i = 0; i < 3; i++) {
+        assert_true(coral$compact_red_black_tree$delete(&object, &i));
+    }
+    assert_true(coral$compact_red_black_tree$build(&object, items, 1000));
+    assert_int_equal(1001, object.used);
+    assert_int_equal(NIL, object.available);
+    check_tree(&object);
+    uint32_t node;
+    assert_true(coral$compact_red_black_tree$get_first(&object, &node));
+    for (size_t i = 0; i < 1000; i++) {
+        assert_int_equal(2 * i, item_of(&object, node));
+        if (i < 999) {
+            assert_true(coral$compact_red_black_tree$get_next(&object, node,
+                                                              &node));
+        }
+    }
+    /* the tree takes inserts and deletes as usual afterwards */
+    for (size_t i = 1; i < 2000; i += 2) {
+        assert_true(coral$compact_red_black_tree$insert(&object, &i, NULL));
+    }
+    for (size_t i = 0; i < 2000; i += 4) {
+        assert_true(coral$compact_red_black_tree$delete(&object, &i));
+    }
+    assert_int_equal(1500, object.count);
+    check_tree(&object);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_delete_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$delete(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_delete_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$delete((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_delete_error_on_object_not_found(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    const size_t item = 7;
+    assert_false(coral$compact_red_black_tree$delete(&object, &item));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_delete_reuses_node(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    size_t item = 1;
+    uint32_t a, b;
+    assert_true(coral$compact_red_black_tree$insert(&object, &item, &a));
+    assert_true(coral$compact_red_black_tree$delete(&object, &item));
+    assert_int_equal(0, object.count);
+    assert_int_equal(NIL, object.root);
+    item = 2;
+    assert_true(coral$compact_red_black_tree$insert(&object, &item, &b));
+    assert_int_equal(a, b);
+    assert_int_equal(2, object.used);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_delete(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    const size_t count = 2000;
+    for (size_t i = 0; i < count; i++) {
+        const size_t item = (i * 7919) % count;
+        assert_true(coral$compact_red_black_tree$insert(&object, &item,
+                                                        NULL));
+    }
+    /* churn through every shape the repair can meet */
+    for (size_t i = 0; i < 10 * count; i++) {
+        size_t item = (i * 104729) % (2 * count);
+        uint32_t node;
+        if (coral$compact_red_black_tree$search(&object, &item, &node)) {
+            assert_true(coral$compact_red_black_tree$delete(&object, &item));
+        } else {
+            assert_true(coral$compact_red_black_tree$insert(&object, &item,
+                                                            NULL));
+        }
+        if (!(i % 1000)) {
+            check_tree(&object);
+        }
+    }
+    check_tree(&object);
+    while (object.count) {
+        size_t item = item_of(&object, object.root);
+        assert_true(coral$compact_red_black_tree$delete(&object, &item));
+    }
+    check_tree(&object);
+    assert_int_equal(NIL, object.root);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_first_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_first(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_first_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_first((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_last_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_last(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_last_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_last((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_first_and_last_error_on_object_not_found(void **s) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    uint32_t node;
+    assert_false(coral$compact_red_black_tree$get_first(&object, &node));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_last(&object, &node));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_next_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_next(NULL, 1, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_next_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_next((void *) 1, 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_prev_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_prev(NULL, 1, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_prev_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$compact_red_black_tree$get_prev((void *) 1, 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_next_and_prev(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$compact_red_black_tree object;
+    assert_true(coral$compact_red_black_tree$init(
+            &object, sizeof(size_t), coral_compare_size_t));
+    const size_t count = 500;
+    for (size_t i = 0; i < count; i++) {
+        const size_t item = (i * 7919) % count;
+        assert_true(coral$compact_red_black_tree$insert(&object, &item,
+                                                        NULL));
+    }
+    uint32_t node;
+    assert_false(coral$compact_red_black_tree$get_next(&object, NIL, &node));
+    assert_int_equal(CORAL_ERROR_INDEX_OUT_OF_BOUNDS, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_true(coral$compact_red_black_tree$get_first(&object, &node));
+    for (size_t i = 0; i < count - 1; i++) {
+        assert_int_equal(i, item_of(&object, node));
+        assert_true(coral$compact_red_black_tree$get_next(&object, node,
+                                                          &node));
+    }
+    assert_int_equal(count - 1, item_of(&object, node));
+    assert_false(coral$compact_red_black_tree$get_next(&object, node, &node));
+    assert_int_equal(CORAL_ERROR_END_OF_SEQUENCE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_true(coral$compact_red_black_tree$get_last(&object, &node));
+    for (size_t i = count - 1; i > 0; i--) {
+        assert_int_equal(i, item_of(&object, node));
+        assert_true(coral$compact_red_black_tree$get_prev(&object, node,
+                                                          &node));
+    }
+    assert_int_equal(0, item_of(&object, node));
+    assert_false(coral$compact_red_black_tree$get_prev(&object, node, &node));
+    assert_int_equal(CORAL_ERROR_END_OF_SEQUENCE, coral_error);
+    assert_true(coral$compact_red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_init_error_on_null_object_ptr),
+            cmocka_unit_test(check_init_error_on_null_argument_ptr),
+            cmocka_unit_test(check_init_error_on_invalid_value),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_init_aligns_item),
+            cmocka_unit_test(check_invalidate_error_on_null_object_ptr),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_get_count_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_count_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_footprint_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_footprint_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_count_and_footprint),
+            cmocka_unit_test(check_set_capacity_error_on_null_object_ptr),
+            cmocka_unit_test(check_set_capacity_error_on_invalid_value),
+            cmocka_unit_test(check_set_capacity),
+            cmocka_unit_test(check_get_item_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_item_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_item_error_on_index_out_of_bounds),
+            cmocka_unit_test(check_get_item),
+            cmocka_unit_test(check_search_error_on_null_object_ptr),
+            cmocka_unit_test(check_search_error_on_null_argument_ptr),
+            cmocka_unit_test(check_search),
+            cmocka_unit_test(check_insert_error_on_null_object_ptr),
+            cmocka_unit_test(check_insert_error_on_null_argument_ptr),
+            cmocka_unit_test(check_insert_error_on_object_already_exists),
+            cmocka_unit_test(check_insert),
+            cmocka_unit_test(check_build_error_on_null_object_ptr),
+            cmocka_unit_test(check_build_error_on_null_argument_ptr),
+            cmocka_unit_test(check_build_error_on_object_unavailable),
+            cmocka_unit_test(check_build_error_on_invalid_value),
+            cmocka_unit_test(check_build),
+            cmocka_unit_test(check_delete_error_on_null_object_ptr),
+            cmocka_unit_test(check_delete_error_on_null_argument_ptr),
+            cmocka_unit_test(check_delete_error_on_object_not_found),
+            cmocka_unit_test(check_delete_reuses_node),
+            cmocka_unit_test(check_delete),
+            cmocka_unit_test(check_get_first_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_first_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_last_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_last_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_first_and_last_error_on_object_not_found),
+            cmocka_unit_test(check_get_next_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_next_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_prev_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_prev_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_next_and_prev),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -346,6 +346,15 @@ static void check_retain(void **state) {
     assert_int_equal(2, ref_counter);
 }
 
+static void check_retain_and_release_immortal(void **state) {
+    atomic_size_t ref_counter = CORAL_REF_COUNT_IMMORTAL;
+    coral$retain(&ref_counter);
+    assert_int_equal(CORAL_REF_COUNT_IMMORTAL, ref_counter);
+    coral$release((void *) 1, &ref_counter, NULL);
+    coral$release_many((void *) 1, &ref_counter, 2, NULL);
+    assert_int_equal(CORAL_REF_COUNT_IMMORTAL, ref_counter);
+}
+
 static void object$destroy(void *object) {
     function_called();
     free(object);
@@ -366,6 +375,21 @@ static void check_release(void **state) {
     coral$release(obj, &obj->ref_counter, object$destroy);
 }
 
+static void check_release_many(void **state) {
+    struct object_t {
+        atomic_size_t ref_counter;
+    };
+    struct object_t *obj = calloc(1, sizeof(*obj));
+    assert_true(obj);
+    assert_int_equal(0, atomic_fetch_add(&obj->ref_counter, 5));
+    expect_function_calls(object$destroy, 1);
+    /* should only decrease reference count */
+    coral$release_many(obj, &obj->ref_counter, 3, object$destroy);
+    assert_int_equal(2, coral$atomic_load(&obj->ref_counter));
+    /* will call destroy which will free the object */
+    coral$release_many(obj, &obj->ref_counter, 2, object$destroy);
+}
+
 int main(int argc, char *argv[]) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(check_compare_void_ptr),
@@ -404,6 +428,8 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_atomic_compare_exchange_ptr),
             cmocka_unit_test(check_retain),
             cmocka_unit_test(check_release),
+            cmocka_unit_test(check_release_many),
+            cmocka_unit_test(check_retain_and_release_immortal),
     };
     //cmocka_set_message_output(CM_OUTPUT_XML);
     return cmocka_run_group_tests(tests, NULL, NULL);
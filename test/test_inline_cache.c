@@ -0,0 +1,208 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <coral.h>
+
+#include "private/inline_cache.h"
+
+static bool $read(void *this, void *data, size_t *args) {
+    *args += 1;
+    return true;
+}
+
+static bool $read_twice(void *this, void *data, size_t *args) {
+    *args += 2;
+    return true;
+}
+
+static struct coral_class *$class_new_with(const bool freeze,
+                                           coral_invokable_t invokable) {
+    struct coral_class *class;
+    struct coral_class_method_name name = {
+            .data = "read",
+            .size = strlen("read")
+    };
+    assert_true(coral_class_alloc(&class));
+    assert_true(coral_class_init(class));
+    assert_true(coral_class_method_add(class, &name, invokable));
+    if (freeze) {
+        assert_true(coral_class_freeze(class));
+    }
+    return class;
+}
+
+static struct coral_class *$class_new(const bool freeze) {
+    return $class_new_with(freeze, (coral_invokable_t) $read);
+}
+
+static void *$object_new(struct coral_class *class) {
+    void *object;
+    assert_true(coral_object_alloc(0, &object));
+    assert_true(coral_object_init(object, class));
+    return object;
+}
+
+static void check_init_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_inline_cache_init(NULL, (void *) 1, 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_inline_cache cache;
+    assert_false(coral_inline_cache_init(&cache, NULL, 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_inline_cache cache;
+    assert_false(coral_inline_cache_init(&cache, (void *) 1, 0));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_inline_cache_init(
+            &cache, (void *) 1, 1 + CORAL_INLINE_CACHE_MAXIMUM_ENTRIES));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_dispatch_cached_monomorphic(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_true(coral_selector_of("read", &selector));
+    struct coral_inline_cache cache;
+    assert_true(coral_inline_cache_init(&cache, selector, 1));
+    struct coral_class *a = $class_new(true), *b = $class_new(true);
+    void *objects[] = {$object_new(a), $object_new(b)};
+    size_t count = 0;
+    for (size_t i = 0; i < 10; i++) {
+        assert_true(coral_object_dispatch_cached(objects[0], true, &cache,
+                                                 &count));
+    }
+    assert_int_equal(10, count);
+    assert_int_equal(1, cache.misses);
+    assert_int_equal(9, cache.hits);
+    /* a second receiver class evicts the first one */
+    assert_true(coral_object_dispatch_cached(objects[1], true, &cache,
+                                             &count));
+    assert_true(coral_object_dispatch_cached(objects[0], true, &cache,
+                                             &count));
+    assert_int_equal(12, count);
+    assert_int_equal(3, cache.misses);
+    assert_int_equal(9, cache.hits);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_dispatch_cached_polymorphic(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_true(coral_selector_of("read", &selector));
+    struct coral_inline_cache cache;
+    assert_true(coral_inline_cache_init(&cache, selector, 3));
+    void *objects[] = {
+            $object_new($class_new(true)),
+            $object_new($class_new(true)),
+            $object_new($class_new(true))
+    };
+    size_t count = 0;
+    for (size_t i = 0; i < 30; i++) {
+        assert_true(coral_object_dispatch_cached(objects[i % 3], true, &cache,
+                                                 &count));
+    }
+    assert_int_equal(30, count);
+    assert_int_equal(3, cache.misses);
+    assert_int_equal(27, cache.hits);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_dispatch_cached_only_caches_frozen_classes(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_true(coral_selector_of("read", &selector));
+    struct coral_inline_cache cache;
+    assert_true(coral_inline_cache_init(&cache, selector, 1));
+    void *object = $object_new($class_new(false));
+    size_t count = 0;
+    assert_true(coral_object_dispatch_cached(object, true, &cache, &count));
+    assert_true(coral_object_dispatch_cached(object, true, &cache, &count));
+    assert_int_equal(2, count);
+    assert_int_equal(2, cache.misses);
+    assert_int_equal(0, cache.count);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_dispatch_cached_misses_on_reused_class_address(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_true(coral_selector_of("read", &selector));
+    struct coral_inline_cache cache;
+    assert_true(coral_inline_cache_init(&cache, selector, 1));
+    size_t count = 0;
+    for (size_t i = 0; i < 4; i++) {
+        /* the class is freed here so the next one may well reuse its
+         * address, the cache must not hand out the old method for it */
+        void *object = $object_new($class_new_with(
+                true, (coral_invokable_t) (i % 2 ? $read_twice : $read)));
+        assert_true(coral_object_dispatch_cached(object, true, &cache,
+                                                 &count));
+        assert_true(coral_object_dispatch_cached(object, true, &cache,
+                                                 &count));
+        coral_autorelease_pool_drain();
+    }
+    assert_int_equal(12, count);
+    assert_int_equal(4, cache.misses);
+    assert_int_equal(4, cache.hits);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_dispatch_cached_error_on_method_not_found(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_true(coral_selector_of("write", &selector));
+    struct coral_inline_cache cache;
+    assert_true(coral_inline_cache_init(&cache, selector, 1));
+    void *object = $object_new($class_new(true));
+    assert_false(coral_object_dispatch_cached(object, true, &cache, NULL));
+    assert_int_equal(CORAL_ERROR_METHOD_NOT_FOUND, coral_error);
+    assert_int_equal(0, cache.count);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_dispatch_cached_error_on_object_uninitialized(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_true(coral_selector_of("read", &selector));
+    struct coral_inline_cache cache;
+    assert_true(coral_inline_cache_init(&cache, selector, 1));
+    void *object;
+    assert_true(coral_object_alloc(0, &object));
+    assert_false(coral_object_dispatch_cached(object, true, &cache, NULL));
+    assert_int_equal(CORAL_ERROR_OBJECT_IS_UNINITIALIZED, coral_error);
+    assert_true(coral_object_destroy(object));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_init_error_on_null_object_ptr),
+            cmocka_unit_test(check_init_error_on_null_argument_ptr),
+            cmocka_unit_test(check_init_error_on_invalid_value),
+            cmocka_unit_test(check_dispatch_cached_monomorphic),
+            cmocka_unit_test(check_dispatch_cached_polymorphic),
+            cmocka_unit_test(check_dispatch_cached_only_caches_frozen_classes),
+            cmocka_unit_test(check_dispatch_cached_misses_on_reused_class_address),
+            cmocka_unit_test(check_dispatch_cached_error_on_method_not_found),
+            cmocka_unit_test(check_dispatch_cached_error_on_object_uninitialized),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
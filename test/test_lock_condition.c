@@ -4,6 +4,8 @@
 #include <cmocka.h>
 #include <string.h>
 #include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <coral.h>
 
 #include "private/lock_condition.h"
@@ -540,6 +542,46 @@ static void check_object_signal_all(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+struct $waiter {
+    struct coral_lock *lock;
+    struct coral_lock_condition *condition;
+    atomic_bool is_signalled;
+};
+
+static bool $noop(void *this, void *data, void *args) {
+    return true;
+}
+
+static void *$signal(void *argument) {
+    struct $waiter *waiter = argument;
+    assert_true(coral_lock_lock(waiter->lock));
+    atomic_store(&waiter->is_signalled, true);
+    assert_true(coral_lock_condition_signal(waiter->condition));
+    assert_true(coral_lock_unlock(waiter->lock));
+    return NULL;
+}
+
+static void check_object_await_signalled_from_other_thread(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct $waiter waiter = {};
+    assert_true(coral_lock_alloc(&waiter.lock));
+    assert_true(coral_lock_init(waiter.lock));
+    assert_true(coral_lock_condition_alloc(&waiter.condition));
+    assert_true(coral_lock_condition_init(waiter.condition, waiter.lock));
+    /* written to by this thread, which then owns it */
+    assert_true(coral_object_invoke(waiter.condition, false, $noop, NULL));
+    assert_true(coral_lock_lock(waiter.lock));
+    pthread_t thread;
+    assert_int_equal(0, pthread_create(&thread, NULL, $signal, &waiter));
+    while (!atomic_load(&waiter.is_signalled)) {
+        assert_true(coral_lock_condition_await(waiter.condition));
+    }
+    assert_true(coral_lock_unlock(waiter.lock));
+    assert_int_equal(0, pthread_join(thread, NULL));
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
 int main(int argc, char *argv[]) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(check_invalidate_error_on_null_object_ptr),
@@ -591,6 +633,7 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_object_signal_all_error_on_object_uninitialized),
             cmocka_unit_test(check_object_signal_all_error_on_invalid_value),
             cmocka_unit_test(check_object_signal_all),
+            cmocka_unit_test(check_object_await_signalled_from_other_thread),
     };
     //cmocka_set_message_output(CM_OUTPUT_XML);
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,129 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <coral.h>
+
+#include "private/object.h"
+#include "private/notification_dispatcher.h"
+
+struct $events {
+    atomic_size_t count;
+    atomic_size_t destroyed;
+    pthread_t thread;
+};
+
+static void $on_event(void *observer, void *object, const char *event) {
+    struct $events *events = observer;
+    if (CORAL_NOTIFICATION_OBJECT_DESTROYED == event) {
+        events->destroyed += 1;
+    } else {
+        events->count += 1;
+    }
+    events->thread = pthread_self();
+}
+
+static void *$object_new(struct $events *events) {
+    struct coral_class *class = NULL;
+    void *object;
+    assert_true(coral_object_class(&class));
+    assert_true(coral_object_alloc(0, &object));
+    assert_true(coral_object_init(object, class));
+    assert_true(coral$object_add_observer(object, events, NULL, $on_event));
+    return object;
+}
+
+static void check_start_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_notification_dispatcher_start(0));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_start_error_on_object_already_exists(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_true(coral_notification_dispatcher_start(1));
+    assert_false(coral_notification_dispatcher_start(1));
+    assert_int_equal(CORAL_ERROR_OBJECT_ALREADY_EXISTS, coral_error);
+    assert_true(coral_notification_dispatcher_stop());
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_stop_error_on_object_unavailable(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_notification_dispatcher_stop());
+    assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_statistics_error_on_argument_ptr_is_null(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_notification_dispatcher_get_statistics(NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_post_is_synchronous_when_stopped(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct $events events = {};
+    void *object = $object_new(&events);
+    assert_false(coral$notification_dispatcher$post(object, "changed"));
+    coral$object_post_notification(object, "changed");
+    assert_int_equal(1, events.count);
+    assert_true(pthread_equal(pthread_self(), events.thread));
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_post(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const size_t count = 10000;
+    struct $events first = {}, second = {};
+    void *objects[] = {$object_new(&first), $object_new(&second)};
+    struct coral_notification_dispatcher_statistics before, after;
+    assert_true(coral_notification_dispatcher_get_statistics(&before));
+    assert_true(coral_notification_dispatcher_start(2));
+    for (size_t i = 0; i < count; i++) {
+        coral$object_post_notification(objects[i % 2], "changed");
+    }
+    assert_true(coral_notification_dispatcher_stop());
+    assert_true(coral_notification_dispatcher_get_statistics(&after));
+    assert_int_equal(count, after.posted - before.posted);
+    assert_int_equal(count, (after.delivered - before.delivered)
+                            + (after.coalesced - before.coalesced));
+    assert_int_equal(after.delivered - before.delivered,
+                     first.count + second.count);
+    assert_true(first.count && second.count);
+    assert_true(after.batches > before.batches);
+    assert_false(pthread_equal(pthread_self(), first.thread));
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_post_object_destroyed_is_synchronous(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct $events events = {};
+    void *object = $object_new(&events);
+    assert_true(coral_notification_dispatcher_start(1));
+    coral_autorelease_pool_drain();
+    assert_int_equal(1, events.destroyed);
+    assert_true(pthread_equal(pthread_self(), events.thread));
+    assert_true(coral_notification_dispatcher_stop());
+    coral_error = CORAL_ERROR_NONE;
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_start_error_on_invalid_value),
+            cmocka_unit_test(check_start_error_on_object_already_exists),
+            cmocka_unit_test(check_stop_error_on_object_unavailable),
+            cmocka_unit_test(check_get_statistics_error_on_argument_ptr_is_null),
+            cmocka_unit_test(check_post_is_synchronous_when_stopped),
+            cmocka_unit_test(check_post),
+            cmocka_unit_test(check_post_object_destroyed_is_synchronous),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -3,8 +3,13 @@
 #include <setjmp.h>
 #include <cmocka.h>
 #include <errno.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
 #include <coral.h>
 
+#include "private/autorelease_pool.h"
 #include "private/coral.h"
 #include "private/object.h"
 #include "test/wrap.h"
@@ -164,6 +169,147 @@ static void check_object_retain_and_release(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void check_object_release_many(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    void *object;
+    assert_true(coral_object_alloc(0, &object));
+    assert_false(coral$object$release_many(object, 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_IS_UNINITIALIZED, coral_error);
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    assert_true(coral_object_init(object, class));
+    for (size_t i = 0; i < 3; i++) {
+        assert_true(coral_object_retain(object));
+    }
+    assert_true(coral$object$release_many(object, 2));
+    size_t count;
+    assert_true(coral$object$get_ref_count(coral$object_from(object), &count));
+    assert_int_equal(2, count);
+    assert_true(coral$object$release_many(object, 0));
+    assert_true(coral$object$release_many(object, 1));
+    assert_true(coral$object$get_ref_count(coral$object_from(object), &count));
+    assert_int_equal(1, count);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_retain_many_error_on_argument_ptr_is_null(
+        void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_object_retain_many(NULL, 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    assert_true(coral_object_retain_many(NULL, 0));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_release_many_error_on_argument_ptr_is_null(
+        void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_object_release_many(NULL, 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    assert_true(coral_object_release_many(NULL, 0));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_retain_and_release_many(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *a, *b, *c;
+    assert_true(coral_object_alloc(0, &a));
+    assert_true(coral_object_alloc(0, &b));
+    assert_true(coral_object_alloc(0, &c));
+    assert_true(coral_object_init(a, class));
+    assert_true(coral_object_init(b, class));
+    void *objects[] = {a, a, NULL, b, a, c};
+    /* c is uninitialized so nothing is retained */
+    assert_false(coral_object_retain_many(objects, 6));
+    assert_int_equal(CORAL_ERROR_OBJECT_IS_UNINITIALIZED, coral_error);
+    assert_false(coral_object_release_many(objects, 6));
+    assert_int_equal(CORAL_ERROR_OBJECT_IS_UNINITIALIZED, coral_error);
+    size_t count;
+    assert_true(coral$object$get_ref_count(coral$object_from(a), &count));
+    assert_int_equal(1, count);
+    assert_true(coral_object_retain_many(objects, 5));
+    assert_true(coral$object$get_ref_count(coral$object_from(a), &count));
+    assert_int_equal(4, count);
+    assert_true(coral$object$get_ref_count(coral$object_from(b), &count));
+    assert_int_equal(2, count);
+    assert_true(coral_object_release_many(objects, 5));
+    assert_true(coral$object$get_ref_count(coral$object_from(a), &count));
+    assert_int_equal(1, count);
+    assert_true(coral$object$get_ref_count(coral$object_from(b), &count));
+    assert_int_equal(1, count);
+    assert_true(coral_object_destroy(c));
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_release_many_destroys(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *objects[8];
+    for (size_t i = 0; i < 8; i++) {
+        assert_true(coral_object_alloc(0, &objects[i]));
+        assert_true(coral_object_init(objects[i], class));
+    }
+    assert_true(coral_object_retain_many(objects, 8));
+    coral_autorelease_pool_drain();
+    /* the last reference of every object is released */
+    assert_true(coral_object_release_many(objects, 8));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_set_immortal(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$object$set_immortal(NULL));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    void *object;
+    assert_true(coral_object_alloc(0, &object));
+    assert_false(coral$object$set_immortal(object));
+    assert_int_equal(CORAL_ERROR_OBJECT_IS_UNINITIALIZED, coral_error);
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    assert_true(coral_object_init(object, class));
+    assert_true(coral$object$set_immortal(object));
+    assert_true(coral_object_retain(object));
+    assert_true(coral_object_release(object));
+    assert_true(coral_object_release(object));
+    assert_true(coral$object$release_many(object, 10));
+    coral_autorelease_pool_drain();
+    size_t count;
+    assert_true(coral$object$get_ref_count(coral$object_from(object), &count));
+    assert_int_equal(CORAL_REF_COUNT_IMMORTAL, count);
+    /* built-in classes are immortal */
+    assert_true(coral$object$get_class(coral$object_from(object), &class));
+    assert_true(coral$object$get_ref_count(coral$object_from(class), &count));
+    assert_int_equal(CORAL_REF_COUNT_IMMORTAL, count);
+    assert_true(coral_object_destroy(object));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_retain_and_release_without_autorelease_pool(
+        void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_object *object = NULL;
+    assert_true(coral_object_alloc(0, (void **) &object));
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    assert_true(coral_object_init(object, class));
+    struct coral_autorelease_pool_statistics before, after;
+    assert_true(coral_autorelease_pool_get_statistics(&before));
+    assert_true(coral_object_retain(object));
+    assert_true(coral_object_release(object));
+    assert_true(coral_autorelease_pool_get_statistics(&after));
+    assert_int_equal(before.pending, after.pending);
+    assert_true(coral_object_autorelease(object));
+    assert_true(coral_autorelease_pool_get_statistics(&after));
+    assert_int_equal(1 + before.pending, after.pending);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_object_is_equal_error_on_null_object_ptr(void **state) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral_object_is_equal(NULL, (void *)1, (void *)1));
@@ -332,6 +478,57 @@ static void check_object_dispatch_hash_code(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void
+check_object_dispatch_selector_error_on_object_uninitialized(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_true(coral_selector_of(hash_code, &selector));
+    void *i;
+    assert_true(coral_object_alloc(0, &i));
+    size_t result;
+    struct hash_code_args args = {
+            .out = &result
+    };
+    assert_false(coral_object_dispatch_selector(i, true, selector, &args));
+    assert_int_equal(CORAL_ERROR_OBJECT_IS_UNINITIALIZED, coral_error);
+    assert_true(coral_object_destroy(i));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void
+check_object_dispatch_selector_error_on_method_not_found(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_true(coral_selector_of("fred", &selector));
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *i;
+    assert_true(coral_object_alloc(0, &i));
+    assert_true(coral_object_init(i, class));
+    assert_false(coral_object_dispatch_selector(i, true, selector, NULL));
+    assert_int_equal(CORAL_ERROR_METHOD_NOT_FOUND, coral_error);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_dispatch_selector(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_true(coral_selector_of(hash_code, &selector));
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *i;
+    assert_true(coral_object_alloc(0, &i));
+    assert_true(coral_object_init(i, class));
+    size_t result = 0, expected = 0;
+    assert_true(coral_object_dispatch_selector(
+            i, true, selector, &(struct hash_code_args) {.out = &result}));
+    assert_true(coral_object_hash_code(i, &expected));
+    assert_int_equal(expected, result);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_object_copy_with_null_object_ptr(void **state) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral_object_copy(NULL, (void *)1));
@@ -368,8 +565,376 @@ static void check_object_copy(void **state) {
     coral_error = CORAL_ERROR_NONE;
     struct coral_class *class = NULL;
     assert_true(coral_object_class(&class));
-    // TODO: implement an object copy test
+    void *i, *o = NULL;
+    assert_true(coral_object_alloc(0, &i));
+    assert_true(coral_object_init(i, class));
+    assert_true(coral_object_copy(i, &o));
+    assert_ptr_not_equal(i, o);
+    /* without a copy method the copy is an alias */
+    assert_ptr_equal(i, coral$object$get_data(o));
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+struct $counter {
+    size_t value;
+};
+
+static size_t $counter_copies;
+
+static bool $counter_copy(void *this,
+                          struct $counter *data,
+                          struct copy_args *args) {
+    $counter_copies += 1;
+    data->value = ((struct $counter *) args->src)->value;
+    return true;
+}
+
+static bool $counter_get(void *this, struct $counter *data, size_t *out) {
+    *out = data->value;
+    return true;
+}
+
+static bool $counter_increment(void *this, struct $counter *data,
+                               void *args) {
+    data->value += 1;
+    return true;
+}
+
+static struct coral_class *$counter_class() {
+    struct coral_class *class;
+    assert_true(coral_class_alloc(&class));
+    assert_true(coral_class_init(class));
+    assert_true(coral_class_retain(class));
+    struct coral_class_method_name name = {
+            .data = copy,
+            .size = strlen(copy)
+    };
+    assert_true(coral_class_method_add(class, &name,
+                                       (coral_invokable_t) $counter_copy));
+    return class;
+}
+
+static void *$counter_new(struct coral_class *class, const size_t value) {
+    void *object;
+    assert_true(coral_object_alloc(sizeof(struct $counter), &object));
+    assert_true(coral_object_init(object, class));
+    for (size_t i = 0; i < value; i++) {
+        assert_true(coral_object_invoke(
+                object, false, (coral_invokable_t) $counter_increment, NULL));
+    }
+    return object;
+}
+
+static size_t $counter_value(void *object) {
+    size_t value;
+    assert_true(coral_object_invoke(
+            object, true, (coral_invokable_t) $counter_get, &value));
+    return value;
+}
+
+static void check_object_copy_shares_until_written(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = $counter_class();
+    void *i = $counter_new(class, 5);
+    void *o = NULL;
+    $counter_copies = 0;
+    assert_true(coral_object_copy(i, &o));
+    assert_int_equal(0, $counter_copies);
+    assert_ptr_equal(i, coral$object$get_data(o));
+    assert_int_equal(5, $counter_value(o));
+    assert_int_equal(0, $counter_copies);
+    assert_true(coral_object_invoke(
+            o, false, (coral_invokable_t) $counter_increment, NULL));
+    assert_int_equal(1, $counter_copies);
+    assert_ptr_equal(o, coral$object$get_data(o));
+    assert_int_equal(6, $counter_value(o));
+    assert_int_equal(5, $counter_value(i));
+    coral_autorelease_pool_drain();
+    assert_true(coral_class_release(class));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_copy_materialized_when_source_is_written(
+        void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = $counter_class();
+    void *i = $counter_new(class, 3);
+    void *o = NULL;
+    $counter_copies = 0;
+    assert_true(coral_object_copy(i, &o));
+    assert_true(coral_object_invoke(
+            i, false, (coral_invokable_t) $counter_increment, NULL));
+    assert_int_equal(1, $counter_copies);
+    assert_int_equal(4, $counter_value(i));
+    assert_int_equal(3, $counter_value(o));
+    assert_true(coral_object_invoke(
+            o, false, (coral_invokable_t) $counter_increment, NULL));
+    assert_int_equal(1, $counter_copies);
+    assert_int_equal(4, $counter_value(o));
+    coral_autorelease_pool_drain();
+    assert_true(coral_class_release(class));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_copy_of_copy_shares_source(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = $counter_class();
+    void *i = $counter_new(class, 1);
+    void *o = NULL, *p = NULL;
+    $counter_copies = 0;
+    assert_true(coral_object_copy(i, &o));
+    assert_true(coral_object_copy(o, &p));
+    assert_ptr_equal(i, coral$object$get_data(p));
+    assert_true(coral_object_invoke(
+            i, false, (coral_invokable_t) $counter_increment, NULL));
+    assert_int_equal(2, $counter_copies);
+    assert_ptr_equal(o, coral$object$get_data(o));
+    assert_ptr_equal(p, coral$object$get_data(p));
+    assert_int_equal(1, $counter_value(o));
+    assert_int_equal(1, $counter_value(p));
+    coral_autorelease_pool_drain();
+    assert_true(coral_class_release(class));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_copy_destroyed_while_shared(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = $counter_class();
+    void *i = $counter_new(class, 2);
+    assert_true(coral_object_retain(i));
+    void *o = NULL;
+    $counter_copies = 0;
+    assert_true(coral_object_copy(i, &o));
+    coral_autorelease_pool_drain();
+    /* the copy is gone and must no longer be materialized */
+    assert_true(coral_object_invoke(
+            i, false, (coral_invokable_t) $counter_increment, NULL));
+    assert_int_equal(0, $counter_copies);
+    assert_int_equal(3, $counter_value(i));
+    assert_true(coral_object_release(i));
+    assert_true(coral_class_release(class));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void *$counter_increment_many(void *object) {
+    for (size_t i = 0; i < 1000; i++) {
+        assert_true(coral_object_invoke(
+                object, false, (coral_invokable_t) $counter_increment, NULL));
+    }
+    return NULL;
+}
+
+static atomic_bool $is_reading;
+static atomic_bool $is_read;
+static atomic_bool $is_written;
+
+static bool $counter_get_slowly(void *this, struct $counter *data,
+                                size_t *out) {
+    atomic_store(&$is_reading, true);
+    while (!atomic_load(&$is_read));
+    *out = data->value;
+    return true;
+}
+
+static void *$counter_read_slowly(void *object) {
+    size_t value;
+    assert_true(coral_object_invoke(
+            object, true, (coral_invokable_t) $counter_get_slowly, &value));
+    return NULL;
+}
+
+static void *$counter_write(void *object) {
+    assert_true(coral_object_invoke(
+            object, false, (coral_invokable_t) $counter_increment, NULL));
+    atomic_store(&$is_written, true);
+    return NULL;
+}
+
+static void check_object_write_waits_for_readers(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = $counter_class();
+    /* never written to, so it is read without an extension */
+    void *i = $counter_new(class, 0);
+    atomic_store(&$is_reading, false);
+    atomic_store(&$is_read, false);
+    atomic_store(&$is_written, false);
+    pthread_t reader, writer;
+    assert_int_equal(0, pthread_create(&reader, NULL,
+                                       $counter_read_slowly, i));
+    while (!atomic_load(&$is_reading));
+    assert_int_equal(0, pthread_create(&writer, NULL, $counter_write, i));
+    const struct timespec delay = {.tv_nsec = 10000000};
+    assert_int_equal(0, nanosleep(&delay, NULL));
+    assert_false(atomic_load(&$is_written));
+    atomic_store(&$is_read, true);
+    assert_int_equal(0, pthread_join(reader, NULL));
+    assert_int_equal(0, pthread_join(writer, NULL));
+    assert_true(atomic_load(&$is_written));
+    assert_int_equal(1, $counter_value(i));
+    coral_autorelease_pool_drain();
+    assert_true(coral_class_release(class));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static bool $counter_await(void *this, struct $counter *data, void *args) {
+    while (!atomic_load(&$is_read));
+    return true;
+}
+
+static bool $counter_signal(void *this, struct $counter *data, void *args) {
+    atomic_store(&$is_read, true);
+    return true;
+}
+
+static void *$counter_read_and_signal(void *object) {
+    assert_true(coral_object_invoke(
+            object, true, (coral_invokable_t) $counter_signal, NULL));
+    return NULL;
+}
+
+static void check_object_owner_read_does_not_block_other_readers(
+        void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = $counter_class();
+    /* written to, so it is owned by this thread */
+    void *i = $counter_new(class, 1);
+    atomic_store(&$is_read, false);
+    pthread_t thread;
+    assert_int_equal(0, pthread_create(&thread, NULL,
+                                       $counter_read_and_signal, i));
+    /* we are woken up by a read that starts while we are still reading */
+    assert_true(coral_object_invoke(
+            i, true, (coral_invokable_t) $counter_await, NULL));
+    assert_int_equal(0, pthread_join(thread, NULL));
+    assert_int_equal(1, $counter_value(i));
+    coral_autorelease_pool_drain();
+    assert_true(coral_class_release(class));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_invoke_from_other_threads(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = $counter_class();
+    /* owned by this thread until the others touch it */
+    void *i = $counter_new(class, 1000);
+    pthread_t threads[4];
+    for (size_t t = 0; t < 4; t++) {
+        assert_int_equal(0, pthread_create(&threads[t], NULL,
+                                           $counter_increment_many, i));
+    }
+    $counter_increment_many(i);
+    for (size_t t = 0; t < 4; t++) {
+        assert_int_equal(0, pthread_join(threads[t], NULL));
+    }
+    assert_int_equal(6000, $counter_value(i));
+    coral_autorelease_pool_drain();
+    assert_true(coral_class_release(class));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+struct $events {
+    size_t count;
+    void *object;
+    const char *event;
+};
+
+static void $on_event(void *observer, void *object, const char *event) {
+    struct $events *events = observer;
+    events->count += 1;
+    events->object = object;
+    events->event = event;
+}
+
+static void check_object_add_observer_error_on_object_uninitialized(
+        void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    void *i;
+    struct $events events = {};
+    assert_true(coral_object_alloc(0, &i));
+    assert_false(coral$object_add_observer(i, &events, NULL, $on_event));
+    assert_int_equal(CORAL_ERROR_OBJECT_IS_UNINITIALIZED, coral_error);
+    assert_true(coral_object_destroy(i));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_add_observer_error_on_object_already_exists(
+        void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *i;
+    struct $events events = {};
+    assert_true(coral_object_alloc(0, &i));
+    assert_true(coral_object_init(i, class));
+    assert_true(coral$object_add_observer(i, &events, "event", $on_event));
+    assert_false(coral$object_add_observer(i, &events, "event", $on_event));
+    assert_int_equal(CORAL_ERROR_OBJECT_ALREADY_EXISTS, coral_error);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_remove_observer_error_on_object_not_found(
+        void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *i;
+    struct $events events = {};
+    assert_true(coral_object_alloc(0, &i));
+    assert_true(coral_object_init(i, class));
+    assert_false(coral$object_remove_observer(i, &events, NULL));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    assert_true(coral$object_add_observer(i, &events, "event", $on_event));
+    assert_false(coral$object_remove_observer(i, &events, "other"));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_post_notification(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *i;
+    struct $events one = {}, all = {};
+    assert_true(coral_object_alloc(0, &i));
+    assert_true(coral_object_init(i, class));
+    coral$object_post_notification(i, "one");
+    assert_true(coral$object_add_observer(i, &one, "one", $on_event));
+    assert_true(coral$object_add_observer(i, &all, NULL, $on_event));
+    coral$object_post_notification(i, "one");
+    coral$object_post_notification(i, "two");
+    assert_int_equal(1, one.count);
+    assert_ptr_equal(i, one.object);
+    assert_string_equal("one", one.event);
+    assert_int_equal(2, all.count);
+    assert_string_equal("two", all.event);
+    assert_true(coral$object_remove_observer(i, &one, "one"));
+    coral$object_post_notification(i, "one");
+    assert_int_equal(1, one.count);
+    assert_int_equal(3, all.count);
+    assert_true(coral$object_remove_observer(i, &all, NULL));
+    coral$object_post_notification(i, "one");
+    assert_int_equal(3, all.count);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_post_notification_on_destroy(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *i;
+    struct $events events = {};
+    assert_true(coral_object_alloc(0, &i));
+    assert_true(coral_object_init(i, class));
+    assert_true(coral$object_add_observer(
+            i, &events, CORAL_NOTIFICATION_OBJECT_DESTROYED, $on_event));
     coral_autorelease_pool_drain();
+    assert_int_equal(1, events.count);
+    assert_ptr_equal(i, events.object);
+    assert_ptr_equal(CORAL_NOTIFICATION_OBJECT_DESTROYED, events.event);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -391,6 +956,15 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_object_retain_error_on_null_object_ptr),
             cmocka_unit_test(check_object_release_error_on_null_object_ptr),
             cmocka_unit_test(check_object_retain_and_release),
+            cmocka_unit_test(check_object_release_many),
+            cmocka_unit_test(check_object_set_immortal),
+            cmocka_unit_test(
+                    check_object_retain_many_error_on_argument_ptr_is_null),
+            cmocka_unit_test(
+                    check_object_release_many_error_on_argument_ptr_is_null),
+            cmocka_unit_test(check_object_retain_and_release_many),
+            cmocka_unit_test(check_object_release_many_destroys),
+            cmocka_unit_test(check_object_retain_and_release_without_autorelease_pool),
             cmocka_unit_test(check_object_is_equal_error_on_null_object_ptr),
             cmocka_unit_test(check_object_is_equal_error_on_null_argument_ptr),
             cmocka_unit_test(check_object_is_equal_error_on_object_uninitialized),
@@ -403,11 +977,26 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_object_hash_code),
             cmocka_unit_test(check_object_dispatch_hash_code_error_on_object_uninitialized),
             cmocka_unit_test(check_object_dispatch_hash_code),
+            cmocka_unit_test(check_object_dispatch_selector_error_on_object_uninitialized),
+            cmocka_unit_test(check_object_dispatch_selector_error_on_method_not_found),
+            cmocka_unit_test(check_object_dispatch_selector),
             cmocka_unit_test(check_object_copy_with_null_object_ptr),
             cmocka_unit_test(check_object_copy_with_null_argument_ptr),
             cmocka_unit_test(check_object_copy_error_on_invalid_value),
             cmocka_unit_test(check_object_copy_error_on_object_uninitialized),
-            cmocka_unit_test(check_object_copy)
+            cmocka_unit_test(check_object_copy),
+            cmocka_unit_test(check_object_copy_shares_until_written),
+            cmocka_unit_test(check_object_copy_materialized_when_source_is_written),
+            cmocka_unit_test(check_object_copy_of_copy_shares_source),
+            cmocka_unit_test(check_object_copy_destroyed_while_shared),
+            cmocka_unit_test(check_object_invoke_from_other_threads),
+            cmocka_unit_test(check_object_write_waits_for_readers),
+            cmocka_unit_test(check_object_owner_read_does_not_block_other_readers),
+            cmocka_unit_test(check_object_add_observer_error_on_object_uninitialized),
+            cmocka_unit_test(check_object_add_observer_error_on_object_already_exists),
+            cmocka_unit_test(check_object_remove_observer_error_on_object_not_found),
+            cmocka_unit_test(check_object_post_notification),
+            cmocka_unit_test(check_object_post_notification_on_destroy)
     };
     //cmocka_set_message_output(CM_OUTPUT_XML);
     return cmocka_run_group_tests(tests, NULL, NULL);
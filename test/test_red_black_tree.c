@@ -4,6 +4,7 @@
 #include <cmocka.h>
 #include <coral.h>
 
+#include "private/allocator.h"
 #include "private/red_black_tree.h"
 #include "test/cmocka.h"
 
@@ -1312,7 +1313,7 @@ static void check_alloc(void **state) {
     assert_true(coral$red_black_tree$alloc(&object));
     assert_null(object->root);
     assert_null(object->compare);
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -1541,7 +1542,7 @@ static void check_insert_error_on_object_already_exists(void **state) {
     assert_int_equal(CORAL_ERROR_OBJECT_ALREADY_EXISTS, coral_error);
     assert_true(coral$red_black_tree$node_destroy(node));
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -1566,7 +1567,7 @@ static void check_insert_case_0(void **state) {
     assert_int_equal(CORAL_RED_BLACK_TREE_COLOR_BLACK, color);
     assert_ptr_equal(a, object->root);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -1613,7 +1614,7 @@ static void check_insert_case_1(void **state) {
                 && coral$red_black_tree$node_get_color(b, &color)
                 && CORAL_RED_BLACK_TREE_COLOR_RED == color);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -1657,7 +1658,7 @@ static void check_insert_case_2b_configuration_3(void **state) {
                 && coral$red_black_tree$node_get_parent(a, &b_)
                 && b == b_);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -1701,7 +1702,7 @@ static void check_insert_case_2b_configuration_2(void **state) {
                 && coral$red_black_tree$node_get_parent(a, &b_)
                 && b == b_);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -1745,7 +1746,7 @@ static void check_insert_case_2b_configuration_1(void **state) {
                 && coral$red_black_tree$node_get_parent(a, &b_)
                 && b == b_);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -1789,7 +1790,7 @@ static void check_insert_case_2b_configuration_0(void **state) {
                 && coral$red_black_tree$node_get_parent(a, &b_)
                 && b == b_);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -1840,7 +1841,7 @@ static void check_insert_case_2a(void **state) {
                 && coral$red_black_tree$node_get_color(d, &color)
                 && CORAL_RED_BLACK_TREE_COLOR_RED == color);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -1931,7 +1932,7 @@ static void check_insert(void **state) {
                 && coral$red_black_tree$node_get_parent(e, &c_)
                 && c == c_);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -1997,7 +1998,7 @@ static void check_get_first(void **state) {
     assert_ptr_equal(e, first);
     assert_int_equal(*e, *(size_t *) first);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -2065,7 +2066,7 @@ static void check_get_last(void **state) {
     assert_ptr_equal(e, last);
     assert_int_equal(*e, *(size_t *) last);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -2124,7 +2125,7 @@ static void check_get_next(void **state) {
     assert_false(coral$red_black_tree$get_next(node, &node));
     assert_int_equal(CORAL_ERROR_END_OF_SEQUENCE, coral_error);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -2183,7 +2184,7 @@ static void check_get_prev(void **state) {
     assert_false(coral$red_black_tree$get_prev(node, &node));
     assert_int_equal(CORAL_ERROR_END_OF_SEQUENCE, coral_error);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -2239,7 +2240,7 @@ static void check_delete_leaf_nodes(void **state) {
     assert_true(coral$red_black_tree$delete(object, a));
     assert_null(object->root);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -2379,7 +2380,7 @@ static void check_delete_node_with_single_child(void **state) {
                 && coral$red_black_tree$node_get_parent(e, &c_)
                 && c == c_);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -2493,7 +2494,35 @@ static void check_delete_node_with_two_children(void **state) {
                 && coral$red_black_tree$node_get_parent(e, &b_)
                 && b == b_);
     assert_true(coral$red_black_tree$invalidate(object, NULL));
-    free(object);
+    coral$allocator$free(object);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_delete_closest_red_child_of_sibling_under_red_parent(
+        void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init(&object, coral_compare_size_t));
+    /* keys in a pseudo random order eventually need a repair in which the
+     * parent is RED and the closest child of the sibling is RED */
+    const size_t count = 10;
+    for (size_t i = 0; i < 10 * count; i++) {
+        size_t key = i * 0x9e3779b97f4a7c15ULL;
+        void *node;
+        assert_false(coral$red_black_tree$search(&object, NULL, &key, &node));
+        size_t *n;
+        assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(*n),
+                                                    (void **) &n));
+        *n = key;
+        assert_true(coral$red_black_tree$insert(&object, node, n));
+        if (i < count) {
+            continue;
+        }
+        key = (i - count) * 0x9e3779b97f4a7c15ULL;
+        assert_true(coral$red_black_tree$search(&object, NULL, &key, &node));
+        assert_true(coral$red_black_tree$delete(&object, node));
+    }
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -2514,7 +2543,529 @@ static void check_tree(void **state) {
         assert_true(coral$red_black_tree$delete(object, object->root));
     }
     assert_null(object->root);
-    free(object);
+    coral$allocator$free(object);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_pool_alloc_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$red_black_tree$pool_alloc(NULL, 0, (void **) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_pool_alloc_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$red_black_tree$pool_alloc((void *) 1, 0, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_pool_alloc_error_on_memory_allocation_failed(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    void *node;
+    assert_false(coral$red_black_tree$pool_alloc(&object, SIZE_MAX, &node));
+    assert_int_equal(CORAL_ERROR_MEMORY_ALLOCATION_FAILED, coral_error);
+    assert_null(object.pool);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_pool_alloc_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init(&object, coral_compare_size_t));
+    size_t *a;
+    assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(*a),
+                                                (void **) &a));
+    void *b;
+    assert_false(coral$red_black_tree$pool_alloc(&object, 1 + sizeof(*a),
+                                                 &b));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_true(coral$red_black_tree$pool_free(&object, a));
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_pool_alloc(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init(&object, coral_compare_size_t));
+    assert_null(object.pool);
+    size_t *a;
+    assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(*a),
+                                                (void **) &a));
+    assert_non_null(object.pool);
+    void *_;
+    assert_true(coral$red_black_tree$node_get_parent(a, &_));
+    assert_null(_);
+    assert_true(coral$red_black_tree$node_get_left(a, &_));
+    assert_null(_);
+    assert_true(coral$red_black_tree$node_get_right(a, &_));
+    assert_null(_);
+    bool color;
+    assert_true(coral$red_black_tree$node_get_color(a, &color));
+    assert_int_equal(CORAL_RED_BLACK_TREE_COLOR_RED, color);
+    assert_true(coral$red_black_tree$pool_free(&object, a));
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
+    assert_null(object.pool);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_pool_free_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$red_black_tree$pool_free(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_pool_free_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$red_black_tree$pool_free((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_pool_free_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_false(coral$red_black_tree$pool_free(&object, (void *) 1));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_pool_free_reuses_node(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init(&object, coral_compare_size_t));
+    size_t *a, *b, *c;
+    assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(*a),
+                                                (void **) &a));
+    assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(*b),
+                                                (void **) &b));
+    assert_ptr_not_equal(a, b);
+    /* nobody reads the tree without a lock, so the node is reused at once */
+    assert_true(coral$red_black_tree$pool_free(&object, a));
+    assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(*c),
+                                                (void **) &c));
+    assert_ptr_equal(a, c);
+    assert_true(coral$red_black_tree$pool_free(&object, b));
+    assert_true(coral$red_black_tree$pool_free(&object, c));
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static size_t $destroyed;
+
+static void $on_node_destroy(void *node) {
+    $destroyed += 1;
+}
+
+static void check_pool_tree(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init(&object, coral_compare_size_t));
+    size_t *p = NULL;
+    /* spans more than one slab */
+    const size_t count = 10000;
+    for (size_t i = 0; i < count; i++) {
+        size_t *n;
+        assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(*n),
+                                                    (void **) &n));
+        *n = i;
+        assert_true(coral$red_black_tree$insert(&object, p, n));
+        p = n;
+    }
+    /* deleted nodes go back to the pool */
+    for (size_t i = 0; i < count / 2; i++) {
+        assert_true(coral$red_black_tree$delete(&object, object.root));
+    }
+    $destroyed = 0;
+    assert_true(coral$red_black_tree$invalidate(&object, $on_node_destroy));
+    assert_int_equal(count - count / 2, $destroyed);
+    assert_null(object.root);
+    assert_null(object.pool);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+/* Check the red black properties of the subtree under node, whose items
+ * must lie in between first and last, and return its black height. */
+static size_t check_subtree(void *node, void *parent, const size_t first,
+                            const size_t last) {
+    if (!node) {
+        return 1;
+    }
+    void *_;
+    assert_true(coral$red_black_tree$node_get_parent(node, &_));
+    assert_ptr_equal(parent, _);
+    const size_t value = *(size_t *) node;
+    assert_true(first <= value && value <= last);
+    bool color;
+    assert_true(coral$red_black_tree$node_get_color(node, &color));
+    void *left, *right;
+    assert_true(coral$red_black_tree$node_get_left(node, &left));
+    assert_true(coral$red_black_tree$node_get_right(node, &right));
+    if (CORAL_RED_BLACK_TREE_COLOR_RED == color) {
+        bool child;
+        assert_true(coral$red_black_tree$node_get_color(left, &child));
+        assert_int_equal(CORAL_RED_BLACK_TREE_COLOR_BLACK, child);
+        assert_true(coral$red_black_tree$node_get_color(right, &child));
+        assert_int_equal(CORAL_RED_BLACK_TREE_COLOR_BLACK, child);
+    }
+    const size_t height = check_subtree(left, node, first, value - 1);
+    assert_int_equal(height, check_subtree(right, node, value + 1, last));
+    return height + (CORAL_RED_BLACK_TREE_COLOR_BLACK == color);
+}
+
+static void check_build_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$red_black_tree$build(NULL, (void **) 1, 0));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$red_black_tree$build((void *) 1, NULL, 0));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_object_unavailable(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init(&object, coral_compare_size_t));
+    size_t *a, *b;
+    assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(*a),
+                                                (void **) &a));
+    assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(*b),
+                                                (void **) &b));
+    *a = 1;
+    *b = 2;
+    assert_true(coral$red_black_tree$insert(&object, NULL, a));
+    assert_false(coral$red_black_tree$build(&object, (void **) &b, 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+    assert_ptr_equal(a, object.root);
+    assert_true(coral$red_black_tree$pool_free(&object, b));
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init(&object, coral_compare_size_t));
+    size_t *nodes[3];
+    for (size_t i = 0; i < 3; i++) {
+        assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(size_t),
+                                                    (void **) &nodes[i]));
+    }
+    *nodes[0] = 1;
+    *nodes[1] = 3;
+    *nodes[2] = 2;
+    assert_false(coral$red_black_tree$build(&object, (void **) nodes, 3));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_null(object.root);
+    /* duplicates are not ascending either */
+    *nodes[2] = 3;
+    assert_false(coral$red_black_tree$build(&object, (void **) nodes, 3));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_null(object.root);
+    for (size_t i = 0; i < 3; i++) {
+        assert_true(coral$red_black_tree$pool_free(&object, nodes[i]));
+    }
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    size_t *nodes[300];
+    /* every count up to a few complete levels and a little beyond */
+    for (size_t count = 0; count <= 300; count++) {
+        struct coral$red_black_tree object = {};
+        assert_true(coral$red_black_tree$init(&object, coral_compare_size_t));
+        for (size_t i = 0; i < count; i++) {
+            assert_true(coral$red_black_tree$pool_alloc(
+                    &object, sizeof(size_t), (void **) &nodes[i]));
+            *nodes[i] = 2 * (1 + i);
+        }
+        assert_true(coral$red_black_tree$build(&object, (void **) nodes,
+                                               count));
+        check_subtree(object.root, NULL, 0, SIZE_MAX);
+        bool color;
+        assert_true(coral$red_black_tree$node_get_color(object.root, &color));
+        assert_int_equal(CORAL_RED_BLACK_TREE_COLOR_BLACK, color);
+        size_t *node = NULL;
+        for (size_t i = 0; i < count; i++) {
+            if (!i) {
+                assert_true(coral$red_black_tree$get_first(
+                        &object, (void **) &node));
+            } else {
+                assert_true(coral$red_black_tree$get_next(
+                        node, (void **) &node));
+            }
+            assert_ptr_equal(nodes[i], node);
+        }
+        /* the tree carries on as if it had been built by inserting */
+        for (size_t i = 0; i <= count; i++) {
+            size_t *n;
+            assert_true(coral$red_black_tree$pool_alloc(
+                    &object, sizeof(*n), (void **) &n));
+            *n = 1 + 2 * i;
+            void *insertion_point;
+            assert_false(coral$red_black_tree$search(&object, NULL, n,
+                                                     &insertion_point));
+            assert_true(coral$red_black_tree$insert(&object,
+                                                    insertion_point, n));
+        }
+        check_subtree(object.root, NULL, 0, SIZE_MAX);
+        for (size_t i = 0; i < count; i++) {
+            assert_true(coral$red_black_tree$delete(&object, nodes[i]));
+        }
+        check_subtree(object.root, NULL, 0, SIZE_MAX);
+        assert_true(coral$red_black_tree$invalidate(&object, NULL));
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
+/* Check that every node of the counted subtree under node holds the count of
+ * its subtree, and return that count. */
+static size_t check_counts(void *node) {
+    if (!node) {
+        return 0;
+    }
+    void *left, *right;
+    assert_true(coral$red_black_tree$node_get_left(node, &left));
+    assert_true(coral$red_black_tree$node_get_right(node, &right));
+    const size_t count = 1 + check_counts(left) + check_counts(right);
+    assert_int_equal(count,
+                     *((size_t *) coral$red_black_tree$node_from(node) - 1));
+    return count;
+}
+
+static void check_init_counted_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$red_black_tree$init_counted(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_counted_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$red_black_tree$init_counted((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_counted(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init_counted(&object,
+                                                  coral_compare_size_t));
+    assert_true(object.is_counted);
+    size_t *a;
+    assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(*a),
+                                                (void **) &a));
+    void *_;
+    assert_true(coral$red_black_tree$node_get_parent(a, &_));
+    assert_null(_);
+    bool color;
+    assert_true(coral$red_black_tree$node_get_color(a, &color));
+    assert_int_equal(CORAL_RED_BLACK_TREE_COLOR_RED, color);
+    assert_int_equal(1, *((size_t *) coral$red_black_tree$node_from(a) - 1));
+    assert_true(coral$red_black_tree$pool_free(&object, a));
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
+    assert_false(object.is_counted);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_insert_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init_counted(&object,
+                                                  coral_compare_size_t));
+    size_t *a;
+    assert_true(coral$red_black_tree$node_of(sizeof(*a), (void **) &a));
+    *a = 1;
+    /* node has no room for its count */
+    assert_false(coral$red_black_tree$insert(&object, NULL, a));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_false(coral$red_black_tree$build(&object, (void **) &a, 1));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_null(object.root);
+    assert_true(coral$red_black_tree$node_destroy(a));
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_at_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$red_black_tree$get_at(NULL, 0, (void **) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_at_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$red_black_tree$get_at((void *) 1, 0, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_at_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init(&object, coral_compare_size_t));
+    void *out;
+    assert_false(coral$red_black_tree$get_at(&object, 0, &out));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_at_error_on_index_out_of_bounds(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init_counted(&object,
+                                                  coral_compare_size_t));
+    void *out;
+    assert_false(coral$red_black_tree$get_at(&object, 0, &out));
+    assert_int_equal(CORAL_ERROR_INDEX_OUT_OF_BOUNDS, coral_error);
+    size_t *a;
+    assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(*a),
+                                                (void **) &a));
+    *a = 1;
+    assert_true(coral$red_black_tree$insert(&object, NULL, a));
+    assert_true(coral$red_black_tree$get_at(&object, 0, &out));
+    assert_ptr_equal(a, out);
+    assert_false(coral$red_black_tree$get_at(&object, 1, &out));
+    assert_int_equal(CORAL_ERROR_INDEX_OUT_OF_BOUNDS, coral_error);
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_rank_of_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$red_black_tree$rank_of(NULL, (void *) 1,
+                                              (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_rank_of_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$red_black_tree$rank_of((void *) 1, NULL,
+                                              (void *) 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    assert_false(coral$red_black_tree$rank_of((void *) 1, (void *) 1,
+                                              NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_rank_of_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init(&object, coral_compare_size_t));
+    const size_t value = 1;
+    size_t out;
+    assert_false(coral$red_black_tree$rank_of(&object, &value, &out));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_counted_rotations(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init_counted(&object,
+                                                  coral_compare_size_t));
+    size_t *nodes[7];
+    for (size_t i = 0; i < 7; i++) {
+        assert_true(coral$red_black_tree$pool_alloc(
+                &object, sizeof(size_t), (void **) &nodes[i]));
+        *nodes[i] = i;
+    }
+    assert_true(coral$red_black_tree$build(&object, (void **) nodes, 7));
+    assert_int_equal(7, check_counts(object.root));
+    /*        3                 5
+     *      /   \             /   \
+     *     1     5     =>    3     6
+     *    / \   / \         / \
+     *   0   2 4   6       1   4
+     *                    / \
+     *                   0   2
+     */
+    assert_true(coral$red_black_tree$rotate_left(nodes[5]));
+    object.root = nodes[5];
+    assert_int_equal(7, check_counts(object.root));
+    assert_int_equal(5, *((size_t *) coral$red_black_tree$node_from(
+            nodes[3]) - 1));
+    assert_true(coral$red_black_tree$rotate_right(nodes[3]));
+    object.root = nodes[3];
+    assert_int_equal(7, check_counts(object.root));
+    assert_true(coral$red_black_tree$rotate_right_left(nodes[4]));
+    object.root = nodes[4];
+    assert_int_equal(7, check_counts(object.root));
+    assert_int_equal(4, *((size_t *) coral$red_black_tree$node_from(
+            nodes[3]) - 1));
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_counted_tree(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$red_black_tree object = {};
+    assert_true(coral$red_black_tree$init_counted(&object,
+                                                  coral_compare_size_t));
+    const size_t count = 1000;
+    for (size_t i = 0; i < count; i++) {
+        size_t *n;
+        assert_true(coral$red_black_tree$pool_alloc(&object, sizeof(*n),
+                                                    (void **) &n));
+        /* even values in a scattered order */
+        *n = 2 * ((i * 7919) % count);
+        void *insertion_point;
+        assert_false(coral$red_black_tree$search(&object, NULL, n,
+                                                 &insertion_point));
+        assert_true(coral$red_black_tree$insert(&object, insertion_point,
+                                                n));
+    }
+    assert_int_equal(count, check_counts(object.root));
+    for (size_t i = 0; i < count; i++) {
+        size_t *n;
+        assert_true(coral$red_black_tree$get_at(&object, i, (void **) &n));
+        assert_int_equal(2 * i, *n);
+        size_t rank;
+        assert_true(coral$red_black_tree$rank_of(&object, n, &rank));
+        assert_int_equal(i, rank);
+        /* odd values are not in the tree */
+        const size_t value = 1 + 2 * i;
+        assert_true(coral$red_black_tree$rank_of(&object, &value, &rank));
+        assert_int_equal(1 + i, rank);
+    }
+    /* delete every third node, those with two children included */
+    for (size_t i = 0; i < count; i += 3) {
+        const size_t value = 2 * i;
+        void *node;
+        assert_true(coral$red_black_tree$search(&object, NULL, &value,
+                                                &node));
+        assert_true(coral$red_black_tree$delete(&object, node));
+        assert_int_equal(count - 1 - i / 3, check_counts(object.root));
+    }
+    size_t *n;
+    assert_true(coral$red_black_tree$get_at(&object, 0, (void **) &n));
+    assert_int_equal(2, *n);
+    assert_true(coral$red_black_tree$get_at(&object, 1, (void **) &n));
+    assert_int_equal(4, *n);
+    assert_true(coral$red_black_tree$get_at(&object, 2, (void **) &n));
+    assert_int_equal(8, *n);
+    while (object.root) {
+        assert_true(coral$red_black_tree$delete(&object, object.root));
+        check_counts(object.root);
+    }
+    assert_true(coral$red_black_tree$invalidate(&object, NULL));
     coral_error = CORAL_ERROR_NONE;
 }
 
@@ -2622,7 +3173,36 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_delete_leaf_nodes),
             cmocka_unit_test(check_delete_node_with_single_child),
             cmocka_unit_test(check_delete_node_with_two_children),
-            cmocka_unit_test(check_tree)
+            cmocka_unit_test(check_delete_closest_red_child_of_sibling_under_red_parent),
+            cmocka_unit_test(check_tree),
+            cmocka_unit_test(check_pool_alloc_error_on_null_object_ptr),
+            cmocka_unit_test(check_pool_alloc_error_on_null_argument_ptr),
+            cmocka_unit_test(check_pool_alloc_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_pool_alloc_error_on_invalid_value),
+            cmocka_unit_test(check_pool_alloc),
+            cmocka_unit_test(check_pool_free_error_on_null_object_ptr),
+            cmocka_unit_test(check_pool_free_error_on_null_argument_ptr),
+            cmocka_unit_test(check_pool_free_error_on_invalid_value),
+            cmocka_unit_test(check_pool_free_reuses_node),
+            cmocka_unit_test(check_pool_tree),
+            cmocka_unit_test(check_build_error_on_null_object_ptr),
+            cmocka_unit_test(check_build_error_on_null_argument_ptr),
+            cmocka_unit_test(check_build_error_on_object_unavailable),
+            cmocka_unit_test(check_build_error_on_invalid_value),
+            cmocka_unit_test(check_build),
+            cmocka_unit_test(check_init_counted_error_on_null_object_ptr),
+            cmocka_unit_test(check_init_counted_error_on_null_argument_ptr),
+            cmocka_unit_test(check_init_counted),
+            cmocka_unit_test(check_insert_error_on_invalid_value),
+            cmocka_unit_test(check_get_at_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_at_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_at_error_on_invalid_value),
+            cmocka_unit_test(check_get_at_error_on_index_out_of_bounds),
+            cmocka_unit_test(check_rank_of_error_on_null_object_ptr),
+            cmocka_unit_test(check_rank_of_error_on_null_argument_ptr),
+            cmocka_unit_test(check_rank_of_error_on_invalid_value),
+            cmocka_unit_test(check_counted_rotations),
+            cmocka_unit_test(check_counted_tree)
     };
     //cmocka_set_message_output(CM_OUTPUT_XML);
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,226 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <coral.h>
+
+#include "private/allocator.h"
+#include "private/region.h"
+
+static void check_start_error_on_argument_ptr_is_null(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_region_start(NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_end_error_on_object_ptr_is_null(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    size_t escaped;
+    assert_false(coral_region_end(NULL, &escaped));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_end_error_on_argument_ptr_is_null(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_region_end((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_end_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_region *outer, *inner;
+    assert_true(coral_region_start(&outer));
+    assert_true(coral_region_start(&inner));
+    size_t escaped;
+    assert_false(coral_region_end(outer, &escaped));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_true(coral_region_end(inner, &escaped));
+    assert_int_equal(0, escaped);
+    assert_true(coral_region_end(outer, &escaped));
+    assert_int_equal(0, escaped);
+    assert_true(coral$allocator$is_default());
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_contains_error_on_null_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    bool out;
+    assert_false(coral_region_contains(NULL, (void *) 1, &out));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_region_contains((void *) 1, NULL, &out));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_region_contains((void *) 1, (void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_objects_and_nodes(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class;
+    assert_true(coral_object_class(&class));
+    struct coral_region *region;
+    assert_true(coral_region_start(&region));
+    struct coral_array *array;
+    assert_true(coral_array_alloc(&array));
+    assert_true(coral_array_init(array, NULL, 0));
+    struct coral_tree_map *map;
+    assert_true(coral_tree_map_alloc(&map));
+    assert_true(coral_tree_map_init(map, NULL, coral_compare_void_ptr));
+    bool contains;
+    for (size_t i = 0; i < 1000; i++) {
+        struct coral_integer *integer;
+        assert_true(coral_integer_alloc(&integer));
+        assert_true(coral_integer_init(integer));
+        assert_true(coral_array_add(array, integer));
+        struct coral_tree_map_entry entry = {
+                .key = integer
+        };
+        assert_true(coral_tree_map_insert(map, &entry));
+        assert_true(coral_region_contains(region, integer, &contains));
+        assert_true(contains);
+    }
+    assert_true(coral_region_contains(region, array, &contains));
+    assert_true(contains);
+    assert_true(coral_region_contains(region, class, &contains));
+    assert_false(contains);
+    size_t escaped = SIZE_MAX;
+    assert_true(coral_region_end(region, &escaped));
+    assert_int_equal(0, escaped);
+    assert_true(coral$allocator$is_default());
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_objects_after_tree_set_read(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class;
+    assert_true(coral_object_class(&class));
+    struct coral_tree_set *set;
+    assert_true(coral_tree_set_alloc(&set));
+    assert_true(coral_tree_set_init(set, NULL, coral_compare_void_ptr));
+    bool contains = true;
+    assert_true(coral_tree_set_contains(set, class, &contains));
+    assert_false(contains);
+    /* reading a tree set must not hold back the memory of other objects */
+    struct coral_region *region;
+    assert_true(coral_region_start(&region));
+    for (size_t i = 0; i < 100; i++) {
+        struct coral_integer *integer;
+        assert_true(coral_integer_alloc(&integer));
+        assert_true(coral_integer_init(integer));
+    }
+    size_t escaped = SIZE_MAX;
+    assert_true(coral_region_end(region, &escaped));
+    assert_int_equal(0, escaped);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_large_blocks(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_region *region;
+    assert_true(coral_region_start(&region));
+    unsigned char *small, *large;
+    assert_true(coral$allocator$alloc(CORAL_ALLOCATOR_TAG_OTHER, 64, (void **) &small));
+    assert_true(coral$allocator$alloc(CORAL_ALLOCATOR_TAG_OTHER,
+                                      CORAL_REGION_CHUNK_SIZE,
+                                      (void **) &large));
+    memset(large, 0xff, CORAL_REGION_CHUNK_SIZE);
+    bool contains;
+    assert_true(coral_region_contains(region, large, &contains));
+    assert_true(contains);
+    /* the current chunk is kept after a large block was allocated */
+    unsigned char *next;
+    assert_true(coral$allocator$alloc(CORAL_ALLOCATOR_TAG_OTHER, 64, (void **) &next));
+    assert_true(next > small && next - small < CORAL_REGION_CHUNK_SIZE);
+    assert_true(coral$allocator$realloc(CORAL_ALLOCATOR_TAG_OTHER, next, 1024,
+                                        (void **) &next));
+    coral$allocator$free(next);
+    coral$allocator$free(large);
+    coral$allocator$free(small);
+    size_t escaped;
+    assert_true(coral_region_end(region, &escaped));
+    assert_int_equal(0, escaped);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_escaped_object(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class;
+    assert_true(coral_object_class(&class));
+    struct coral_region *region;
+    assert_true(coral_region_start(&region));
+    void *object;
+    assert_true(coral_object_alloc(0, &object));
+    assert_true(coral_object_init(object, class));
+    assert_true(coral_object_retain(object));
+    size_t escaped = 0;
+    assert_true(coral_region_end(region, &escaped));
+    assert_int_equal(1, escaped);
+    /* the region's memory is returned once the escaped object is gone */
+    assert_true(coral_object_release(object));
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_autoreleased_object(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_class *class;
+    assert_true(coral_object_class(&class));
+    struct coral_region *region;
+    assert_true(coral_region_start(&region));
+    void *object;
+    assert_true(coral_object_alloc(0, &object));
+    assert_true(coral_object_init(object, class));
+    /* the retain of the autorelease is given back when the region ends */
+    assert_true(coral_object_autorelease(object));
+    size_t escaped = SIZE_MAX;
+    assert_true(coral_region_end(region, &escaped));
+    assert_int_equal(0, escaped);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_resize_after_end(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_region *region;
+    assert_true(coral_region_start(&region));
+    unsigned char *block;
+    assert_true(coral$allocator$alloc(CORAL_ALLOCATOR_TAG_OTHER, 32,
+                                      (void **) &block));
+    memset(block, 0xab, 32);
+    size_t escaped = 0;
+    assert_true(coral_region_end(region, &escaped));
+    assert_int_equal(1, escaped);
+    /* resizing moves the block out of the region */
+    assert_true(coral$allocator$realloc(CORAL_ALLOCATOR_TAG_OTHER, block, 64,
+                                        (void **) &block));
+    for (size_t i = 0; i < 32; i++) {
+        assert_int_equal(0xab, block[i]);
+    }
+    coral$allocator$free(block);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_start_error_on_argument_ptr_is_null),
+            cmocka_unit_test(check_end_error_on_object_ptr_is_null),
+            cmocka_unit_test(check_end_error_on_argument_ptr_is_null),
+            cmocka_unit_test(check_end_error_on_invalid_value),
+            cmocka_unit_test(check_contains_error_on_null_ptr),
+            cmocka_unit_test(check_objects_and_nodes),
+            cmocka_unit_test(check_objects_after_tree_set_read),
+            cmocka_unit_test(check_large_blocks),
+            cmocka_unit_test(check_escaped_object),
+            cmocka_unit_test(check_autoreleased_object),
+            cmocka_unit_test(check_resize_after_end),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
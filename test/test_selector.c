@@ -0,0 +1,113 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <coral.h>
+
+#include "private/selector.h"
+
+static void check_of_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_selector_of(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_selector_of("fred", NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_of_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_false(coral_selector_of("", &selector));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_of(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    char name[] = "fred";
+    const struct coral_selector *a, *b, *c;
+    assert_true(coral_selector_of(name, &a));
+    assert_string_equal("fred", a->name);
+    assert_int_equal(4, a->size);
+    assert_int_not_equal(0, a->id);
+    /* the name is copied */
+    name[0] = 'F';
+    assert_true(coral_selector_of("fred", &b));
+    assert_ptr_equal(a, b);
+    assert_true(coral_selector_of(name, &c));
+    assert_ptr_not_equal(a, c);
+    assert_int_not_equal(a->id, c->id);
+    assert_true(coral$selector$of("fredward", 4, &c));
+    assert_ptr_equal(a, c);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_of_builtin_methods(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_true(coral$selector$find(hash_code, strlen(hash_code), &selector));
+    assert_string_equal(hash_code, selector->name);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_find_error_on_object_not_found(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_selector *selector;
+    assert_false(coral$selector$find("wilma", 5, &selector));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void *$register(void *arg) {
+    const struct coral_selector **selectors = arg;
+    char name[16];
+    for (size_t i = 0; i < 512; i++) {
+        snprintf(name, sizeof(name), "name%zu", i);
+        if (!coral_selector_of(name, &selectors[i])) {
+            return (void *) 1;
+        }
+    }
+    return NULL;
+}
+
+static void check_of_from_other_threads(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    static const struct coral_selector *selectors[4][512];
+    pthread_t threads[4];
+    for (size_t i = 0; i < 4; i++) {
+        assert_int_equal(0, pthread_create(&threads[i], NULL, $register,
+                                           selectors[i]));
+    }
+    for (size_t i = 0; i < 4; i++) {
+        void *result;
+        assert_int_equal(0, pthread_join(threads[i], &result));
+        assert_null(result);
+    }
+    for (size_t i = 0; i < 512; i++) {
+        for (size_t j = 1; j < 4; j++) {
+            assert_ptr_equal(selectors[0][i], selectors[j][i]);
+        }
+        if (i) {
+            assert_int_not_equal(selectors[0][i - 1]->id, selectors[0][i]->id);
+        }
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_of_error_on_null_argument_ptr),
+            cmocka_unit_test(check_of_error_on_invalid_value),
+            cmocka_unit_test(check_of),
+            cmocka_unit_test(check_of_builtin_methods),
+            cmocka_unit_test(check_find_error_on_object_not_found),
+            cmocka_unit_test(check_of_from_other_threads),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,133 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <pthread.h>
+#include <coral.h>
+
+#include "private/slab.h"
+
+static void check_is_eligible(void **state) {
+    assert_true(coral$slab$is_eligible(1));
+    assert_true(coral$slab$is_eligible(CORAL_SLAB_MAXIMUM_BLOCK_SIZE));
+    assert_false(coral$slab$is_eligible(1 + CORAL_SLAB_MAXIMUM_BLOCK_SIZE));
+}
+
+static void check_alloc_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    void *block;
+    assert_false(coral$slab$alloc(0, &block));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$slab$alloc(1 + CORAL_SLAB_MAXIMUM_BLOCK_SIZE, &block));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_alloc(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$slab$statistics before, after;
+    coral$slab$get_statistics(&before);
+    unsigned char *block;
+    assert_true(coral$slab$alloc(24, (void **) &block));
+    assert_non_null(block);
+    assert_int_equal(0, (uintptr_t) block % CORAL_SLAB_GRANULARITY);
+    for (size_t i = 0; i < 32; i++) {
+        assert_int_equal(0, block[i]);
+    }
+    memset(block, 0xff, 32);
+    coral$slab$get_statistics(&after);
+    assert_int_equal(1 + before.allocations, after.allocations);
+    coral$slab$free(block);
+    coral$slab$get_statistics(&after);
+    assert_int_equal(1 + before.deallocations, after.deallocations);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_free_reuses_block(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    unsigned char *a, *b;
+    assert_true(coral$slab$alloc(40, (void **) &a));
+    memset(a, 0xff, 48);
+    coral$slab$free(a);
+    assert_true(coral$slab$alloc(33, (void **) &b));
+    assert_ptr_equal(a, b);
+    for (size_t i = 0; i < 48; i++) {
+        assert_int_equal(0, b[i]);
+    }
+    coral$slab$free(b);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_empty_slab_is_unmapped(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const size_t count = (4 + CORAL_SLAB_MAXIMUM_EMPTY) * CORAL_SLAB_SIZE / 256;
+    void *blocks[count];
+    struct coral$slab$statistics before, after;
+    coral$slab$get_statistics(&before);
+    for (size_t i = 0; i < count; i++) {
+        assert_true(coral$slab$alloc(256, &blocks[i]));
+    }
+    coral$slab$get_statistics(&after);
+    assert_true(after.slabs_mapped - before.slabs_mapped >= 4);
+    assert_true(after.bytes_mapped > before.bytes_mapped);
+    for (size_t i = 0; i < count; i++) {
+        coral$slab$free(blocks[i]);
+    }
+    coral$slab$get_statistics(&after);
+    assert_true(after.slabs_unmapped - before.slabs_unmapped >= 3);
+    assert_true(after.bytes_mapped - before.bytes_mapped
+                <= (1 + CORAL_SLAB_MAXIMUM_EMPTY) * CORAL_SLAB_SIZE);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void *$free_on_other_thread(void *block) {
+    coral$slab$free(block);
+    struct coral$slab$statistics statistics;
+    coral$slab$get_statistics(&statistics);
+    return (void *) statistics.remote_deallocations;
+}
+
+static void check_free_from_other_thread(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const size_t size = CORAL_SLAB_MAXIMUM_BLOCK_SIZE;
+    const size_t count = CORAL_SLAB_SIZE / size;
+    void *first;
+    assert_true(coral$slab$alloc(size, &first));
+    const uintptr_t slab = (uintptr_t) first & ~(CORAL_SLAB_SIZE - 1);
+    pthread_t thread;
+    void *result;
+    assert_int_equal(0, pthread_create(&thread, NULL, $free_on_other_thread,
+                                       first));
+    assert_int_equal(0, pthread_join(thread, &result));
+    assert_int_equal(1, (uintptr_t) result);
+    /* once the slab is exhausted the block freed by the other thread must be
+     * collected before a new slab is mapped */
+    void *blocks[count];
+    size_t i;
+    bool found = false;
+    for (i = 0; i < count && !found; i++) {
+        assert_true(coral$slab$alloc(size, &blocks[i]));
+        assert_int_equal(slab, (uintptr_t) blocks[i] & ~(CORAL_SLAB_SIZE - 1));
+        found = blocks[i] == first;
+    }
+    assert_true(found);
+    while (i) {
+        coral$slab$free(blocks[--i]);
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_is_eligible),
+            cmocka_unit_test(check_alloc_error_on_invalid_value),
+            cmocka_unit_test(check_alloc),
+            cmocka_unit_test(check_free_reuses_block),
+            cmocka_unit_test(check_empty_slab_is_unmapped),
+            cmocka_unit_test(check_free_from_other_thread),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -4,9 +4,12 @@
 #include <cmocka.h>
 #include <coral.h>
 #include <string.h>
+#include <pthread.h>
 
 #include "private/tree_map.h"
+#include "private/array.h"
 #include "private/coral.h"
+#include "private/object.h"
 #include "test/cmocka.h"
 
 static void check_invalidate_error_on_null_object_ptr(void **state) {
@@ -45,6 +48,30 @@ static void check_init(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void check_init_with_engine_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$tree_map object = {};
+    assert_false(coral$tree_map$init_with_engine(
+            &object, NULL, sizeof(size_t), sizeof(size_t), -1,
+            coral_compare_size_t));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_with_engine(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$tree_map object = {};
+    assert_true(coral$tree_map$init_with_engine(
+            &object, NULL, sizeof(size_t), sizeof(size_t),
+            CORAL_TREE_SET_ENGINE_B_TREE, coral_compare_size_t));
+    assert_int_equal(sizeof(size_t), object.key_size);
+    assert_int_equal(sizeof(size_t), object.value_size);
+    assert_int_equal(CORAL_TREE_SET_ENGINE_B_TREE, object.tree_set.engine);
+    assert_int_equal(2 * sizeof(size_t), object.tree_set.b_tree.size);
+    assert_true(coral$tree_map$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_get_count_error_on_null_object_ptr(void **state) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral$tree_map$get_count(NULL, (void *) 1));
@@ -440,6 +467,160 @@ static void check_set(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void check_get_and_set_with_b_tree_engine(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$tree_map object = {};
+    assert_true(coral$tree_map$init_with_engine(
+            &object, NULL, sizeof(size_t), sizeof(size_t),
+            CORAL_TREE_SET_ENGINE_B_TREE, coral_compare_size_t));
+    struct entry {
+        size_t key;
+        size_t value;
+    } e, d;
+    for (size_t i = 0; i < 1000; i++) {
+        e = (struct entry) {.key = (i * 7919) % 1000, .value = i};
+        assert_true(coral$tree_map$insert(&object, &e));
+    }
+    for (size_t i = 0; i < 1000; i++) {
+        e = (struct entry) {.key = i, .value = 2 * i};
+        assert_true(coral$tree_map$set(&object, &e));
+    }
+    for (size_t i = 0; i < 1000; i++) {
+        assert_true(coral$tree_map$get(&object, &i, (void **) &d));
+        assert_int_equal(i, d.key);
+        assert_int_equal(2 * i, d.value);
+    }
+    e.key = 1000;
+    assert_false(coral$tree_map$get(&object, &e.key, (void **) &d));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_map$set(&object, &e));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    assert_true(coral$tree_map$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_map$build(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    assert_false(coral$tree_map$build_unsorted(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct entry {
+        size_t key;
+        size_t value;
+    } e;
+    struct coral$array entries;
+    assert_true(coral$array$init(&entries, NULL, 1000, sizeof(e)));
+    struct entry *data = (struct entry *) entries.data;
+    for (size_t i = 0; i < 1000; i++) {
+        data[i] = (struct entry) {.key = i, .value = 2 * i};
+    }
+    struct coral$tree_map object = {};
+    assert_true(coral$tree_map$init(&object, NULL, sizeof(size_t),
+                                    sizeof(size_t), coral_compare_size_t));
+    assert_true(coral$tree_map$build(&object, &entries));
+    for (size_t i = 0; i < 1000; i++) {
+        assert_true(coral$tree_map$get(&object, &i, (void **) &e));
+        assert_int_equal(i, e.key);
+        assert_int_equal(2 * i, e.value);
+    }
+    assert_true(coral$tree_map$invalidate(&object, NULL));
+    /* entries with the same key but not the same value */
+    data[999].key = 998;
+    assert_true(coral$tree_map$init(&object, NULL, sizeof(size_t),
+                                    sizeof(size_t), coral_compare_size_t));
+    assert_false(coral$tree_map$build(&object, &entries));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_true(coral$tree_map$invalidate(&object, NULL));
+    assert_true(coral$array$invalidate(&entries, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_unsorted(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct entry {
+        size_t key;
+        size_t value;
+    } e;
+    struct coral$array entries;
+    assert_true(coral$array$init(&entries, NULL, 1000, sizeof(e)));
+    struct entry *data = (struct entry *) entries.data;
+    for (size_t i = 0; i < 1000; i++) {
+        data[i] = (struct entry) {.key = (i * 7919) % 1000, .value = i};
+    }
+    struct coral$tree_map object = {};
+    assert_true(coral$tree_map$init(&object, NULL, sizeof(size_t),
+                                    sizeof(size_t), coral_compare_size_t));
+    assert_true(coral$tree_map$build_unsorted(&object, &entries));
+    assert_true(coral$tree_map$get_first(&object, (void **) &e));
+    for (size_t i = 0; i < 999; i++) {
+        assert_int_equal(i, e.key);
+        assert_int_equal(i, (e.value * 7919) % 1000);
+        assert_true(coral$tree_map$get_next(&object, &e, (void **) &e));
+    }
+    assert_true(coral$tree_map$invalidate(&object, NULL));
+    /* entries with the same key but not the same value */
+    data[999].key = data[0].key;
+    assert_true(coral$tree_map$init(&object, NULL, sizeof(size_t),
+                                    sizeof(size_t), coral_compare_size_t));
+    assert_false(coral$tree_map$build_unsorted(&object, &entries));
+    assert_int_equal(CORAL_ERROR_OBJECT_ALREADY_EXISTS, coral_error);
+    assert_true(coral$tree_map$invalidate(&object, NULL));
+    assert_true(coral$array$invalidate(&entries, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_at_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_map$get_at(NULL, 0, (void **) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_rank_of_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_map$rank_of(NULL, (void *) 1, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_at_and_rank_of(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$tree_map object = {};
+    assert_true(coral$tree_map$init_with_engine(
+            &object, NULL, sizeof(size_t), sizeof(size_t),
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE, coral_compare_size_t));
+    struct entry {
+        size_t key;
+        size_t value;
+    } e;
+    for (size_t i = 0; i < 1000; i++) {
+        e = (struct entry) {.key = 2 * ((i * 7919) % 1000), .value = i};
+        assert_true(coral$tree_map$insert(&object, &e));
+    }
+    for (size_t i = 0; i < 1000; i++) {
+        assert_true(coral$tree_map$get_at(&object, i, (void **) &e));
+        assert_int_equal(2 * i, e.key);
+        assert_int_equal(i, (e.value * 7919) % 1000);
+        size_t rank;
+        assert_true(coral$tree_map$rank_of(&object, &e.key, &rank));
+        assert_int_equal(i, rank);
+        const size_t key = 1 + 2 * i;
+        assert_true(coral$tree_map$rank_of(&object, &key, &rank));
+        assert_int_equal(1 + i, rank);
+    }
+    assert_false(coral$tree_map$get_at(&object, 1000, (void **) &e));
+    assert_int_equal(CORAL_ERROR_INDEX_OUT_OF_BOUNDS, coral_error);
+    assert_true(coral$tree_map$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_get_first_error_on_null_object_ptr(void **state) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral$tree_map$get_first(NULL, (void *) 1));
@@ -707,6 +888,57 @@ static void check_object_init(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void check_object_init_with_engine_error_on_invalid_value(
+        void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_map *object;
+    assert_true(coral_tree_map_alloc(&object));
+    assert_false(coral_tree_map_init_with_engine(object, NULL, -1,
+                                                 coral_compare_void_ptr));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_true(coral_tree_map_destroy(object));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_init_with_engine(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral_class *class = NULL;
+        assert_true(coral_object_class(&class));
+        struct coral_tree_map *object;
+        assert_true(coral_tree_map_alloc(&object));
+        assert_true(coral_tree_map_init_with_engine(object, NULL, engines[e],
+                                                    coral_compare_void_ptr));
+        struct coral_tree_map_entry entries[20];
+        for (size_t i = 0; i < 20; i++) {
+            assert_true(coral_object_alloc(0, &entries[i].key));
+            assert_true(coral_object_init(entries[i].key, class));
+            assert_true(coral_object_alloc(0, &entries[i].value));
+            assert_true(coral_object_init(entries[i].value, class));
+            assert_true(coral_tree_map_insert(object, &entries[i]));
+        }
+        for (size_t i = 0; i < 20; i += 2) {
+            assert_true(coral_tree_map_delete(object, entries[i].key));
+        }
+        size_t count;
+        assert_true(coral_tree_map_get_count(object, &count));
+        assert_int_equal(10, count);
+        for (size_t i = 1; i < 20; i += 2) {
+            void *value = NULL;
+            assert_true(coral_tree_map_get(object, entries[i].key, &value));
+            assert_ptr_equal(entries[i].value, value);
+        }
+        coral_autorelease_pool_drain();
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_object_hash_code_error_on_null_object_ptr(void **state) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral_tree_map_hash_code(NULL, (void *)1));
@@ -973,6 +1205,170 @@ static void check_object_insert(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static int $compare_entry_key(const void *a, const void *b) {
+    const struct coral_tree_map_entry *A = a;
+    const struct coral_tree_map_entry *B = b;
+    return coral_compare_void_ptr(A->key, B->key);
+}
+
+static void check_object_build_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_tree_map_build(NULL, (void *) 1, 0));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    assert_false(coral_tree_map_build_unsorted(NULL, (void *) 1, 0));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_build_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_tree_map_build((void *) 1, NULL, 0));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    assert_false(coral_tree_map_build_unsorted((void *) 1, NULL, 0));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_build_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const struct coral_tree_map_entry null_key[] = {{.key = NULL}};
+    assert_false(coral_tree_map_build((void *) 1, null_key, 1));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    struct coral_tree_map *object;
+    assert_true(coral_tree_map_alloc(&object));
+    assert_true(coral_tree_map_init(object, NULL, coral_compare_void_ptr));
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    struct coral_tree_map_entry entries[3];
+    for (size_t i = 0; i < 3; i++) {
+        assert_true(coral_object_alloc(0, &entries[i].key));
+        assert_true(coral_object_init(entries[i].key, class));
+        entries[i].value = NULL;
+    }
+    qsort(entries, 3, sizeof(entries[0]), $compare_entry_key);
+    const struct coral_tree_map_entry swap = entries[0];
+    entries[0] = entries[2];
+    entries[2] = swap;
+    assert_false(coral_tree_map_build(object, entries, 3));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    size_t count;
+    assert_true(coral_tree_map_get_count(object, &count));
+    assert_int_equal(0, count);
+    /* the keys are given back as they were */
+    size_t ref_count;
+    assert_true(coral$object$get_ref_count(coral$object_from(entries[0].key),
+                                           &ref_count));
+    assert_int_equal(1, ref_count);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_build_error_on_object_already_exists(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_map *object;
+    assert_true(coral_tree_map_alloc(&object));
+    assert_true(coral_tree_map_init(object, NULL, coral_compare_void_ptr));
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *o;
+    assert_true(coral_object_alloc(0, &o));
+    assert_true(coral_object_init(o, class));
+    const struct coral_tree_map_entry entries[] = {
+            {.key = o, .value = o},
+            {.key = o}
+    };
+    assert_false(coral_tree_map_build_unsorted(object, entries, 2));
+    assert_int_equal(CORAL_ERROR_OBJECT_ALREADY_EXISTS, coral_error);
+    size_t ref_count;
+    assert_true(coral$object$get_ref_count(coral$object_from(o), &ref_count));
+    assert_int_equal(1, ref_count);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_build(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral_class *class = NULL;
+        assert_true(coral_object_class(&class));
+        struct coral_tree_map_entry entries[100];
+        for (size_t i = 0; i < 100; i++) {
+            assert_true(coral_object_alloc(0, &entries[i].key));
+            assert_true(coral_object_init(entries[i].key, class));
+            assert_true(coral_object_alloc(0, &entries[i].value));
+            assert_true(coral_object_init(entries[i].value, class));
+        }
+        struct coral_tree_map *unsorted;
+        assert_true(coral_tree_map_alloc(&unsorted));
+        assert_true(coral_tree_map_init_with_engine(unsorted, NULL, engines[e],
+                                                    coral_compare_void_ptr));
+        assert_true(coral_tree_map_build_unsorted(unsorted, entries, 100));
+        qsort(entries, 100, sizeof(entries[0]), $compare_entry_key);
+        struct coral_tree_map *sorted;
+        assert_true(coral_tree_map_alloc(&sorted));
+        assert_true(coral_tree_map_init_with_engine(sorted, NULL, engines[e],
+                                                    coral_compare_void_ptr));
+        assert_true(coral_tree_map_build(sorted, entries, 100));
+        /* retained by both maps */
+        size_t ref_count;
+        assert_true(coral$object$get_ref_count(
+                coral$object_from(entries[0].value), &ref_count));
+        assert_int_equal(3, ref_count);
+        struct coral_tree_map *maps[] = {unsorted, sorted};
+        for (size_t m = 0; m < 2; m++) {
+            size_t count;
+            assert_true(coral_tree_map_get_count(maps[m], &count));
+            assert_int_equal(100, count);
+            for (size_t i = 0; i < 100; i++) {
+                void *value = NULL;
+                assert_true(coral_tree_map_get(maps[m], entries[i].key,
+                                               &value));
+                assert_ptr_equal(entries[i].value, value);
+            }
+        }
+        coral_autorelease_pool_drain();
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void $on_event(void *observer, void *object, const char *event) {
+    const char **events = observer;
+    while (*events) {
+        events++;
+    }
+    *events = event;
+}
+
+static void check_object_notifications(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_map *object;
+    assert_true(coral_tree_map_alloc(&object));
+    assert_true(coral_tree_map_init(object, NULL, coral_compare_void_ptr));
+    const char *events[4] = {};
+    assert_true(coral$object_add_observer(object, events, NULL, $on_event));
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *o;
+    assert_true(coral_object_alloc(0, &o));
+    assert_true(coral_object_init(o, class));
+    struct coral_tree_map_entry e = {
+            .key = o
+    };
+    assert_true(coral_tree_map_insert(object, &e));
+    assert_true(coral_tree_map_delete(object, o));
+    coral_autorelease_pool_drain();
+    assert_ptr_equal(CORAL_NOTIFICATION_CONTAINER_INCREASED, events[0]);
+    assert_ptr_equal(CORAL_NOTIFICATION_CONTAINER_DECREASED, events[1]);
+    assert_ptr_equal(CORAL_NOTIFICATION_OBJECT_DESTROYED, events[2]);
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_object_delete_error_on_null_object_ptr(void **state) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral_tree_map_delete(NULL, (void *)1));
@@ -1176,6 +1572,70 @@ static void check_object_get(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+struct $churn {
+    struct coral_tree_map *map;
+    void **keys;
+    size_t count;
+};
+
+static void *$churn(void *argument) {
+    struct $churn *churn = argument;
+    for (size_t r = 0; r < 100; r++) {
+        for (size_t i = 0; i < churn->count; i++) {
+            struct coral_tree_map_entry e = {
+                    .key = churn->keys[i]
+            };
+            assert_true(coral_tree_map_insert(churn->map, &e));
+        }
+        for (size_t i = 0; i < churn->count; i++) {
+            assert_true(coral_tree_map_delete(churn->map, churn->keys[i]));
+        }
+    }
+    coral_autorelease_pool_drain();
+    return NULL;
+}
+
+static void check_object_get_while_other_thread_writes(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_map *object;
+    assert_true(coral_tree_map_alloc(&object));
+    assert_true(coral_tree_map_init(object, NULL, coral_compare_void_ptr));
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *keys[65];
+    for (size_t i = 0; i < 65; i++) {
+        assert_true(coral_object_alloc(0, &keys[i]));
+        assert_true(coral_object_init(keys[i], class));
+    }
+    struct coral_tree_map_entry e = {
+            .key = keys[64],
+            .value = keys[0]
+    };
+    assert_true(coral_tree_map_insert(object, &e));
+    struct $churn churn = {
+            .map = object,
+            .keys = keys,
+            .count = 64
+    };
+    pthread_t thread;
+    assert_int_equal(0, pthread_create(&thread, NULL, $churn, &churn));
+    /* the entry is found whatever the writer is rebalancing */
+    for (size_t i = 0; i < 20000; i++) {
+        void *value = NULL;
+        assert_true(coral_tree_map_get(object, e.key, &value));
+        assert_ptr_equal(e.value, value);
+        bool contains = false;
+        assert_true(coral_tree_map_contains(object, e.key, &contains));
+        assert_true(contains);
+    }
+    assert_int_equal(0, pthread_join(thread, NULL));
+    size_t count;
+    assert_true(coral_tree_map_get_count(object, &count));
+    assert_int_equal(1, count);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_object_set_error_on_null_object_ptr(void **stata) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral_tree_map_set(NULL, (void *)1));
@@ -1243,6 +1703,8 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_init_error_on_null_object_ptr),
             cmocka_unit_test(check_init_error_on_null_argument_ptr),
             cmocka_unit_test(check_init),
+            cmocka_unit_test(check_init_with_engine_error_on_invalid_value),
+            cmocka_unit_test(check_init_with_engine),
             cmocka_unit_test(check_get_count_error_on_null_object_ptr),
             cmocka_unit_test(check_get_count_error_on_null_argument_ptr),
             cmocka_unit_test(check_get_count),
@@ -1278,6 +1740,13 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_set_error_on_null_argument_ptr),
             cmocka_unit_test(check_set_error_on_object_not_found),
             cmocka_unit_test(check_set),
+            cmocka_unit_test(check_get_and_set_with_b_tree_engine),
+            cmocka_unit_test(check_build_error_on_null_object_ptr),
+            cmocka_unit_test(check_build),
+            cmocka_unit_test(check_build_unsorted),
+            cmocka_unit_test(check_get_at_error_on_null_object_ptr),
+            cmocka_unit_test(check_rank_of_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_at_and_rank_of),
             cmocka_unit_test(check_get_first_error_on_null_object_ptr),
             cmocka_unit_test(check_get_first_error_on_null_argument_ptr),
             cmocka_unit_test(check_get_first_error_on_object_not_found),
@@ -1303,6 +1772,8 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_object_init_error_on_null_object_ptr),
             cmocka_unit_test(check_object_init_error_on_null_argument_ptr),
             cmocka_unit_test(check_object_init),
+            cmocka_unit_test(check_object_init_with_engine_error_on_invalid_value),
+            cmocka_unit_test(check_object_init_with_engine),
             cmocka_unit_test(check_object_hash_code_error_on_null_object_ptr),
             cmocka_unit_test(check_object_hash_code_error_on_null_argument_ptr),
             cmocka_unit_test(check_object_hash_code_error_on_object_uninitialized),
@@ -1330,6 +1801,12 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_object_insert_error_on_object_already_exists),
             cmocka_unit_test(check_object_insert_error_on_object_unavailable),
             cmocka_unit_test(check_object_insert),
+            cmocka_unit_test(check_object_build_error_on_null_object_ptr),
+            cmocka_unit_test(check_object_build_error_on_null_argument_ptr),
+            cmocka_unit_test(check_object_build_error_on_invalid_value),
+            cmocka_unit_test(check_object_build_error_on_object_already_exists),
+            cmocka_unit_test(check_object_build),
+            cmocka_unit_test(check_object_notifications),
             cmocka_unit_test(check_object_delete_error_on_null_object_ptr),
             cmocka_unit_test(check_object_delete_error_on_null_argument_ptr),
             cmocka_unit_test(check_object_delete_error_on_object_uninitialized),
@@ -1345,6 +1822,7 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_object_get_error_on_object_not_found),
             cmocka_unit_test(check_object_get_error_on_object_is_uninitialized),
             cmocka_unit_test(check_object_get),
+            cmocka_unit_test(check_object_get_while_other_thread_writes),
             cmocka_unit_test(check_object_set_error_on_null_object_ptr),
             cmocka_unit_test(check_object_set_error_on_null_argument_ptr),
             cmocka_unit_test(check_object_set_error_on_invalid_value),
@@ -5,7 +5,9 @@
 #include <coral.h>
 
 #include "private/tree_set.h"
+#include "private/array.h"
 #include "private/coral.h"
+#include "private/object.h"
 #include "test/cmocka.h"
 
 static void check_invalidate_error_on_null_object_ptr(void **state) {
@@ -46,6 +48,54 @@ static void check_init(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void check_init_with_engine_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_set$init_with_engine(
+            NULL, NULL, 1, CORAL_TREE_SET_ENGINE_B_TREE, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_with_engine_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_set$init_with_engine(
+            (void *) 1, NULL, 0, CORAL_TREE_SET_ENGINE_B_TREE, (void *) 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_set$init_with_engine(
+            (void *) 1, NULL, 1, CORAL_TREE_SET_ENGINE_B_TREE, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_with_engine_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_set$init_with_engine(
+            (void *) 1, NULL, 1, -1, (void *) 1));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_init_with_engine(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$tree_set object = {};
+    assert_true(coral$tree_set$init_with_engine(
+            &object, NULL, sizeof(size_t), CORAL_TREE_SET_ENGINE_B_TREE,
+            (void *) 1));
+    assert_int_equal(CORAL_TREE_SET_ENGINE_B_TREE, object.engine);
+    assert_int_equal(sizeof(size_t), object.size);
+    assert_int_equal(0, object.count);
+    assert_ptr_equal(1, object.b_tree.compare);
+    assert_null(object.b_tree.root);
+    assert_true(coral$tree_set$invalidate(&object, NULL));
+    assert_null(object.b_tree.compare);
+    assert_true(coral$tree_set$init(&object, NULL, sizeof(size_t),
+                                    (void *) 1));
+    assert_int_equal(CORAL_TREE_SET_ENGINE_RED_BLACK_TREE, object.engine);
+    assert_true(coral$tree_set$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_get_count_error_on_null_object_ptr(void **state) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral$tree_set$get_count(NULL, (void *) 1));
@@ -293,6 +343,69 @@ static void check_contains(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void check_search_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_set$search(NULL, (void *) 1, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_search_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_set$search((void *) 1, NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    assert_false(coral$tree_set$search((void *) 1, (void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_search_error_on_object_not_found(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral$tree_set object = {};
+        assert_true(coral$tree_set$init_with_engine(
+                &object, NULL, sizeof(size_t), engines[e],
+                coral_compare_size_t));
+        const size_t i = 87;
+        void *out;
+        assert_false(coral$tree_set$search(&object, &i, &out));
+        assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+        coral_error = CORAL_ERROR_NONE;
+        assert_true(coral$tree_set$invalidate(&object, NULL));
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_search(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral$tree_set object = {};
+        assert_true(coral$tree_set$init_with_engine(
+                &object, NULL, sizeof(size_t), engines[e],
+                coral_compare_size_t));
+        const size_t i = 87;
+        assert_true(coral$tree_set$insert(&object, &i));
+        void *out;
+        assert_true(coral$tree_set$search(&object, &i, &out));
+        assert_ptr_not_equal(&i, out);
+        assert_int_equal(i, *(size_t *) out);
+        assert_true(coral$tree_set$invalidate(&object, NULL));
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_get_first_error_on_null_object_ptr(void **state) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral$tree_set$get_first(NULL, (void *) 1));
@@ -491,6 +604,522 @@ static void check_get_prev(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void check_b_tree_engine(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$tree_set object = {};
+    struct coral_range_values limit = {.first = 10, .last = 1000};
+    assert_true(coral$tree_set$init_with_engine(
+            &object, &limit, sizeof(size_t), CORAL_TREE_SET_ENGINE_B_TREE,
+            coral_compare_size_t));
+    size_t i;
+    for (size_t j = 0; j < 1000; j++) {
+        i = (j * 7919) % 1000;
+        assert_true(coral$tree_set$insert(&object, &i));
+    }
+    assert_int_equal(1000, coral$atomic_load(&object.id));
+    assert_false(coral$tree_set$insert(&object, &i));
+    assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    /* drop the odd members */
+    for (i = 1; i < 1000; i += 2) {
+        assert_true(coral$tree_set$delete(&object, &i));
+    }
+    assert_false(coral$tree_set$delete(&object, &i));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_int_equal(500, object.count);
+    bool is_member;
+    i = 501;
+    assert_true(coral$tree_set$contains(&object, &i, &is_member));
+    assert_false(is_member);
+    i = 500;
+    assert_true(coral$tree_set$contains(&object, &i, &is_member));
+    assert_true(is_member);
+    assert_true(coral$tree_set$get_first(&object, (void **) &i));
+    for (size_t j = 0; j < 998; j += 2) {
+        assert_int_equal(j, i);
+        assert_true(coral$tree_set$get_next(&object, &i, (void **) &i));
+    }
+    assert_false(coral$tree_set$get_next(&object, &i, (void **) &i));
+    assert_int_equal(CORAL_ERROR_END_OF_SEQUENCE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_true(coral$tree_set$get_last(&object, (void **) &i));
+    for (size_t j = 998; j; j -= 2) {
+        assert_int_equal(j, i);
+        assert_true(coral$tree_set$get_prev(&object, &i, (void **) &i));
+    }
+    assert_false(coral$tree_set$get_prev(&object, &i, (void **) &i));
+    assert_int_equal(CORAL_ERROR_END_OF_SEQUENCE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    i = 1;
+    assert_false(coral$tree_set$get_next(&object, &i, (void **) &i));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    /* down to the lower limit */
+    for (i = 0; i < 980; i += 2) {
+        assert_true(coral$tree_set$delete(&object, &i));
+    }
+    assert_false(coral$tree_set$delete(&object, &i));
+    assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+    assert_true(coral$tree_set$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_compact_red_black_tree_engine(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$tree_set object = {};
+    assert_true(coral$tree_set$init_with_engine(
+            &object, NULL, sizeof(size_t),
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE,
+            coral_compare_size_t));
+    assert_int_equal(CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE,
+                     object.engine);
+    size_t i;
+    for (size_t j = 0; j < 1000; j++) {
+        i = (j * 7919) % 1000;
+        assert_true(coral$tree_set$insert(&object, &i));
+    }
+    assert_false(coral$tree_set$insert(&object, &i));
+    assert_int_equal(CORAL_ERROR_OBJECT_ALREADY_EXISTS, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    /* drop the odd members */
+    for (i = 1; i < 1000; i += 2) {
+        assert_true(coral$tree_set$delete(&object, &i));
+    }
+    assert_false(coral$tree_set$delete(&object, &i));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_int_equal(500, object.count);
+    assert_int_equal(500, object.compact_tree.count);
+    /* the members that come back take the nodes that were let go */
+    size_t footprint;
+    assert_true(coral$compact_red_black_tree$get_footprint(
+            &object.compact_tree, &footprint));
+    for (i = 1; i < 1000; i += 2) {
+        assert_true(coral$tree_set$insert(&object, &i));
+    }
+    size_t out;
+    assert_true(coral$compact_red_black_tree$get_footprint(
+            &object.compact_tree, &out));
+    assert_int_equal(footprint, out);
+    void *node;
+    i = 500;
+    assert_true(coral$tree_set$search(&object, &i, &node));
+    assert_int_equal(500, *(size_t *) node);
+    assert_true(coral$tree_set$get_first(&object, (void **) &i));
+    for (size_t j = 0; j < 999; j++) {
+        assert_int_equal(j, i);
+        assert_true(coral$tree_set$get_next(&object, &i, (void **) &i));
+    }
+    assert_false(coral$tree_set$get_next(&object, &i, (void **) &i));
+    assert_int_equal(CORAL_ERROR_END_OF_SEQUENCE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_true(coral$tree_set$get_last(&object, (void **) &i));
+    for (size_t j = 999; j; j--) {
+        assert_int_equal(j, i);
+        assert_true(coral$tree_set$get_prev(&object, &i, (void **) &i));
+    }
+    assert_false(coral$tree_set$get_prev(&object, &i, (void **) &i));
+    assert_int_equal(CORAL_ERROR_END_OF_SEQUENCE, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    i = 1000;
+    assert_false(coral$tree_set$get_next(&object, &i, (void **) &i));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    assert_true(coral$tree_set$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_set$build(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    assert_false(coral$tree_set$build_unsorted(NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_set$build((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    assert_false(coral$tree_set$build_unsorted((void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    struct coral$array items;
+    assert_true(coral$array$init(&items, NULL, 100, sizeof(uint32_t)));
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral$tree_set object = {};
+        assert_true(coral$tree_set$init_with_engine(
+                &object, NULL, sizeof(size_t), engines[e],
+                coral_compare_size_t));
+        /* items are not the size of the members */
+        assert_false(coral$tree_set$build(&object, &items));
+        assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+        assert_false(coral$tree_set$build_unsorted(&object, &items));
+        assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+        assert_true(coral$tree_set$invalidate(&object, NULL));
+    }
+    assert_true(coral$array$invalidate(&items, NULL));
+    assert_true(coral$array$init(&items, NULL, 100, sizeof(size_t)));
+    size_t *data = (size_t *) items.data;
+    for (size_t i = 0; i < 100; i++) {
+        data[i] = i;
+    }
+    data[50] = 49;
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral$tree_set object = {};
+        assert_true(coral$tree_set$init_with_engine(
+                &object, NULL, sizeof(size_t), engines[e],
+                coral_compare_size_t));
+        /* items are not strictly ascending */
+        assert_false(coral$tree_set$build(&object, &items));
+        assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+        assert_int_equal(0, object.count);
+        size_t *out;
+        assert_false(coral$tree_set$get_first(&object, (void **) &out));
+        assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+        assert_true(coral$tree_set$invalidate(&object, NULL));
+    }
+    assert_true(coral$array$invalidate(&items, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_error_on_object_unavailable(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    struct coral$array items;
+    assert_true(coral$array$init(&items, NULL, 100, sizeof(size_t)));
+    size_t *data = (size_t *) items.data;
+    for (size_t i = 0; i < 100; i++) {
+        data[i] = i;
+    }
+    struct coral_range_values limit = {.first = 0, .last = 99};
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral$tree_set object = {};
+        assert_true(coral$tree_set$init_with_engine(
+                &object, &limit, sizeof(size_t), engines[e],
+                coral_compare_size_t));
+        /* more items than the upper limit */
+        assert_false(coral$tree_set$build(&object, &items));
+        assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+        assert_false(coral$tree_set$build_unsorted(&object, &items));
+        assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+        /* set is not empty */
+        const size_t item = 1000;
+        assert_true(coral$tree_set$insert(&object, &item));
+        assert_true(coral$array$set_count(&items, 10));
+        assert_false(coral$tree_set$build(&object, &items));
+        assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+        assert_false(coral$tree_set$build_unsorted(&object, &items));
+        assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+        assert_int_equal(1, object.count);
+        assert_true(coral$array$set_count(&items, 100));
+        assert_true(coral$tree_set$invalidate(&object, NULL));
+    }
+    assert_true(coral$array$invalidate(&items, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_unsorted_error_on_object_already_exists(void **s) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    struct coral$array items;
+    assert_true(coral$array$init(&items, NULL, 1000, sizeof(size_t)));
+    size_t *data = (size_t *) items.data;
+    for (size_t i = 0; i < 1000; i++) {
+        data[i] = (i * 7919) % 1000;
+    }
+    data[700] = data[300];
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral$tree_set object = {};
+        assert_true(coral$tree_set$init_with_engine(
+                &object, NULL, sizeof(size_t), engines[e],
+                coral_compare_size_t));
+        assert_false(coral$tree_set$build_unsorted(&object, &items));
+        assert_int_equal(CORAL_ERROR_OBJECT_ALREADY_EXISTS, coral_error);
+        assert_int_equal(0, object.count);
+        size_t *out;
+        assert_false(coral$tree_set$get_first(&object, (void **) &out));
+        assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+        assert_true(coral$tree_set$invalidate(&object, NULL));
+    }
+    assert_true(coral$array$invalidate(&items, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    struct coral$array items;
+    assert_true(coral$array$init(&items, NULL, 1000, sizeof(size_t)));
+    size_t *data = (size_t *) items.data;
+    for (size_t i = 0; i < 1000; i++) {
+        data[i] = 2 * i;
+    }
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral$tree_set object = {};
+        assert_true(coral$tree_set$init_with_engine(
+                &object, NULL, sizeof(size_t), engines[e],
+                coral_compare_size_t));
+        assert_true(coral$tree_set$build(&object, &items));
+        assert_int_equal(1000, object.count);
+        assert_int_equal(1, coral$atomic_load(&object.id));
+        size_t i;
+        assert_true(coral$tree_set$get_first(&object, (void **) &i));
+        for (size_t j = 0; j < 1998; j += 2) {
+            assert_int_equal(j, i);
+            assert_true(coral$tree_set$get_next(&object, &i, (void **) &i));
+        }
+        assert_int_equal(1998, i);
+        /* members are copies of the items */
+        data[0] = 1;
+        i = 0;
+        bool is_member;
+        assert_true(coral$tree_set$contains(&object, &i, &is_member));
+        assert_true(is_member);
+        data[0] = 0;
+        /* the set carries on as if the items had been inserted */
+        for (i = 1; i < 2000; i += 2) {
+            assert_true(coral$tree_set$insert(&object, &i));
+        }
+        for (i = 0; i < 2000; i += 2) {
+            assert_true(coral$tree_set$delete(&object, &i));
+        }
+        assert_true(coral$tree_set$get_first(&object, (void **) &i));
+        for (size_t j = 1; j < 1999; j += 2) {
+            assert_int_equal(j, i);
+            assert_true(coral$tree_set$get_next(&object, &i, (void **) &i));
+        }
+        assert_true(coral$tree_set$invalidate(&object, NULL));
+    }
+    assert_true(coral$array$invalidate(&items, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_build_unsorted(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    struct coral$array items;
+    assert_true(coral$array$init(&items, NULL, 1000, sizeof(size_t)));
+    size_t *data = (size_t *) items.data;
+    for (size_t i = 0; i < 1000; i++) {
+        data[i] = (i * 7919) % 1000;
+    }
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral$tree_set object = {};
+        assert_true(coral$tree_set$init_with_engine(
+                &object, NULL, sizeof(size_t), engines[e],
+                coral_compare_size_t));
+        assert_true(coral$tree_set$build_unsorted(&object, &items));
+        assert_int_equal(1000, object.count);
+        size_t i;
+        assert_true(coral$tree_set$get_first(&object, (void **) &i));
+        for (size_t j = 0; j < 999; j++) {
+            assert_int_equal(j, i);
+            assert_true(coral$tree_set$get_next(&object, &i, (void **) &i));
+        }
+        assert_int_equal(999, i);
+        assert_false(coral$tree_set$get_next(&object, &i, (void **) &i));
+        assert_int_equal(CORAL_ERROR_END_OF_SEQUENCE, coral_error);
+        assert_true(coral$tree_set$invalidate(&object, NULL));
+    }
+    /* the items are left in the order they were in */
+    for (size_t i = 0; i < 1000; i++) {
+        assert_int_equal((i * 7919) % 1000, data[i]);
+    }
+    assert_true(coral$array$invalidate(&items, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_at_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_set$get_at(NULL, 0, (void **) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_at_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_set$get_at((void *) 1, 0, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_at_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral$tree_set object = {};
+        assert_true(coral$tree_set$init_with_engine(
+                &object, NULL, sizeof(size_t), engines[e],
+                coral_compare_size_t));
+        const size_t item = 1;
+        assert_true(coral$tree_set$insert(&object, &item));
+        size_t out;
+        assert_false(coral$tree_set$get_at(&object, 0, (void **) &out));
+        assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+        assert_true(coral$tree_set$invalidate(&object, NULL));
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_at_error_on_index_out_of_bounds(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$tree_set object = {};
+    assert_true(coral$tree_set$init_with_engine(
+            &object, NULL, sizeof(size_t),
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            coral_compare_size_t));
+    size_t out;
+    assert_false(coral$tree_set$get_at(&object, 0, (void **) &out));
+    assert_int_equal(CORAL_ERROR_INDEX_OUT_OF_BOUNDS, coral_error);
+    const size_t item = 1;
+    assert_true(coral$tree_set$insert(&object, &item));
+    assert_false(coral$tree_set$get_at(&object, 1, (void **) &out));
+    assert_int_equal(CORAL_ERROR_INDEX_OUT_OF_BOUNDS, coral_error);
+    assert_true(coral$tree_set$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_get_at(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$tree_set object = {};
+    assert_true(coral$tree_set$init_with_engine(
+            &object, NULL, sizeof(size_t),
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            coral_compare_size_t));
+    size_t i;
+    for (size_t j = 0; j < 1000; j++) {
+        i = 10 * ((j * 7919) % 1000);
+        assert_true(coral$tree_set$insert(&object, &i));
+    }
+    for (size_t j = 0; j < 1000; j++) {
+        assert_true(coral$tree_set$get_at(&object, j, (void **) &i));
+        assert_int_equal(10 * j, i);
+    }
+    /* percentiles */
+    assert_true(coral$tree_set$get_at(&object, object.count / 2,
+                                      (void **) &i));
+    assert_int_equal(5000, i);
+    assert_true(coral$tree_set$get_at(&object, 99 * object.count / 100,
+                                      (void **) &i));
+    assert_int_equal(9900, i);
+    for (i = 0; i < 10000; i += 20) {
+        assert_true(coral$tree_set$delete(&object, &i));
+    }
+    for (size_t j = 0; j < 500; j++) {
+        assert_true(coral$tree_set$get_at(&object, j, (void **) &i));
+        assert_int_equal(10 + 20 * j, i);
+    }
+    assert_true(coral$tree_set$invalidate(&object, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_rank_of_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_set$rank_of(NULL, (void *) 1, (void *) 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_rank_of_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral$tree_set$rank_of((void *) 1, NULL, (void *) 1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    assert_false(coral$tree_set$rank_of((void *) 1, (void *) 1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_rank_of_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral$tree_set object = {};
+        assert_true(coral$tree_set$init_with_engine(
+                &object, NULL, sizeof(size_t), engines[e],
+                coral_compare_size_t));
+        const size_t item = 1;
+        size_t out;
+        assert_false(coral$tree_set$rank_of(&object, &item, &out));
+        assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+        assert_true(coral$tree_set$invalidate(&object, NULL));
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_rank_of(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral$array items;
+    assert_true(coral$array$init(&items, NULL, 1000, sizeof(size_t)));
+    size_t *data = (size_t *) items.data;
+    for (size_t i = 0; i < 1000; i++) {
+        data[i] = 10 * i;
+    }
+    struct coral$tree_set object = {};
+    assert_true(coral$tree_set$init_with_engine(
+            &object, NULL, sizeof(size_t),
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            coral_compare_size_t));
+    assert_true(coral$tree_set$build(&object, &items));
+    size_t out;
+    for (size_t i = 0; i < 1000; i++) {
+        assert_true(coral$tree_set$rank_of(&object, &data[i], &out));
+        assert_int_equal(i, out);
+        /* values that are not in the set */
+        const size_t value = 5 + 10 * i;
+        assert_true(coral$tree_set$rank_of(&object, &value, &out));
+        assert_int_equal(1 + i, out);
+    }
+    const size_t item = 10000;
+    assert_true(coral$tree_set$insert(&object, &item));
+    assert_true(coral$tree_set$rank_of(&object, &item, &out));
+    assert_int_equal(1000, out);
+    assert_true(coral$tree_set$delete(&object, &data[0]));
+    assert_true(coral$tree_set$rank_of(&object, &item, &out));
+    assert_int_equal(999, out);
+    assert_true(coral$tree_set$invalidate(&object, NULL));
+    assert_true(coral$array$invalidate(&items, NULL));
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_object_class_error_on_null_argument(void **state) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral_tree_set_class(NULL));
@@ -669,6 +1298,64 @@ static void check_object_copy_error_on_object_uninitialized(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void check_object_init_with_engine_error_on_invalid_value(
+        void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_set *object;
+    assert_true(coral_tree_set_alloc(&object));
+    assert_false(coral_tree_set_init_with_engine(object, NULL, -1,
+                                                 coral_compare_void_ptr));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    assert_true(coral_tree_set_destroy(object));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_init_with_engine(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral_class *class = NULL;
+        assert_true(coral_object_class(&class));
+        struct coral_tree_set *object;
+        assert_true(coral_tree_set_alloc(&object));
+        assert_true(coral_tree_set_init_with_engine(object, NULL, engines[e],
+                                                    coral_compare_void_ptr));
+        void *items[100];
+        for (size_t i = 0; i < 100; i++) {
+            assert_true(coral_object_alloc(0, &items[i]));
+            assert_true(coral_object_init(items[i], class));
+            assert_true(coral_tree_set_insert(object, items[i]));
+        }
+        for (size_t i = 0; i < 100; i += 2) {
+            assert_true(coral_tree_set_delete(object, items[i]));
+        }
+        size_t count;
+        assert_true(coral_tree_set_get_count(object, &count));
+        assert_int_equal(50, count);
+        /* the copy keeps the engine of its source */
+        struct coral_tree_set *copy;
+        assert_true(coral_tree_set_copy(object, &copy));
+        assert_true(coral_tree_set_insert(copy, items[0]));
+        void *o, *last = NULL;
+        assert_true(coral_tree_set_get_first(copy, &o));
+        count = 0;
+        do {
+            assert_true(!last || coral_compare_void_ptr(last, o) < 0);
+            last = o;
+            count++;
+        } while (coral_tree_set_get_next(copy, o, &o));
+        assert_int_equal(CORAL_ERROR_END_OF_SEQUENCE, coral_error);
+        assert_int_equal(51, count);
+        coral_autorelease_pool_drain();
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_object_copy(void **state) {
     // TODO: implement (once get and set is done) ...
     assert_true(false);
@@ -845,6 +1532,194 @@ static void check_object_insert(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static int $compare_instance_ptr(const void *a, const void *b) {
+    return coral_compare_void_ptr(*(void **) a, *(void **) b);
+}
+
+static void check_object_build_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_tree_set_build(NULL, (void *) 1, 0));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    assert_false(coral_tree_set_build_unsorted(NULL, (void *) 1, 0));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_build_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_tree_set_build((void *) 1, NULL, 0));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    assert_false(coral_tree_set_build_unsorted((void *) 1, NULL, 0));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    void *instances[] = {(void *) 1, NULL};
+    assert_false(coral_tree_set_build((void *) 1, instances, 2));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_build_error_on_object_uninitialized(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_set *object;
+    assert_true(coral_tree_set_alloc(&object));
+    void *instances[] = {(void *) 1};
+    assert_false(coral_tree_set_build(object, instances, 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_IS_UNINITIALIZED, coral_error);
+    assert_true(coral_tree_set_destroy(object));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_build_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_set *object;
+    assert_true(coral_tree_set_alloc(&object));
+    assert_true(coral_tree_set_init(object, NULL, coral_compare_void_ptr));
+    struct coral_class *class;
+    assert_true(coral_object_class(&class));
+    void *instances[3];
+    for (size_t i = 0; i < 3; i++) {
+        assert_true(coral_object_alloc(0, &instances[i]));
+        assert_true(coral_object_init(instances[i], class));
+    }
+    qsort(instances, 3, sizeof(void *), $compare_instance_ptr);
+    void *swap = instances[0];
+    instances[0] = instances[2];
+    instances[2] = swap;
+    assert_false(coral_tree_set_build(object, instances, 3));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    size_t count;
+    assert_true(coral_tree_set_get_count(object, &count));
+    assert_int_equal(0, count);
+    /* the instances are given back as they were */
+    size_t ref_count;
+    assert_true(coral$object$get_ref_count(coral$object_from(instances[0]),
+                                           &ref_count));
+    assert_int_equal(1, ref_count);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_build_error_on_object_already_exists(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_set *object;
+    assert_true(coral_tree_set_alloc(&object));
+    assert_true(coral_tree_set_init(object, NULL, coral_compare_void_ptr));
+    struct coral_class *class;
+    assert_true(coral_object_class(&class));
+    void *o;
+    assert_true(coral_object_alloc(0, &o));
+    assert_true(coral_object_init(o, class));
+    void *instances[] = {o, o};
+    assert_false(coral_tree_set_build_unsorted(object, instances, 2));
+    assert_int_equal(CORAL_ERROR_OBJECT_ALREADY_EXISTS, coral_error);
+    size_t ref_count;
+    assert_true(coral$object$get_ref_count(coral$object_from(o), &ref_count));
+    assert_int_equal(1, ref_count);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_build_error_on_object_unavailable(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_set *object;
+    assert_true(coral_tree_set_alloc(&object));
+    assert_true(coral_tree_set_init(object, NULL, coral_compare_void_ptr));
+    struct coral_class *class;
+    assert_true(coral_object_class(&class));
+    void *o;
+    assert_true(coral_object_alloc(0, &o));
+    assert_true(coral_object_init(o, class));
+    assert_true(coral_tree_set_insert(object, o));
+    void *instances[] = {o};
+    assert_false(coral_tree_set_build(object, instances, 1));
+    assert_int_equal(CORAL_ERROR_OBJECT_UNAVAILABLE, coral_error);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_build(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    const int engines[] = {
+            CORAL_TREE_SET_ENGINE_RED_BLACK_TREE,
+            CORAL_TREE_SET_ENGINE_B_TREE,
+            CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            CORAL_TREE_SET_ENGINE_COMPACT_RED_BLACK_TREE
+    };
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); e++) {
+        struct coral_class *class;
+        assert_true(coral_object_class(&class));
+        void *instances[100];
+        for (size_t i = 0; i < 100; i++) {
+            assert_true(coral_object_alloc(0, &instances[i]));
+            assert_true(coral_object_init(instances[i], class));
+        }
+        struct coral_tree_set *unsorted;
+        assert_true(coral_tree_set_alloc(&unsorted));
+        assert_true(coral_tree_set_init_with_engine(unsorted, NULL, engines[e],
+                                                    coral_compare_void_ptr));
+        assert_true(coral_tree_set_build_unsorted(unsorted, instances, 100));
+        qsort(instances, 100, sizeof(void *), $compare_instance_ptr);
+        struct coral_tree_set *sorted;
+        assert_true(coral_tree_set_alloc(&sorted));
+        assert_true(coral_tree_set_init_with_engine(sorted, NULL, engines[e],
+                                                    coral_compare_void_ptr));
+        assert_true(coral_tree_set_build(sorted, instances, 100));
+        /* retained by both sets */
+        size_t ref_count;
+        assert_true(coral$object$get_ref_count(
+                coral$object_from(instances[0]), &ref_count));
+        assert_int_equal(3, ref_count);
+        struct coral_tree_set *sets[] = {unsorted, sorted};
+        for (size_t s = 0; s < 2; s++) {
+            size_t count;
+            assert_true(coral_tree_set_get_count(sets[s], &count));
+            assert_int_equal(100, count);
+            void *o;
+            assert_true(coral_tree_set_get_first(sets[s], &o));
+            for (size_t i = 0; i < 100; i++) {
+                assert_ptr_equal(instances[i], o);
+                assert_true(i == 99
+                            || coral_tree_set_get_next(sets[s], o, &o));
+            }
+        }
+        coral_autorelease_pool_drain();
+    }
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void $on_event(void *observer, void *object, const char *event) {
+    const char **events = observer;
+    while (*events) {
+        events++;
+    }
+    *events = event;
+}
+
+static void check_object_notifications(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_set *object;
+    assert_true(coral_tree_set_alloc(&object));
+    assert_true(coral_tree_set_init(object, NULL, coral_compare_void_ptr));
+    const char *events[5] = {};
+    assert_true(coral$object_add_observer(object, events, NULL, $on_event));
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *o;
+    assert_true(coral_object_alloc(0, &o));
+    assert_true(coral_object_init(o, class));
+    assert_true(coral_tree_set_insert(object, o));
+    assert_false(coral_tree_set_insert(object, o));
+    assert_int_equal(CORAL_ERROR_OBJECT_ALREADY_EXISTS, coral_error);
+    assert_true(coral_tree_set_delete(object, o));
+    assert_false(coral_tree_set_delete(object, o));
+    assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
+    coral_autorelease_pool_drain();
+    assert_ptr_equal(CORAL_NOTIFICATION_CONTAINER_INCREASED, events[0]);
+    assert_ptr_equal(CORAL_NOTIFICATION_CONTAINER_DECREASED, events[1]);
+    assert_ptr_equal(CORAL_NOTIFICATION_OBJECT_DESTROYED, events[2]);
+    assert_null(events[3]);
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_object_delete_error_on_null_object_ptr(void **state) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral_tree_set_delete(NULL, (void *)1));
@@ -1084,6 +1959,153 @@ static void check_object_get_last(void **state) {
     coral_error = CORAL_ERROR_NONE;
 }
 
+static void check_object_get_at_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_tree_set_get_at(NULL, 0, (void *)1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_get_at_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_tree_set_get_at((void *)1, 0, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_get_at_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_set *object;
+    assert_true(coral_tree_set_alloc(&object));
+    assert_true(coral_tree_set_init(object, NULL, coral_compare_void_ptr));
+    void *o;
+    assert_false(coral_tree_set_get_at(object, 0, &o));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_get_at_error_on_index_out_of_bounds(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_set *object;
+    assert_true(coral_tree_set_alloc(&object));
+    assert_true(coral_tree_set_init_with_engine(
+            object, NULL, CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            coral_compare_void_ptr));
+    void *o;
+    assert_false(coral_tree_set_get_at(object, 0, &o));
+    assert_int_equal(CORAL_ERROR_INDEX_OUT_OF_BOUNDS, coral_error);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_get_at_error_on_object_uninitialized(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_set *object;
+    assert_true(coral_tree_set_alloc(&object));
+    void *o;
+    assert_false(coral_tree_set_get_at(object, 0, &o));
+    assert_int_equal(CORAL_ERROR_OBJECT_IS_UNINITIALIZED, coral_error);
+    assert_true(coral_tree_set_destroy(object));
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_get_at(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_set *object;
+    assert_true(coral_tree_set_alloc(&object));
+    assert_true(coral_tree_set_init_with_engine(
+            object, NULL, CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            coral_compare_void_ptr));
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    for (size_t i = 0; i < 20; i++) {
+        void *o;
+        assert_true(coral_object_alloc(0, &o));
+        assert_true(coral_object_init(o, class));
+        assert_true(coral_tree_set_insert(object, o));
+    }
+    void *o;
+    assert_true(coral_tree_set_get_first(object, &o));
+    for (size_t i = 0; i < 20; i++) {
+        void *at;
+        assert_true(coral_tree_set_get_at(object, i, &at));
+        assert_ptr_equal(o, at);
+        if (i < 19) {
+            assert_true(coral_tree_set_get_next(object, o, &o));
+        }
+    }
+    assert_false(coral_tree_set_get_at(object, 20, &o));
+    assert_int_equal(CORAL_ERROR_INDEX_OUT_OF_BOUNDS, coral_error);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_rank_of_error_on_null_object_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_tree_set_rank_of(NULL, (void *)1, (void *)1));
+    assert_int_equal(CORAL_ERROR_OBJECT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_rank_of_error_on_null_argument_ptr(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_tree_set_rank_of((void *)1, NULL, (void *)1));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+    assert_false(coral_tree_set_rank_of((void *)1, (void *)1, NULL));
+    assert_int_equal(CORAL_ERROR_ARGUMENT_PTR_IS_NULL, coral_error);
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_rank_of_error_on_invalid_value(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_set *object;
+    assert_true(coral_tree_set_alloc(&object));
+    assert_true(coral_tree_set_init_with_engine(
+            object, NULL, CORAL_TREE_SET_ENGINE_B_TREE,
+            coral_compare_void_ptr));
+    size_t rank;
+    assert_false(coral_tree_set_rank_of(object, object, &rank));
+    assert_int_equal(CORAL_ERROR_INVALID_VALUE, coral_error);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
+static void check_object_rank_of(void **state) {
+    coral_error = CORAL_ERROR_NONE;
+    struct coral_tree_set *object;
+    assert_true(coral_tree_set_alloc(&object));
+    assert_true(coral_tree_set_init_with_engine(
+            object, NULL, CORAL_TREE_SET_ENGINE_ORDER_STATISTIC_TREE,
+            coral_compare_void_ptr));
+    struct coral_class *class = NULL;
+    assert_true(coral_object_class(&class));
+    void *items[20];
+    for (size_t i = 0; i < 20; i++) {
+        assert_true(coral_object_alloc(0, &items[i]));
+        assert_true(coral_object_init(items[i], class));
+        assert_true(coral_tree_set_insert(object, items[i]));
+    }
+    for (size_t i = 0; i < 20; i++) {
+        size_t rank;
+        assert_true(coral_tree_set_rank_of(object, items[i], &rank));
+        void *at;
+        assert_true(coral_tree_set_get_at(object, rank, &at));
+        assert_ptr_equal(items[i], at);
+    }
+    /* an instance that is not a member is ranked among the members */
+    assert_true(coral_tree_set_delete(object, items[0]));
+    size_t rank, count = 0;
+    assert_true(coral_tree_set_rank_of(object, items[0], &rank));
+    for (size_t i = 1; i < 20; i++) {
+        count += coral_compare_void_ptr(items[i], items[0]) < 0;
+    }
+    assert_int_equal(count, rank);
+    coral_autorelease_pool_drain();
+    coral_error = CORAL_ERROR_NONE;
+}
+
 static void check_object_get_next_error_on_null_object_ptr(void **state) {
     coral_error = CORAL_ERROR_NONE;
     assert_false(coral_tree_set_get_next(NULL, (void *)1, (void *)1));
@@ -1106,7 +2128,7 @@ static void check_object_get_next_error_on_object_not_found(void **state) {
     struct coral_tree_set *object;
     assert_true(coral_tree_set_alloc(&object));
     assert_true(coral_tree_set_init(object, NULL, coral_compare_void_ptr));
-    void *i;
+    void *i = (void *) 1;
     assert_false(coral_tree_set_get_next(object, i, &i));
     assert_int_equal(CORAL_ERROR_OBJECT_NOT_FOUND, coral_error);
     coral_autorelease_pool_drain();
@@ -1254,6 +2276,10 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_init_error_on_null_object_ptr),
             cmocka_unit_test(check_init_error_on_null_argument_ptr),
             cmocka_unit_test(check_init),
+            cmocka_unit_test(check_init_with_engine_error_on_null_object_ptr),
+            cmocka_unit_test(check_init_with_engine_error_on_null_argument_ptr),
+            cmocka_unit_test(check_init_with_engine_error_on_invalid_value),
+            cmocka_unit_test(check_init_with_engine),
             cmocka_unit_test(check_get_count_error_on_null_object_ptr),
             cmocka_unit_test(check_get_count_error_on_null_argument_ptr),
             cmocka_unit_test(check_get_count),
@@ -1275,6 +2301,10 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_contains_error_on_null_object_ptr),
             cmocka_unit_test(check_contains_error_on_null_argument_ptr),
             cmocka_unit_test(check_contains),
+            cmocka_unit_test(check_search_error_on_null_object_ptr),
+            cmocka_unit_test(check_search_error_on_null_argument_ptr),
+            cmocka_unit_test(check_search_error_on_object_not_found),
+            cmocka_unit_test(check_search),
             cmocka_unit_test(check_get_first_error_on_null_object_ptr),
             cmocka_unit_test(check_get_first_error_on_null_argument_ptr),
             cmocka_unit_test(check_get_first_error_on_object_not_found),
@@ -1293,6 +2323,24 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_get_prev_error_on_object_not_found),
             cmocka_unit_test(check_get_prev_error_on_end_of_sequence),
             cmocka_unit_test(check_get_prev),
+            cmocka_unit_test(check_b_tree_engine),
+            cmocka_unit_test(check_compact_red_black_tree_engine),
+            cmocka_unit_test(check_build_error_on_null_object_ptr),
+            cmocka_unit_test(check_build_error_on_null_argument_ptr),
+            cmocka_unit_test(check_build_error_on_invalid_value),
+            cmocka_unit_test(check_build_error_on_object_unavailable),
+            cmocka_unit_test(check_build_unsorted_error_on_object_already_exists),
+            cmocka_unit_test(check_build),
+            cmocka_unit_test(check_build_unsorted),
+            cmocka_unit_test(check_get_at_error_on_null_object_ptr),
+            cmocka_unit_test(check_get_at_error_on_null_argument_ptr),
+            cmocka_unit_test(check_get_at_error_on_invalid_value),
+            cmocka_unit_test(check_get_at_error_on_index_out_of_bounds),
+            cmocka_unit_test(check_get_at),
+            cmocka_unit_test(check_rank_of_error_on_null_object_ptr),
+            cmocka_unit_test(check_rank_of_error_on_null_argument_ptr),
+            cmocka_unit_test(check_rank_of_error_on_invalid_value),
+            cmocka_unit_test(check_rank_of),
             cmocka_unit_test(check_object_class_error_on_null_argument),
             cmocka_unit_test(check_object_class),
             cmocka_unit_test(check_object_destroy_error_on_null_object_ptr),
@@ -1300,6 +2348,8 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_object_alloc),
             cmocka_unit_test(check_object_init_error_on_null_object_ptr),
             cmocka_unit_test(check_object_init_error_on_null_argument_ptr),
+            cmocka_unit_test(check_object_init_with_engine_error_on_invalid_value),
+            cmocka_unit_test(check_object_init_with_engine),
             cmocka_unit_test(check_object_init),
             cmocka_unit_test(check_object_hash_code_error_on_null_object_ptr),
             cmocka_unit_test(check_object_hash_code_error_on_null_argument_ptr),
@@ -1328,6 +2378,14 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_object_insert_error_on_object_already_exists),
             cmocka_unit_test(check_object_insert_error_on_object_unavailable),
             cmocka_unit_test(check_object_insert),
+            cmocka_unit_test(check_object_build_error_on_null_object_ptr),
+            cmocka_unit_test(check_object_build_error_on_null_argument_ptr),
+            cmocka_unit_test(check_object_build_error_on_object_uninitialized),
+            cmocka_unit_test(check_object_build_error_on_invalid_value),
+            cmocka_unit_test(check_object_build_error_on_object_already_exists),
+            cmocka_unit_test(check_object_build_error_on_object_unavailable),
+            cmocka_unit_test(check_object_build),
+            cmocka_unit_test(check_object_notifications),
             cmocka_unit_test(check_object_delete_error_on_null_object_ptr),
             cmocka_unit_test(check_object_delete_error_on_null_argument_ptr),
             cmocka_unit_test(check_object_delete_error_on_object_uninitialized),
@@ -1348,6 +2406,16 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_object_get_last_error_on_object_not_found),
             cmocka_unit_test(check_object_get_last_error_on_object_uninitialized),
             cmocka_unit_test(check_object_get_last),
+            cmocka_unit_test(check_object_get_at_error_on_null_object_ptr),
+            cmocka_unit_test(check_object_get_at_error_on_null_argument_ptr),
+            cmocka_unit_test(check_object_get_at_error_on_invalid_value),
+            cmocka_unit_test(check_object_get_at_error_on_index_out_of_bounds),
+            cmocka_unit_test(check_object_get_at_error_on_object_uninitialized),
+            cmocka_unit_test(check_object_get_at),
+            cmocka_unit_test(check_object_rank_of_error_on_null_object_ptr),
+            cmocka_unit_test(check_object_rank_of_error_on_null_argument_ptr),
+            cmocka_unit_test(check_object_rank_of_error_on_invalid_value),
+            cmocka_unit_test(check_object_rank_of),
             cmocka_unit_test(check_object_get_next_error_on_null_object_ptr),
             cmocka_unit_test(check_object_get_next_error_on_null_argument_ptr),
             cmocka_unit_test(check_object_get_next_error_on_object_not_found),
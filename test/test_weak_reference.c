@@ -86,9 +86,9 @@ static void check_get(void **state) {
     struct coral$weak_reference o = {};
     assert_true(coral$weak_reference$init(&o, i));
     struct coral_object *u = NULL;
-    coral$autorelease_pool$start();
+    const size_t watermark = coral$autorelease_pool$start();
     assert_true(coral$weak_reference$get(&o, (void **)&u));
-    coral$autorelease_pool$end();
+    coral$autorelease_pool$end(watermark);
     assert_non_null(u);
     assert_ptr_equal(i, u);
     assert_true(coral$weak_reference$invalidate(&o));